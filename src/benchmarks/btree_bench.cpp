@@ -0,0 +1,21 @@
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "lookup_bench.h"
+
+// The default sizes fit a small machine; pass the largest size as the
+// first argument (e.g. 100000000) to continue the x10 ladder up to it.
+int main(int argc, char **argv) {
+  size_t max_keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  for (size_t n = 1000000; n <= max_keys; n *= 10) {
+    std::vector<uint64_t> inserts = shuffled(n, 1);
+    std::vector<uint64_t> lookups = shuffled(n, 2);
+    run_lookup<s21::map<uint64_t, uint64_t>>("s21::map (RBTree)", inserts,
+                                             lookups);
+    run_lookup<s21::btree_map<uint64_t, uint64_t>>("s21::btree_map", inserts,
+                                                   lookups);
+  }
+  return 0;
+}
@@ -0,0 +1,77 @@
+#ifndef S21_BENCHMARKS_LOOKUP_BENCH_H
+#define S21_BENCHMARKS_LOOKUP_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Shared harness for the lookup benchmarks: every map type runs the same
+// insert, hit, miss and scan passes over the same key orders.
+
+using clock_type = std::chrono::steady_clock;
+
+inline double elapsed_ms(clock_type::time_point start) {
+  return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+      .count();
+}
+
+// Keys 0..n-1 in a fixed pseudo-random order, so consecutive operations
+// land in unrelated parts of the container as in a real lookup service.
+inline std::vector<uint64_t> shuffled(size_t n, uint64_t seed) {
+  std::vector<uint64_t> keys(n);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(seed));
+  return keys;
+}
+
+template <typename Map>
+void insert_one(Map &map, uint64_t key) {
+  if constexpr (std::is_same_v<Map, std::unordered_map<uint64_t, uint64_t>>) {
+    map.emplace(key, key);
+  } else {
+    map.insert(key, key);
+  }
+}
+
+// Random-order inserts, a lookup of every key in another random order,
+// the same number of lookups of absent keys, then one full scan.
+template <typename Map>
+void run_lookup(const char *name, const std::vector<uint64_t> &inserts,
+                const std::vector<uint64_t> &lookups) {
+  auto start = clock_type::now();
+  auto *map = new Map;
+  for (uint64_t key : inserts) insert_one(*map, key);
+  double insert = elapsed_ms(start);
+
+  uint64_t checksum = 0;
+  start = clock_type::now();
+  for (uint64_t key : lookups) checksum += map->find(key)->second;
+  double hit = elapsed_ms(start);
+
+  uint64_t absent = inserts.size();
+  start = clock_type::now();
+  for (uint64_t key : lookups) checksum += map->count(key + absent);
+  double miss = elapsed_ms(start);
+
+  start = clock_type::now();
+  for (auto it = map->begin(); it != map->end(); ++it) {
+    checksum += it->first;
+  }
+  double scan = elapsed_ms(start);
+
+  delete map;
+  double mops = static_cast<double>(inserts.size()) / 1000.0;
+  std::printf(
+      "%-20s %11zu  insert %6.2f  hit %6.2f  miss %6.2f  scan %7.2f "
+      "Mops/s  (checksum %llu)\n",
+      name, inserts.size(), mops / insert, mops / hit, mops / miss,
+      mops / scan, static_cast<unsigned long long>(checksum));
+}
+
+#endif
@@ -0,0 +1,224 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+
+constexpr int kNodes = 1000000;
+constexpr int kRounds = 3;
+
+using clock_type = std::chrono::steady_clock;
+
+static double elapsed_ms(clock_type::time_point start) {
+  return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+      .count();
+}
+
+// Keys are a fixed permutation of [0, kNodes) so the tree does real work.
+template <typename Map>
+static void fill(Map &map) {
+  for (int i = 0; i < kNodes; ++i) {
+    int key = static_cast<int>((static_cast<long long>(i) * 7919) % kNodes);
+    map.insert(key, i);
+  }
+}
+
+static void report(const char *name, double build, double release,
+                   size_t checksum) {
+  std::printf("%-32s build %9.2f ms  release %9.2f ms  (checksum %zu)\n", name,
+              build, release, checksum);
+}
+
+// Every node goes back to the global heap with its own delete.
+static void run_default() {
+  for (int round = 0; round < kRounds; ++round) {
+    auto start = clock_type::now();
+    auto *map = new s21::map<int, int>;
+    fill(*map);
+    double build = elapsed_ms(start);
+    size_t checksum = map->size();
+
+    start = clock_type::now();
+    delete map;
+    report("s21::map (per-node delete)", build, elapsed_ms(start), checksum);
+  }
+}
+
+// The map's deallocations are no-ops; one reset hands the memory back. The
+// arena is reused across rounds, as a request handler would.
+static void run_arena() {
+  s21::pmr::arena_resource arena;
+  for (int round = 0; round < kRounds; ++round) {
+    auto start = clock_type::now();
+    auto *map = new s21::pmr::map<int, int>(&arena);
+    fill(*map);
+    double build = elapsed_ms(start);
+    size_t checksum = map->size();
+
+    start = clock_type::now();
+    delete map;
+    arena.reset();
+    report("s21::pmr::map (arena reset)", build, elapsed_ms(start), checksum);
+  }
+}
+
+// Order-book style churn: a steady 10k live keys, each erase followed by an
+// insert, so after warm-up every node comes off the pool's free list.
+static void run_churn() {
+  constexpr int kLive = 10000;
+  s21::map<int, int> map;
+  for (int i = 0; i < kLive; ++i) map.insert(i, i);
+  auto start = clock_type::now();
+  for (int i = kLive; i < kNodes; ++i) {
+    map.erase(map.find(i - kLive));
+    map.insert(i, i);
+  }
+  std::printf("%-32s churn %9.2f ms  pool hits %zu  misses %zu\n",
+              "s21::map (erase + insert)", elapsed_ms(start), map.poolHits(),
+              map.poolMisses());
+}
+
+// Dedup stage: 90% of the keys are already present. insert() needs a
+// ready-made value; try_emplace() builds it only for the 10% that land.
+static void run_dedup() {
+  constexpr int kDistinct = kNodes / 10;
+  s21::map<int, std::string> by_insert;
+  auto start = clock_type::now();
+  for (int i = 0; i < kNodes; ++i) {
+    by_insert.insert(i % kDistinct, std::string(64, 'x'));
+  }
+  double insert_ms = elapsed_ms(start);
+
+  s21::map<int, std::string> by_emplace;
+  start = clock_type::now();
+  for (int i = 0; i < kNodes; ++i) {
+    by_emplace.try_emplace(i % kDistinct, 64, 'x');
+  }
+  std::printf("%-32s insert %8.2f ms  try_emplace %8.2f ms  (size %zu)\n",
+              "s21::map (90% duplicates)", insert_ms, elapsed_ms(start),
+              by_emplace.size());
+}
+
+// Nightly index rebuild from a sorted file: one insert per entry with a
+// rebalance each time, against a single O(n) bulk build.
+static void run_bulk() {
+  std::vector<std::pair<int, int>> sorted;
+  sorted.reserve(kNodes);
+  for (int i = 0; i < kNodes; ++i) sorted.emplace_back(i, i);
+
+  auto start = clock_type::now();
+  s21::map<int, int> by_insert;
+  for (const auto &item : sorted) by_insert.insert(item.first, item.second);
+  double insert_ms = elapsed_ms(start);
+
+  start = clock_type::now();
+  auto by_bulk =
+      s21::map<int, int>::from_sorted(sorted.begin(), sorted.end(), true);
+  std::printf("%-32s insert %8.2f ms  from_sorted %8.2f ms  (size %zu)\n",
+              "s21::map (sorted input)", insert_ms, elapsed_ms(start),
+              by_bulk.size());
+}
+
+// Appending increasing event ids. With end() as the hint the new key is
+// compared only with the current maximum instead of on every level.
+static void run_append() {
+  std::vector<std::pair<std::string, int>> events;
+  events.reserve(kNodes);
+  for (int i = 0; i < kNodes; ++i) {
+    char id[32];
+    std::snprintf(id, sizeof(id), "evt-%012d", i);
+    events.emplace_back(id, i);
+  }
+
+  auto start = clock_type::now();
+  s21::map<std::string, int> by_insert;
+  for (const auto &event : events) by_insert.insert(event.first, event.second);
+  double insert_ms = elapsed_ms(start);
+
+  start = clock_type::now();
+  s21::map<std::string, int> by_hint;
+  for (const auto &event : events) by_hint.insert(by_hint.end(), event);
+  std::printf("%-32s insert %8.2f ms  hinted %8.2f ms  (size %zu)\n",
+              "s21::map (increasing ids)", insert_ms, elapsed_ms(start),
+              by_hint.size());
+}
+
+// Full scan: every dereference reads the pair stored in the node, so the
+// walk is linear in the size of the map.
+static void run_scan() {
+  s21::map<int, int> map;
+  fill(map);
+  auto start = clock_type::now();
+  long long sum = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    for (const auto &[key, value] : map) sum += key + value;
+  }
+  std::printf("%-32s scan %10.2f ms  (checksum %lld)\n", "s21::map (range-for)",
+              elapsed_ms(start) / kRounds, sum);
+}
+
+// Expiring the oldest tenth of the keys: one erase per element against a
+// single extract_range that cuts the tree in O(log n).
+static void run_expire() {
+  constexpr int kCutoff = kNodes / 10;
+  s21::map<int, int> by_erase;
+  fill(by_erase);
+  auto start = clock_type::now();
+  while (!by_erase.empty() && by_erase.begin()->first < kCutoff) {
+    by_erase.erase(by_erase.begin());
+  }
+  double erase_ms = elapsed_ms(start);
+
+  s21::map<int, int> by_extract;
+  fill(by_extract);
+  start = clock_type::now();
+  s21::map<int, int> expired = by_extract.extract_range(0, kCutoff);
+  std::printf("%-32s erase %9.2f ms  extract %7.2f ms  (size %zu/%zu)\n",
+              "s21::map (expire oldest 10%)", erase_ms, elapsed_ms(start),
+              by_extract.size(), expired.size());
+}
+
+// Sessions bouncing between an active and an idle map. Copy, insert and
+// erase pay a node allocation and a free per move; a node handle relinks
+// the same node, which left the pool once on its first extract.
+static void run_sessions() {
+  constexpr int kSessions = 10000;
+  s21::map<int, std::string> active;
+  s21::map<int, std::string> idle;
+  for (int id = 0; id < kSessions; ++id) {
+    active.insert(id, "session payload " + std::to_string(id));
+  }
+  auto start = clock_type::now();
+  for (int i = 0; i < kNodes; ++i) {
+    auto &from = (i / kSessions) % 2 ? idle : active;
+    auto &to = (i / kSessions) % 2 ? active : idle;
+    auto it = from.find(i % kSessions);
+    to.insert(*it);
+    from.erase(it);
+  }
+  double copy_ms = elapsed_ms(start);
+
+  start = clock_type::now();
+  for (int i = 0; i < kNodes; ++i) {
+    auto &from = (i / kSessions) % 2 ? idle : active;
+    auto &to = (i / kSessions) % 2 ? active : idle;
+    to.insert(from.extract(i % kSessions));
+  }
+  std::printf("%-32s copy %10.2f ms  extract %7.2f ms  (size %zu/%zu)\n",
+              "s21::map (move between maps)", copy_ms, elapsed_ms(start),
+              active.size(), idle.size());
+}
+
+int main() {
+  run_default();
+  run_arena();
+  run_churn();
+  run_dedup();
+  run_bulk();
+  run_append();
+  run_scan();
+  run_expire();
+  run_sessions();
+  return 0;
+}
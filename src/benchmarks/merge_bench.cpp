@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../s21_containers.h"
+
+using clock_type = std::chrono::steady_clock;
+using key_set = s21::set<uint64_t>;
+
+static double elapsed_ms(clock_type::time_point start) {
+  return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+      .count();
+}
+
+// Random keys spread over the whole 64-bit range, so that a per-key
+// descent touches a different path every time.
+static std::vector<uint64_t> random_keys(size_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<uint64_t> keys(n);
+  for (uint64_t &key : keys) key = rng();
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  return keys;
+}
+
+// a holds n random keys; b holds every other key of a plus n / 2 new ones.
+static void make_sets(size_t n, key_set &a, key_set &b) {
+  std::vector<uint64_t> keys = random_keys(n, 1);
+  std::vector<uint64_t> fresh = random_keys(n / 2, 2);
+  std::vector<uint64_t> other;
+  for (size_t i = 0; i < keys.size(); i += 2) other.push_back(keys[i]);
+  other.insert(other.end(), fresh.begin(), fresh.end());
+  std::sort(other.begin(), other.end());
+  other.erase(std::unique(other.begin(), other.end()), other.end());
+  a = key_set::from_sorted(keys.begin(), keys.end());
+  b = key_set::from_sorted(other.begin(), other.end());
+}
+
+static void report(const char *name, size_t n, double ms, size_t size) {
+  std::printf("%-28s %11zu  %9.1f ms  (result %zu)\n", name, n, ms, size);
+}
+
+static void run(size_t n) {
+  {
+    key_set a, b;
+    make_sets(n, a, b);
+    auto start = clock_type::now();
+    for (uint64_t key : b) a.insert(key);
+    b.clear();
+    report("insert loop", n, elapsed_ms(start), a.size());
+  }
+  {
+    key_set a, b;
+    make_sets(n, a, b);
+    auto start = clock_type::now();
+    a.merge(b);
+    report("merge", n, elapsed_ms(start), a.size());
+  }
+  key_set a, b;
+  make_sets(n, a, b);
+  auto start = clock_type::now();
+  size_t size = s21::set_union(a, b).size();
+  report("set_union", n, elapsed_ms(start), size);
+  start = clock_type::now();
+  size = s21::set_intersection(a, b).size();
+  report("set_intersection", n, elapsed_ms(start), size);
+  start = clock_type::now();
+  size = s21::set_difference(a, b).size();
+  report("set_difference", n, elapsed_ms(start), size);
+}
+
+// Pass the largest size as the first argument (e.g. 20000000) to continue
+// the x10 ladder past the default.
+int main(int argc, char **argv) {
+  size_t max_keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  for (size_t n = 100000; n <= max_keys; n *= 10) run(n);
+  return 0;
+}
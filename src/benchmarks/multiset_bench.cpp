@@ -0,0 +1,39 @@
+#include <chrono>
+#include <cstdio>
+
+#include "../s21_containers.h"
+
+// Histogram-style workload: every bucket holds kMultiplicity events, and
+// count() is queried for random buckets as the multiset grows. count() is
+// two O(log n) rank descents over subtree sizes, so latency should stay
+// roughly flat.
+constexpr size_t kMultiplicity = 8;
+constexpr size_t kQueries = 1000000;
+constexpr size_t kSizes[] = {10000, 100000, 1000000, 10000000};
+
+using clock_type = std::chrono::steady_clock;
+
+int main() {
+  s21::multiset<long long> events;
+  size_t filled = 0;
+  for (size_t size : kSizes) {
+    for (; filled < size; ++filled) {
+      events.insert(static_cast<long long>(filled / kMultiplicity));
+    }
+    long long buckets = static_cast<long long>(size / kMultiplicity);
+    size_t checksum = 0;
+    auto start = clock_type::now();
+    for (size_t i = 0; i < kQueries; ++i) {
+      long long bucket =
+          static_cast<long long>((i * 2654435761ULL) % buckets);
+      checksum += events.count(bucket);
+    }
+    double ns = std::chrono::duration<double, std::nano>(clock_type::now() -
+                                                         start)
+                    .count() /
+                kQueries;
+    std::printf("multiset size %9zu: count %8.1f ns/query (checksum %zu)\n",
+                size, ns, checksum);
+  }
+  return 0;
+}
@@ -0,0 +1,48 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "../s21_containers.h"
+
+// Every heap allocation made by the process goes through these, so the
+// benchmark can report how many allocations each container performed.
+static size_t allocation_count = 0;
+
+void *operator new(size_t size) {
+  ++allocation_count;
+  if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+constexpr size_t kIterations = 1000000;
+
+// A short-lived vector of up to 6 elements per request.
+template <typename Vector>
+void run(const char *name) {
+  allocation_count = 0;
+  size_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kIterations; ++i) {
+    Vector vec;
+    for (size_t j = 0; j < i % 7; ++j) {
+      vec.push_back(static_cast<int>(i + j));
+    }
+    checksum += vec.size();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  std::printf("%-28s %10.2f ms %12zu allocations (checksum %zu)\n", name,
+              std::chrono::duration<double, std::milli>(stop - start).count(),
+              allocation_count, checksum);
+}
+
+int main() {
+  run<s21::vector<int>>("s21::vector<int>");
+  run<std::vector<int>>("std::vector<int>");
+  run<s21::small_vector<int, 8>>("s21::small_vector<int, 8>");
+  return 0;
+}
@@ -0,0 +1,60 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+
+using vector_x1_5 = s21::vector<int, std::allocator<int>, s21::growth_x1_5>;
+
+// Fill time per element must stay flat while the element count grows by
+// orders of magnitude: that is what amortized O(1) push_back looks like.
+
+template <typename Vector>
+double fill_ns_per_element(size_t count) {
+  auto start = std::chrono::steady_clock::now();
+  Vector vec;
+  for (size_t i = 0; i < count; ++i) {
+    vec.push_back(static_cast<int>(i));
+  }
+  auto stop = std::chrono::steady_clock::now();
+  volatile int sink = vec.back();
+  (void)sink;
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         static_cast<double>(count);
+}
+
+// Growth of a vector of heap-owning strings: the reallocation path must
+// move the strings instead of deep-copying them.
+template <typename Vector>
+double string_growth_ms(size_t count) {
+  const std::string payload(64, 'x');
+  auto start = std::chrono::steady_clock::now();
+  Vector vec;
+  for (size_t i = 0; i < count; ++i) {
+    vec.push_back(payload);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  volatile size_t sink = vec.back().size();
+  (void)sink;
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main() {
+  std::printf("%12s %16s %16s %16s\n", "elements", "s21 x2 ns/op",
+              "s21 x1.5 ns/op", "std ns/op");
+  for (size_t count = 1000; count <= 10000000; count *= 10) {
+    std::printf("%12zu %16.2f %16.2f %16.2f\n", count,
+                fill_ns_per_element<s21::vector<int>>(count),
+                fill_ns_per_element<vector_x1_5>(count),
+                fill_ns_per_element<std::vector<int>>(count));
+  }
+
+  std::printf("\n%12s %16s %16s\n", "strings", "s21 ms", "std ms");
+  for (size_t count = 1000; count <= 1000000; count *= 10) {
+    std::printf("%12zu %16.3f %16.3f\n", count,
+                string_growth_ms<s21::vector<std::string>>(count),
+                string_growth_ms<std::vector<std::string>>(count));
+  }
+  return 0;
+}
@@ -0,0 +1,305 @@
+#ifndef S21_BTREE_H
+#define S21_BTREE_H
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../Tree/s21_tree.h"
+
+namespace s21 {
+
+// B+-дерево с широкими узлами: ключи узла лежат подряд в одном массиве,
+// так что поиск внутри узла идет по нескольким соседним кеш-линиям, а
+// высота дерева в несколько раз меньше, чем у красно-черного. Все элементы
+// хранятся в листьях, листья связаны в список, и обход не поднимается к
+// корню. Внутренние узлы хранят копии ключей-разделителей, поэтому Key
+// должен копироваться
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class BTree {
+ protected:
+  static constexpr bool key_only = std::is_same_v<Value, tree_key_only>;
+  // Массив ключей узла занимает четыре кеш-линии
+  static constexpr size_t node_bytes = 4 * cache_line_size;
+  static constexpr size_t slotsFor(size_t bytes) {
+    size_t slots = bytes / sizeof(Key);
+    return slots < 4 ? 4 : (slots > 128 ? 128 : slots);
+  }
+  static constexpr size_t leaf_slots = slotsFor(node_bytes);
+  static constexpr size_t inner_slots = slotsFor(node_bytes);
+  // Узел, в котором осталось меньше половины элементов, занимает элемент у
+  // соседа или сливается с ним
+  static constexpr size_t leaf_min = leaf_slots / 2;
+  static constexpr size_t inner_min = inner_slots / 2;
+  // У внутреннего узла не меньше трех потомков, так что 48 уровней хватает
+  // для любого числа элементов, адресуемого size_t
+  static constexpr size_t max_height = 48;
+
+  // Неинициализированный массив: элементы строятся и разрушаются вручную
+  template <typename T, size_t N>
+  struct Slots {
+    alignas(T) unsigned char bytes[sizeof(T) * N];
+    T* data() { return reinterpret_cast<T*>(bytes); }
+    const T* data() const { return reinterpret_cast<const T*>(bytes); }
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator[](size_t i) const { return data()[i]; }
+  };
+
+  struct Node {
+    unsigned short count;
+    bool leaf;
+  };
+  // Для set значения не хранятся: массив значений вырождается в один байт
+  struct alignas(cache_line_size) Leaf : Node {
+    Leaf* prev;
+    Leaf* next;
+    Slots<Key, leaf_slots> keys;
+    Slots<Value, key_only ? 1 : leaf_slots> values;
+  };
+  // count разделителей и count + 1 потомков; keys[i] не больше любого
+  // ключа в children[i + 1] и больше всех ключей в children[i]
+  struct alignas(cache_line_size) Inner : Node {
+    Slots<Key, inner_slots> keys;
+    Node* children[inner_slots + 1];
+  };
+
+  using leaf_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Leaf>;
+  using inner_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Inner>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+  using inner_traits = std::allocator_traits<inner_allocator>;
+
+  leaf_allocator alloc_;
+  Compare comp_;
+  Node* root_;
+  // Крайние листья: begin() и --end() не спускаются от корня
+  Leaf* first_;
+  Leaf* last_;
+  size_t size_;
+
+ private:
+  Leaf* createLeaf();
+  Inner* createInner();
+  void freeLeaf(Leaf* leaf) noexcept;
+  void freeInner(Inner* inner) noexcept;
+  void destroyNode(Node* node) noexcept;
+  void copyFrom(const BTree& other);
+  Node* copyNode(const Node* node, Leaf*& prev);
+  // a < b через компаратор
+  template <typename A, typename B>
+  bool keyLess(const A& a, const B& b) const {
+    if constexpr (is_three_way_compare<Compare>::value) {
+      return comp_(a, b) < 0;
+    } else {
+      return comp_(a, b);
+    }
+  }
+  // Позиции в отсортированном массиве ключей узла: первый ключ не меньше
+  // key и первый ключ больше key
+  template <typename K>
+  size_t lowerIndex(const Key* keys, size_t count, const K& key) const;
+  template <typename K>
+  size_t upperIndex(const Key* keys, size_t count, const K& key) const;
+  template <typename K>
+  Leaf* leafFor(const K& key) const;
+  void splitLeaf(Leaf*& leaf, size_t& pos, Inner* const* path,
+                 const size_t* slots, size_t depth);
+  void insertChild(Inner* parent, size_t index, Key&& separator, Node* child);
+  template <typename K, typename... Args>
+  void emplaceAt(Leaf* leaf, size_t pos, K&& key, Args&&... args);
+  template <typename K>
+  bool eraseFrom(Node* node, const K& key);
+  void rebalance(Inner* parent, size_t index);
+  void mergeChildren(Inner* parent, size_t index);
+  void releaseRoot() noexcept;
+
+  // Сдвиги в неинициализированных массивах. shiftRight освобождает
+  // позицию pos в [0, count), shiftLeft закрывает уже пустую позицию pos
+  // в [0, count); тривиально копируемые типы сдвигаются одним memmove
+  template <typename T>
+  static void shiftRight(T* data, size_t pos, size_t count);
+  template <typename T>
+  static void shiftLeft(T* data, size_t pos, size_t count);
+  template <typename T>
+  static void relocate(T* from, size_t count, T* to);
+
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  BTree();
+  explicit BTree(const Allocator& alloc);
+  explicit BTree(const Compare& comp, const Allocator& alloc = Allocator());
+  BTree(const BTree& other);
+  BTree(BTree&& other) noexcept;
+  BTree& operator=(const BTree& other);
+  BTree& operator=(BTree&& other) noexcept(
+      leaf_traits::propagate_on_container_move_assignment::value ||
+      leaf_traits::is_always_equal::value);
+  ~BTree();
+
+  void clear() noexcept;
+  void swap(BTree& other) noexcept;
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+  key_compare key_comp() const { return comp_; }
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  // Число уровней: 0 для пустого дерева, 1 для одного листа
+  size_type height() const;
+
+  class const_iterator;
+  // Итератор - лист и позиция в нем; end() - пустой лист
+  class iterator {
+    friend class BTree;
+    friend class const_iterator;
+
+   private:
+    const BTree* tree;
+    Leaf* leaf;
+    size_t pos;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    iterator(const BTree* tree = nullptr, Leaf* leaf = nullptr,
+             size_t pos = 0)
+        : tree(tree), leaf(leaf), pos(pos) {}
+    iterator& operator++() {
+      if (++pos == leaf->count) {
+        leaf = leaf->next;
+        pos = 0;
+      }
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator temp = *this;
+      ++*this;
+      return temp;
+    }
+    iterator& operator--() {
+      if (leaf == nullptr) {
+        leaf = tree->last_;
+        pos = leaf->count;
+      } else if (pos == 0) {
+        leaf = leaf->prev;
+        pos = leaf->count;
+      }
+      --pos;
+      return *this;
+    }
+    iterator operator--(int) {
+      iterator temp = *this;
+      --*this;
+      return temp;
+    }
+    const Key& operator*() const { return leaf->keys[pos]; }
+    const Key& key() const { return leaf->keys[pos]; }
+    // Значение элемента (только для map)
+    Value& value() const { return leaf->values[pos]; }
+    bool operator==(const iterator& other) const {
+      return leaf == other.leaf && pos == other.pos;
+    }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+  };
+  // Итератор для константных объектов
+  class const_iterator {
+   private:
+    const BTree* tree;
+    const Leaf* leaf;
+    size_t pos;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    const_iterator(const BTree* tree = nullptr, const Leaf* leaf = nullptr,
+                   size_t pos = 0)
+        : tree(tree), leaf(leaf), pos(pos) {}
+    const_iterator(const iterator& other)
+        : tree(other.tree), leaf(other.leaf), pos(other.pos) {}
+    const_iterator& operator++() {
+      if (++pos == leaf->count) {
+        leaf = leaf->next;
+        pos = 0;
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator temp = *this;
+      ++*this;
+      return temp;
+    }
+    const_iterator& operator--() {
+      if (leaf == nullptr) {
+        leaf = tree->last_;
+        pos = leaf->count;
+      } else if (pos == 0) {
+        leaf = leaf->prev;
+        pos = leaf->count;
+      }
+      --pos;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator temp = *this;
+      --*this;
+      return temp;
+    }
+    const Key& operator*() const { return leaf->keys[pos]; }
+    const Key& key() const { return leaf->keys[pos]; }
+    const Value& value() const { return leaf->values[pos]; }
+    bool operator==(const const_iterator& other) const {
+      return leaf == other.leaf && pos == other.pos;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+  };
+
+  iterator begin() { return iterator(this, first_); }
+  iterator end() { return iterator(this); }
+  const_iterator begin() const { return const_iterator(this, first_); }
+  const_iterator end() const { return const_iterator(this); }
+
+ protected:
+  // Первый элемент, не меньший key, и первый элемент, больший key
+  template <typename K>
+  iterator lowerBound(const K& key) const;
+  template <typename K>
+  iterator upperBound(const K& key) const;
+  template <typename K>
+  iterator findKey(const K& key) const;
+  // Элемент создается, только если ключа еще нет. Путь от корня
+  // запоминается при спуске, и полные узлы делятся снизу вверх только
+  // при настоящей вставке
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> tryEmplace(K&& key, Args&&... args);
+  // Удаление по ключу; возвращает число удаленных элементов (0 или 1)
+  template <typename K>
+  size_type eraseKey(const K& key);
+};
+
+}  // namespace s21
+
+#include "s21_btree.tpp"
+
+#endif
@@ -0,0 +1,773 @@
+#ifndef S21_BTREE_TPP
+#define S21_BTREE_TPP
+
+#include "s21_btree.h"
+
+namespace s21 {
+// Конструкторы
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTree<Key, Value, Compare, Allocator>::BTree()
+    : alloc_(),
+      comp_(),
+      root_(nullptr),
+      first_(nullptr),
+      last_(nullptr),
+      size_(0) {}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTree<Key, Value, Compare, Allocator>::BTree(const Allocator& alloc)
+    : alloc_(alloc),
+      comp_(),
+      root_(nullptr),
+      first_(nullptr),
+      last_(nullptr),
+      size_(0) {}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTree<Key, Value, Compare, Allocator>::BTree(const Compare& comp,
+                                             const Allocator& alloc)
+    : alloc_(alloc),
+      comp_(comp),
+      root_(nullptr),
+      first_(nullptr),
+      last_(nullptr),
+      size_(0) {}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTree<Key, Value, Compare, Allocator>::BTree(const BTree& other)
+    : alloc_(leaf_traits::select_on_container_copy_construction(other.alloc_)),
+      comp_(other.comp_),
+      root_(nullptr),
+      first_(nullptr),
+      last_(nullptr),
+      size_(0) {
+  if (other.root_) {
+    copyFrom(other);
+  }
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTree<Key, Value, Compare, Allocator>::BTree(BTree&& other) noexcept
+    : alloc_(std::move(other.alloc_)),
+      comp_(other.comp_),
+      root_(other.root_),
+      first_(other.first_),
+      last_(other.last_),
+      size_(other.size_) {
+  other.root_ = nullptr;
+  other.first_ = other.last_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTree<Key, Value, Compare, Allocator>&
+BTree<Key, Value, Compare, Allocator>::operator=(const BTree& other) {
+  if (this != &other) {
+    clear();
+    if constexpr (leaf_traits::propagate_on_container_copy_assignment::value) {
+      alloc_ = other.alloc_;
+    }
+    comp_ = other.comp_;
+    if (other.root_) {
+      copyFrom(other);
+    }
+  }
+  return *this;
+}
+
+// Узлы забираются целиком, только если наш аллокатор сможет их
+// освободить; иначе дерево копируется в собственные узлы
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTree<Key, Value, Compare, Allocator>&
+BTree<Key, Value, Compare, Allocator>::operator=(BTree&& other) noexcept(
+    leaf_traits::propagate_on_container_move_assignment::value ||
+    leaf_traits::is_always_equal::value) {
+  if (this != &other) {
+    clear();
+    comp_ = other.comp_;
+    if (leaf_traits::propagate_on_container_move_assignment::value ||
+        alloc_ == other.alloc_) {
+      if constexpr (leaf_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = std::move(other.alloc_);
+      }
+      root_ = other.root_;
+      first_ = other.first_;
+      last_ = other.last_;
+      size_ = other.size_;
+      other.root_ = nullptr;
+      other.first_ = other.last_ = nullptr;
+      other.size_ = 0;
+    } else if (other.root_) {
+      copyFrom(other);
+      other.clear();
+    }
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTree<Key, Value, Compare, Allocator>::~BTree() {
+  clear();
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTree<Key, Value, Compare, Allocator>::clear() noexcept {
+  if (root_) {
+    destroyNode(root_);
+  }
+  root_ = nullptr;
+  first_ = last_ = nullptr;
+  size_ = 0;
+}
+
+// Обмен содержимым; аллокаторы меняются местами, только если это
+// разрешает propagate_on_container_swap
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTree<Key, Value, Compare, Allocator>::swap(BTree& other) noexcept {
+  if constexpr (leaf_traits::propagate_on_container_swap::value) {
+    std::swap(alloc_, other.alloc_);
+  }
+  std::swap(comp_, other.comp_);
+  std::swap(root_, other.root_);
+  std::swap(first_, other.first_);
+  std::swap(last_, other.last_);
+  std::swap(size_, other.size_);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTree<Key, Value, Compare, Allocator>::size_type
+BTree<Key, Value, Compare, Allocator>::height() const {
+  size_type levels = 0;
+  for (const Node* node = root_; node;) {
+    ++levels;
+    node = node->leaf ? nullptr : static_cast<const Inner*>(node)->children[0];
+  }
+  return levels;
+}
+
+
+// Выделение и освобождение узлов. Массивы ключей и значений не
+// инициализируются: элементы строятся по одному при вставке
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTree<Key, Value, Compare, Allocator>::Leaf*
+BTree<Key, Value, Compare, Allocator>::createLeaf() {
+  Leaf* leaf = leaf_traits::allocate(alloc_, 1);
+  ::new (static_cast<void*>(leaf)) Leaf;
+  leaf->count = 0;
+  leaf->leaf = true;
+  leaf->prev = leaf->next = nullptr;
+  return leaf;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTree<Key, Value, Compare, Allocator>::Inner*
+BTree<Key, Value, Compare, Allocator>::createInner() {
+  inner_allocator alloc(alloc_);
+  Inner* inner = inner_traits::allocate(alloc, 1);
+  ::new (static_cast<void*>(inner)) Inner;
+  inner->count = 0;
+  inner->leaf = false;
+  return inner;
+}
+
+// Освобождение памяти узла без разрушения элементов
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTree<Key, Value, Compare, Allocator>::freeLeaf(Leaf* leaf) noexcept {
+  leaf->~Leaf();
+  leaf_traits::deallocate(alloc_, leaf, 1);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTree<Key, Value, Compare, Allocator>::freeInner(Inner* inner) noexcept {
+  inner->~Inner();
+  inner_allocator alloc(alloc_);
+  inner_traits::deallocate(alloc, inner, 1);
+}
+
+// Рекурсивное удаление поддерева вместе с элементами
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTree<Key, Value, Compare, Allocator>::destroyNode(Node* node) noexcept {
+  if (node->leaf) {
+    Leaf* leaf = static_cast<Leaf*>(node);
+    for (size_t i = 0; i < leaf->count; ++i) {
+      leaf->keys[i].~Key();
+      if constexpr (!key_only) {
+        leaf->values[i].~Value();
+      }
+    }
+    freeLeaf(leaf);
+  } else {
+    Inner* inner = static_cast<Inner*>(node);
+    for (size_t i = 0; i <= inner->count; ++i) {
+      destroyNode(inner->children[i]);
+    }
+    for (size_t i = 0; i < inner->count; ++i) {
+      inner->keys[i].~Key();
+    }
+    freeInner(inner);
+  }
+}
+
+// Копирование дерева той же формы в пустое дерево. При исключении
+// построенная часть уже освобождена, и дерево остается пустым
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTree<Key, Value, Compare, Allocator>::copyFrom(const BTree& other) {
+  if (other.root_ == nullptr) return;
+  Leaf* prev = nullptr;
+  try {
+    root_ = copyNode(other.root_, prev);
+  } catch (...) {
+    first_ = last_ = nullptr;
+    throw;
+  }
+  last_ = prev;
+  size_ = other.size_;
+}
+
+// Листья копируются слева направо и сразу связываются в список; prev -
+// последний готовый лист
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTree<Key, Value, Compare, Allocator>::Node*
+BTree<Key, Value, Compare, Allocator>::copyNode(const Node* node,
+                                                Leaf*& prev) {
+  if (node->leaf) {
+    const Leaf* source = static_cast<const Leaf*>(node);
+    Leaf* leaf = createLeaf();
+    try {
+      for (size_t i = 0; i < source->count; ++i) {
+        ::new (static_cast<void*>(&leaf->keys[i])) Key(source->keys[i]);
+        if constexpr (!key_only) {
+          try {
+            ::new (static_cast<void*>(&leaf->values[i]))
+                Value(source->values[i]);
+          } catch (...) {
+            leaf->keys[i].~Key();
+            throw;
+          }
+        }
+        ++leaf->count;
+      }
+    } catch (...) {
+      destroyNode(leaf);
+      throw;
+    }
+    leaf->prev = prev;
+    if (prev) {
+      prev->next = leaf;
+    } else {
+      first_ = leaf;
+    }
+    prev = leaf;
+    return leaf;
+  }
+  const Inner* source = static_cast<const Inner*>(node);
+  Inner* inner = createInner();
+  size_t keys_built = 0;
+  size_t children_built = 0;
+  try {
+    for (; keys_built < source->count; ++keys_built) {
+      ::new (static_cast<void*>(&inner->keys[keys_built]))
+          Key(source->keys[keys_built]);
+    }
+    for (; children_built <= source->count; ++children_built) {
+      inner->children[children_built] =
+          copyNode(source->children[children_built], prev);
+    }
+  } catch (...) {
+    for (size_t i = 0; i < children_built; ++i) {
+      destroyNode(inner->children[i]);
+    }
+    for (size_t i = 0; i < keys_built; ++i) {
+      inner->keys[i].~Key();
+    }
+    freeInner(inner);
+    throw;
+  }
+  inner->count = source->count;
+  return inner;
+}
+
+// Сдвиги элементов внутри узла и перенос между узлами
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename T>
+void BTree<Key, Value, Compare, Allocator>::shiftRight(T* data, size_t pos,
+                                                       size_t count) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    std::memmove(static_cast<void*>(data + pos + 1),
+                 static_cast<const void*>(data + pos),
+                 (count - pos) * sizeof(T));
+  } else {
+    for (size_t i = count; i > pos; --i) {
+      ::new (static_cast<void*>(data + i)) T(std::move(data[i - 1]));
+      data[i - 1].~T();
+    }
+  }
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename T>
+void BTree<Key, Value, Compare, Allocator>::shiftLeft(T* data, size_t pos,
+                                                      size_t count) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    std::memmove(static_cast<void*>(data + pos),
+                 static_cast<const void*>(data + pos + 1),
+                 (count - pos - 1) * sizeof(T));
+  } else {
+    for (size_t i = pos; i + 1 < count; ++i) {
+      ::new (static_cast<void*>(data + i)) T(std::move(data[i + 1]));
+      data[i + 1].~T();
+    }
+  }
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename T>
+void BTree<Key, Value, Compare, Allocator>::relocate(T* from, size_t count,
+                                                     T* to) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    std::memcpy(static_cast<void*>(to), static_cast<const void*>(from),
+                count * sizeof(T));
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      ::new (static_cast<void*>(to + i)) T(std::move(from[i]));
+      from[i].~T();
+    }
+  }
+}
+
+// Бинарный поиск по непрерывному массиву ключей узла без ветвлений:
+// интервал всегда делится пополам, а сдвиг выбирается условной
+// пересылкой, так что предсказатель переходов не ошибается на каждом шаге
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+size_t BTree<Key, Value, Compare, Allocator>::lowerIndex(const Key* keys,
+                                                         size_t count,
+                                                         const K& key) const {
+  if (count == 0) return 0;
+  const Key* base = keys;
+  while (count > 1) {
+    size_t half = count / 2;
+    base += keyLess(base[half], key) ? half : 0;
+    count -= half;
+  }
+  return static_cast<size_t>(base - keys) + (keyLess(*base, key) ? 1 : 0);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+size_t BTree<Key, Value, Compare, Allocator>::upperIndex(const Key* keys,
+                                                         size_t count,
+                                                         const K& key) const {
+  if (count == 0) return 0;
+  const Key* base = keys;
+  while (count > 1) {
+    size_t half = count / 2;
+    base += keyLess(key, base[half]) ? 0 : half;
+    count -= half;
+  }
+  return static_cast<size_t>(base - keys) + (keyLess(key, *base) ? 0 : 1);
+}
+
+// Лист, в котором лежит key, если он есть в дереве. Ключ, равный
+// разделителю, лежит справа от него
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, Compare, Allocator>::Leaf*
+BTree<Key, Value, Compare, Allocator>::leafFor(const K& key) const {
+  Node* node = root_;
+  if (node == nullptr) return nullptr;
+  while (!node->leaf) {
+    Inner* inner = static_cast<Inner*>(node);
+    node = inner->children[upperIndex(inner->keys.data(), inner->count, key)];
+  }
+  return static_cast<Leaf*>(node);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, Compare, Allocator>::iterator
+BTree<Key, Value, Compare, Allocator>::lowerBound(const K& key) const {
+  Leaf* leaf = leafFor(key);
+  if (leaf == nullptr) return iterator(this);
+  size_t pos = lowerIndex(leaf->keys.data(), leaf->count, key);
+  if (pos == leaf->count) {
+    return iterator(this, leaf->next);
+  }
+  return iterator(this, leaf, pos);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, Compare, Allocator>::iterator
+BTree<Key, Value, Compare, Allocator>::upperBound(const K& key) const {
+  Leaf* leaf = leafFor(key);
+  if (leaf == nullptr) return iterator(this);
+  size_t pos = upperIndex(leaf->keys.data(), leaf->count, key);
+  if (pos == leaf->count) {
+    return iterator(this, leaf->next);
+  }
+  return iterator(this, leaf, pos);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, Compare, Allocator>::iterator
+BTree<Key, Value, Compare, Allocator>::findKey(const K& key) const {
+  Leaf* leaf = leafFor(key);
+  if (leaf == nullptr) return iterator(this);
+  size_t pos = lowerIndex(leaf->keys.data(), leaf->count, key);
+  if (pos < leaf->count && !keyLess(key, leaf->keys[pos])) {
+    return iterator(this, leaf, pos);
+  }
+  return iterator(this);
+}
+
+// Вставка
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename... Args>
+std::pair<typename BTree<Key, Value, Compare, Allocator>::iterator, bool>
+BTree<Key, Value, Compare, Allocator>::tryEmplace(K&& key, Args&&... args) {
+  if (root_ == nullptr) {
+    root_ = first_ = last_ = createLeaf();
+  }
+  Inner* path[max_height];
+  size_t slots[max_height];
+  size_t depth = 0;
+  Node* node = root_;
+  while (!node->leaf) {
+    Inner* inner = static_cast<Inner*>(node);
+    size_t index = upperIndex(inner->keys.data(), inner->count, key);
+    path[depth] = inner;
+    slots[depth++] = index;
+    node = inner->children[index];
+  }
+  Leaf* leaf = static_cast<Leaf*>(node);
+  size_t pos = lowerIndex(leaf->keys.data(), leaf->count, key);
+  if (pos < leaf->count && !keyLess(key, leaf->keys[pos])) {
+    return {iterator(this, leaf, pos), false};
+  }
+  auto place = [&](auto&&... items) -> std::pair<iterator, bool> {
+    if (leaf->count == leaf_slots) {
+      splitLeaf(leaf, pos, path, slots, depth);
+    }
+    emplaceAt(leaf, pos, std::forward<decltype(items)>(items)...);
+    ++size_;
+    return {iterator(this, leaf, pos), true};
+  };
+  // В map key и args могут ссылаться на значения этого дерева (например,
+  // insert(k, at(j))), а сдвиг и деление листа их перемещают. Поэтому
+  // элемент сначала строится на стеке. В set ключа еще нет в дереве, и
+  // ссылаться ему не на что. Если построение бросило исключение в пустом
+  // дереве, только что созданный корень освобождается
+  try {
+    if constexpr (key_only) {
+      return place(std::forward<K>(key));
+    } else {
+      Key new_key(std::forward<K>(key));
+      Value value(std::forward<Args>(args)...);
+      return place(s21::move(new_key), s21::move(value));
+    }
+  } catch (...) {
+    if (size_ == 0) releaseRoot();
+    throw;
+  }
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename... Args>
+void BTree<Key, Value, Compare, Allocator>::emplaceAt(Leaf* leaf, size_t pos,
+                                                      K&& key,
+                                                      Args&&... args) {
+  size_t count = leaf->count;
+  shiftRight(leaf->keys.data(), pos, count);
+  try {
+    ::new (static_cast<void*>(&leaf->keys[pos])) Key(std::forward<K>(key));
+  } catch (...) {
+    shiftLeft(leaf->keys.data(), pos, count + 1);
+    throw;
+  }
+  if constexpr (!key_only) {
+    shiftRight(leaf->values.data(), pos, count);
+    try {
+      ::new (static_cast<void*>(&leaf->values[pos]))
+          Value(std::forward<Args>(args)...);
+    } catch (...) {
+      shiftLeft(leaf->values.data(), pos, count + 1);
+      leaf->keys[pos].~Key();
+      shiftLeft(leaf->keys.data(), pos, count + 1);
+      throw;
+    }
+  }
+  ++leaf->count;
+}
+
+// Деление полного листа и, по цепочке, полных предков. Все новые узлы и
+// копия разделителя создаются до первого изменения дерева, так что
+// исключение оставляет дерево нетронутым. После деления leaf и pos
+// указывают, куда встанет новый элемент
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTree<Key, Value, Compare, Allocator>::splitLeaf(Leaf*& leaf, size_t& pos,
+                                                      Inner* const* path,
+                                                      const size_t* slots,
+                                                      size_t depth) {
+  size_t full = 0;
+  while (full < depth && path[depth - 1 - full]->count == inner_slots) {
+    ++full;
+  }
+  size_t spare_count = full + (full == depth ? 1 : 0);
+  Inner* spares[max_height];
+  size_t allocated = 0;
+  Leaf* right = nullptr;
+  const size_t mid = leaf_slots / 2;
+  std::optional<Key> separator;
+  try {
+    right = createLeaf();
+    for (; allocated < spare_count; ++allocated) {
+      spares[allocated] = createInner();
+    }
+    separator.emplace(leaf->keys[mid]);
+  } catch (...) {
+    for (size_t i = 0; i < allocated; ++i) freeInner(spares[i]);
+    if (right) freeLeaf(right);
+    throw;
+  }
+
+  relocate(&leaf->keys[mid], leaf_slots - mid, right->keys.data());
+  if constexpr (!key_only) {
+    relocate(&leaf->values[mid], leaf_slots - mid, right->values.data());
+  }
+  right->count = leaf_slots - mid;
+  leaf->count = mid;
+  right->prev = leaf;
+  right->next = leaf->next;
+  if (leaf->next) {
+    leaf->next->prev = right;
+  } else {
+    last_ = right;
+  }
+  leaf->next = right;
+
+  Key up = std::move(*separator);
+  Node* child = right;
+  if (pos > mid) {
+    leaf = right;
+    pos -= mid;
+  }
+  // Пара (разделитель, правая половина) поднимается, пока родитель полон
+  for (size_t level = depth;; --level) {
+    if (level == 0) {
+      Inner* root = spares[--spare_count];
+      root->children[0] = root_;
+      insertChild(root, 0, std::move(up), child);
+      root_ = root;
+      break;
+    }
+    Inner* parent = path[level - 1];
+    size_t index = slots[level - 1];
+    if (parent->count < inner_slots) {
+      insertChild(parent, index, std::move(up), child);
+      break;
+    }
+    Inner* sibling = spares[--spare_count];
+    const size_t half = inner_slots / 2;
+    Key middle = std::move(parent->keys[half]);
+    parent->keys[half].~Key();
+    relocate(&parent->keys[half + 1], inner_slots - half - 1,
+             sibling->keys.data());
+    std::memcpy(sibling->children, &parent->children[half + 1],
+                (inner_slots - half) * sizeof(Node*));
+    sibling->count = inner_slots - half - 1;
+    parent->count = half;
+    if (index <= half) {
+      insertChild(parent, index, std::move(up), child);
+    } else {
+      insertChild(sibling, index - half - 1, std::move(up), child);
+    }
+    up = std::move(middle);
+    child = sibling;
+  }
+}
+
+// Разделитель встает на место index, новый потомок - справа от него
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTree<Key, Value, Compare, Allocator>::insertChild(Inner* parent,
+                                                        size_t index,
+                                                        Key&& separator,
+                                                        Node* child) {
+  size_t count = parent->count;
+  shiftRight(parent->keys.data(), index, count);
+  ::new (static_cast<void*>(&parent->keys[index])) Key(std::move(separator));
+  std::memmove(&parent->children[index + 2], &parent->children[index + 1],
+               (count - index) * sizeof(Node*));
+  parent->children[index + 1] = child;
+  ++parent->count;
+}
+
+// Удаление
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, Compare, Allocator>::size_type
+BTree<Key, Value, Compare, Allocator>::eraseKey(const K& key) {
+  if (root_ == nullptr || !eraseFrom(root_, key)) return 0;
+  --size_;
+  releaseRoot();
+  return 1;
+}
+
+// Спуск к листу; на обратном пути потомок, ставший меньше половины,
+// занимает элемент у соседа или сливается с ним
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+bool BTree<Key, Value, Compare, Allocator>::eraseFrom(Node* node,
+                                                      const K& key) {
+  if (node->leaf) {
+    Leaf* leaf = static_cast<Leaf*>(node);
+    size_t pos = lowerIndex(leaf->keys.data(), leaf->count, key);
+    if (pos == leaf->count || keyLess(key, leaf->keys[pos])) return false;
+    leaf->keys[pos].~Key();
+    shiftLeft(leaf->keys.data(), pos, leaf->count);
+    if constexpr (!key_only) {
+      leaf->values[pos].~Value();
+      shiftLeft(leaf->values.data(), pos, leaf->count);
+    }
+    --leaf->count;
+    return true;
+  }
+  Inner* inner = static_cast<Inner*>(node);
+  size_t index = upperIndex(inner->keys.data(), inner->count, key);
+  if (!eraseFrom(inner->children[index], key)) return false;
+  Node* child = inner->children[index];
+  if (child->count < (child->leaf ? leaf_min : inner_min)) {
+    rebalance(inner, index);
+  }
+  return true;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTree<Key, Value, Compare, Allocator>::rebalance(Inner* parent,
+                                                      size_t index) {
+  Node* child = parent->children[index];
+  const size_t min = child->leaf ? leaf_min : inner_min;
+  Node* left = index > 0 ? parent->children[index - 1] : nullptr;
+  Node* right = index < parent->count ? parent->children[index + 1] : nullptr;
+  if (left && left->count > min) {
+    // Последний элемент левого соседа переходит в начало потомка
+    if (child->leaf) {
+      Leaf* to = static_cast<Leaf*>(child);
+      Leaf* from = static_cast<Leaf*>(left);
+      shiftRight(to->keys.data(), 0, to->count);
+      relocate(&from->keys[from->count - 1], 1, &to->keys[0]);
+      if constexpr (!key_only) {
+        shiftRight(to->values.data(), 0, to->count);
+        relocate(&from->values[from->count - 1], 1, &to->values[0]);
+      }
+      --from->count;
+      ++to->count;
+      parent->keys[index - 1] = to->keys[0];
+    } else {
+      Inner* to = static_cast<Inner*>(child);
+      Inner* from = static_cast<Inner*>(left);
+      shiftRight(to->keys.data(), 0, to->count);
+      ::new (static_cast<void*>(&to->keys[0]))
+          Key(std::move(parent->keys[index - 1]));
+      std::memmove(&to->children[1], &to->children[0],
+                   (to->count + 1) * sizeof(Node*));
+      to->children[0] = from->children[from->count];
+      parent->keys[index - 1] = std::move(from->keys[from->count - 1]);
+      from->keys[from->count - 1].~Key();
+      --from->count;
+      ++to->count;
+    }
+  } else if (right && right->count > min) {
+    // Первый элемент правого соседа переходит в конец потомка
+    if (child->leaf) {
+      Leaf* to = static_cast<Leaf*>(child);
+      Leaf* from = static_cast<Leaf*>(right);
+      relocate(&from->keys[0], 1, &to->keys[to->count]);
+      shiftLeft(from->keys.data(), 0, from->count);
+      if constexpr (!key_only) {
+        relocate(&from->values[0], 1, &to->values[to->count]);
+        shiftLeft(from->values.data(), 0, from->count);
+      }
+      --from->count;
+      ++to->count;
+      parent->keys[index] = from->keys[0];
+    } else {
+      Inner* to = static_cast<Inner*>(child);
+      Inner* from = static_cast<Inner*>(right);
+      ::new (static_cast<void*>(&to->keys[to->count]))
+          Key(std::move(parent->keys[index]));
+      to->children[to->count + 1] = from->children[0];
+      parent->keys[index] = std::move(from->keys[0]);
+      from->keys[0].~Key();
+      shiftLeft(from->keys.data(), 0, from->count);
+      std::memmove(&from->children[0], &from->children[1],
+                   from->count * sizeof(Node*));
+      --from->count;
+      ++to->count;
+    }
+  } else {
+    mergeChildren(parent, left ? index - 1 : index);
+  }
+}
+
+// Слияние children[index] и children[index + 1]; вместе они помещаются в
+// один узел, потому что один из них меньше половины, а другой не больше
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTree<Key, Value, Compare, Allocator>::mergeChildren(Inner* parent,
+                                                          size_t index) {
+  Node* left = parent->children[index];
+  Node* right = parent->children[index + 1];
+  if (left->leaf) {
+    Leaf* to = static_cast<Leaf*>(left);
+    Leaf* from = static_cast<Leaf*>(right);
+    relocate(from->keys.data(), from->count, &to->keys[to->count]);
+    if constexpr (!key_only) {
+      relocate(from->values.data(), from->count, &to->values[to->count]);
+    }
+    to->count += from->count;
+    to->next = from->next;
+    if (from->next) {
+      from->next->prev = to;
+    } else {
+      last_ = to;
+    }
+    freeLeaf(from);
+  } else {
+    Inner* to = static_cast<Inner*>(left);
+    Inner* from = static_cast<Inner*>(right);
+    ::new (static_cast<void*>(&to->keys[to->count]))
+        Key(std::move(parent->keys[index]));
+    relocate(from->keys.data(), from->count, &to->keys[to->count + 1]);
+    std::memcpy(&to->children[to->count + 1], from->children,
+                (from->count + 1) * sizeof(Node*));
+    to->count += from->count + 1;
+    freeInner(from);
+  }
+  parent->keys[index].~Key();
+  shiftLeft(parent->keys.data(), index, parent->count);
+  std::memmove(&parent->children[index + 1], &parent->children[index + 2],
+               (parent->count - index - 1) * sizeof(Node*));
+  --parent->count;
+}
+
+// Корень без разделителей заменяется единственным потомком, пустой
+// корневой лист освобождается
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTree<Key, Value, Compare, Allocator>::releaseRoot() noexcept {
+  if (root_->leaf) {
+    if (root_->count == 0) {
+      freeLeaf(static_cast<Leaf*>(root_));
+      root_ = nullptr;
+      first_ = last_ = nullptr;
+    }
+  } else if (root_->count == 0) {
+    Inner* old_root = static_cast<Inner*>(root_);
+    root_ = old_root->children[0];
+    freeInner(old_root);
+  }
+}
+}  // namespace s21
+
+#endif  // S21_BTREE_TPP
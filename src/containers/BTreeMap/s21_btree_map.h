@@ -0,0 +1,195 @@
+#ifndef S21_BTREE_MAP_H
+#define S21_BTREE_MAP_H
+
+#include <initializer_list>
+#include <limits>
+#include <vector>
+
+#include "../BTree/s21_btree.h"
+
+namespace s21 {
+// Словарь на B-дереве: тот же интерфейс, что у map, но ключи и значения
+// лежат в узлах отдельными непрерывными массивами. Поэтому пары
+// std::pair<const Key, T> в памяти нет, и итератор отдает пару ссылок на
+// ключ и значение. Итераторы становятся недействительными после любой
+// вставки или удаления, так как элементы переезжают между узлами
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class btree_map : public BTree<Key, T, Compare, Allocator> {
+  using tree_type = BTree<Key, T, Compare, Allocator>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = std::pair<const Key&, T&>;
+  using const_reference = std::pair<const Key&, const T&>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // Итератор по элементам; IsConst выбирает константный вариант
+  template <bool IsConst>
+  class BTreeMapIterator {
+    friend class btree_map;
+    template <bool>
+    friend class BTreeMapIterator;
+    using tree_iterator =
+        std::conditional_t<IsConst, typename tree_type::const_iterator,
+                           typename tree_type::iterator>;
+
+   private:
+    tree_iterator tree_iter;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<IsConst, const_reference,
+                                         btree_map::reference>;
+    // it->second работает через временную пару ссылок
+    struct pointer {
+      reference ref;
+      const reference* operator->() const { return &ref; }
+    };
+
+    BTreeMapIterator() = default;
+    explicit BTreeMapIterator(tree_iterator iter) : tree_iter(iter) {}
+    template <bool C = IsConst, typename = std::enable_if_t<C>>
+    BTreeMapIterator(const BTreeMapIterator<false>& other)
+        : tree_iter(other.tree_iter) {}
+
+    reference operator*() const {
+      if (tree_iter == tree_iterator()) {
+        throw std::out_of_range("Iterator is out of range or uninitialized.");
+      }
+      return reference(tree_iter.key(), tree_iter.value());
+    }
+    pointer operator->() const { return pointer{**this}; }
+    BTreeMapIterator& operator++() {
+      ++tree_iter;
+      return *this;
+    }
+    BTreeMapIterator operator++(int) {
+      BTreeMapIterator temp = *this;
+      ++tree_iter;
+      return temp;
+    }
+    BTreeMapIterator& operator--() {
+      --tree_iter;
+      return *this;
+    }
+    BTreeMapIterator operator--(int) {
+      BTreeMapIterator temp = *this;
+      --tree_iter;
+      return temp;
+    }
+    friend bool operator==(const BTreeMapIterator& left,
+                           const BTreeMapIterator& right) {
+      return left.tree_iter == right.tree_iter;
+    }
+    friend bool operator!=(const BTreeMapIterator& left,
+                           const BTreeMapIterator& right) {
+      return left.tree_iter != right.tree_iter;
+    }
+  };
+  using iterator = BTreeMapIterator<false>;
+  using const_iterator = BTreeMapIterator<true>;
+  iterator begin() { return iterator(tree_type::begin()); }
+  iterator end() { return iterator(tree_type::end()); }
+  const_iterator begin() const { return const_iterator(tree_type::begin()); }
+  const_iterator end() const { return const_iterator(tree_type::end()); }
+
+  // Конструкторы и деструктор
+  btree_map() : tree_type() {}
+  explicit btree_map(const Allocator& alloc) : tree_type(alloc) {}
+  explicit btree_map(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
+  btree_map(std::initializer_list<value_type> const& items,
+            const Allocator& alloc = Allocator());
+  btree_map(const btree_map& m) : tree_type(m) {}
+  btree_map(btree_map&& m) noexcept : tree_type(s21::move(m)) {}
+  ~btree_map() = default;
+
+  // Перегрузки операторов
+  btree_map& operator=(const btree_map& m);
+  btree_map& operator=(btree_map&& m) noexcept(
+      std::is_nothrow_move_assignable<tree_type>::value);
+
+  // Методы класса
+  T& at(const Key& key);
+  const T& at(const Key& key) const;
+  T& operator[](const Key& key) {
+    return tree_type::tryEmplace(key).first.value();
+  }
+  iterator find(const key_type& key) {
+    return iterator(tree_type::findKey(key));
+  }
+  const_iterator find(const key_type& key) const {
+    return const_iterator(tree_type::findKey(key));
+  }
+  // Поиск по ключу другого типа без построения Key (например,
+  // std::string_view при Compare = std::less<>)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) {
+    return iterator(tree_type::findKey(key));
+  }
+  bool contains(const Key& key) const {
+    return const_iterator(tree_type::findKey(key)) != end();
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const {
+    return const_iterator(tree_type::findKey(key)) != end();
+  }
+  size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+  // Первый элемент, не меньший key, и первый элемент, больший key
+  iterator lower_bound(const Key& key) {
+    return iterator(tree_type::lowerBound(key));
+  }
+  const_iterator lower_bound(const Key& key) const {
+    return const_iterator(tree_type::lowerBound(key));
+  }
+  iterator upper_bound(const Key& key) {
+    return iterator(tree_type::upperBound(key));
+  }
+  const_iterator upper_bound(const Key& key) const {
+    return const_iterator(tree_type::upperBound(key));
+  }
+  size_type max_size() const { return std::numeric_limits<size_type>::max(); }
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return insert(value.first, value.second);
+  }
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return try_emplace(key, obj);
+  }
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj);
+  // Значение строится из args, только если ключа еще нет
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  // Подсказка принимается ради совместимости с map: спуск по B-дереву
+  // короткий, и вставка всегда идет от корня
+  iterator insert(iterator, const value_type& value) {
+    return insert(value).first;
+  }
+  template <typename... Args>
+  iterator emplace_hint(iterator, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+  void erase(iterator pos);
+  size_type erase(const Key& key) { return tree_type::eraseKey(key); }
+  void swap(btree_map& other) { tree_type::swap(other); }
+  void merge(btree_map& other);
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+};
+}  // namespace s21
+
+#include "s21_btree_map.tpp"
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef S21_BTREE_MAP_TPP
+#define S21_BTREE_MAP_TPP
+
+#include "s21_btree_map.h"
+
+namespace s21 {
+template <typename Key, typename T, typename Compare, typename Allocator>
+btree_map<Key, T, Compare, Allocator>::btree_map(
+    std::initializer_list<value_type> const& items, const Allocator& alloc)
+    : tree_type(alloc) {
+  for (const auto& item : items) {
+    this->insert(item.first, item.second);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+btree_map<Key, T, Compare, Allocator>&
+btree_map<Key, T, Compare, Allocator>::operator=(const btree_map& m) {
+  if (this != &m) {
+    tree_type::operator=(m);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+btree_map<Key, T, Compare, Allocator>&
+btree_map<Key, T, Compare, Allocator>::operator=(btree_map&& m) noexcept(
+    std::is_nothrow_move_assignable<tree_type>::value) {
+  if (this != &m) {
+    tree_type::operator=(s21::move(m));
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+T& btree_map<Key, T, Compare, Allocator>::at(const Key& key) {
+  auto it = tree_type::findKey(key);
+  if (it == tree_type::end()) {
+    throw std::out_of_range("Key not found in map");
+  }
+  return it.value();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+const T& btree_map<Key, T, Compare, Allocator>::at(const Key& key) const {
+  auto it = tree_type::findKey(key);
+  if (it == tree_type::end()) {
+    throw std::out_of_range("Key not found in map");
+  }
+  return it.value();
+}
+
+// Вставка или изменение существующего значения
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::insert_or_assign(const Key& key,
+                                                        const T& obj) {
+  auto result = tree_type::tryEmplace(key, obj);
+  if (!result.second) {
+    result.first.value() = obj;
+  }
+  return {iterator(result.first), result.second};
+}
+
+// Вставка с построением значения на месте
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::try_emplace(const Key& key,
+                                                   Args&&... args) {
+  auto [it, inserted] =
+      tree_type::tryEmplace(key, std::forward<Args>(args)...);
+  return {iterator(it), inserted};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::try_emplace(Key&& key,
+                                                   Args&&... args) {
+  auto [it, inserted] =
+      tree_type::tryEmplace(s21::move(key), std::forward<Args>(args)...);
+  return {iterator(it), inserted};
+}
+
+// Как map::emplace
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::emplace(Args&&... args) {
+  std::pair<Key, T> value(std::forward<Args>(args)...);
+  return try_emplace(s21::move(value.first), s21::move(value.second));
+}
+
+// Ключ под итератором разрушается уже после последнего сравнения с ним
+template <typename Key, typename T, typename Compare, typename Allocator>
+void btree_map<Key, T, Compare, Allocator>::erase(iterator pos) {
+  if (pos != end()) {
+    tree_type::eraseKey(pos.tree_iter.key());
+  }
+}
+
+// Слияние с той же семантикой, что у map: отсутствующие ключи
+// переносятся из other, а у общих ключей значение в this заменяется
+// значением из other, и сами они остаются в other. other собирается
+// заново за один проход вместо поиска и удаления каждого ключа
+template <typename Key, typename T, typename Compare, typename Allocator>
+void btree_map<Key, T, Compare, Allocator>::merge(btree_map& other) {
+  if (this == &other) return;
+  btree_map rest(other.key_comp(), other.get_allocator());
+  for (auto it = other.tree_type::begin(); it != other.tree_type::end();
+       ++it) {
+    auto [mine, inserted] =
+        tree_type::tryEmplace(it.key(), s21::move(it.value()));
+    if (!inserted) {
+      mine.value() = it.value();
+      rest.tryEmplace(it.key(), s21::move(it.value()));
+    }
+  }
+  other.swap(rest);
+}
+
+// Множественная вставка. Следующая вставка может сдвинуть уже вставленные
+// элементы, поэтому итераторы ищутся заново после всех вставок
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::vector<
+    std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>>
+btree_map<Key, T, Compare, Allocator>::insert_many(Args&&... args) {
+  std::vector<std::pair<iterator, bool>> results;
+  std::vector<Key> keys;
+  results.reserve(sizeof...(Args));
+  keys.reserve(sizeof...(Args));
+  (..., [&](auto&& arg) {
+    auto [it, inserted] = this->insert(std::forward<decltype(arg)>(arg));
+    keys.push_back(it.tree_iter.key());
+    results.emplace_back(it, inserted);
+  }(std::forward<Args>(args)));
+  for (size_t i = 0; i < keys.size(); ++i) {
+    results[i].first = find(keys[i]);
+  }
+  return results;
+}
+}  // namespace s21
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef S21_BTREE_SET_H
+#define S21_BTREE_SET_H
+
+#include <initializer_list>
+#include <limits>
+#include <vector>
+
+#include "../BTree/s21_btree.h"
+
+namespace s21 {
+// Множество на B-дереве: тот же интерфейс, что у set, но ключи лежат
+// подряд в широких узлах. Итераторы становятся недействительными после
+// любой вставки или удаления, так как элементы переезжают между узлами
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class btree_set : public BTree<Key, tree_key_only, Compare, Allocator> {
+  using tree_type = BTree<Key, tree_key_only, Compare, Allocator>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // Конструкторы и деструктор
+  btree_set() : tree_type() {}
+  explicit btree_set(const Allocator& alloc) : tree_type(alloc) {}
+  explicit btree_set(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
+  btree_set(std::initializer_list<value_type> const& items,
+            const Allocator& alloc = Allocator());
+  btree_set(const btree_set& s) : tree_type(s) {}
+  btree_set(btree_set&& s) noexcept : tree_type(s21::move(s)) {}
+  ~btree_set() = default;
+
+  // Перегрузки операторов
+  btree_set& operator=(btree_set&& s) noexcept(
+      std::is_nothrow_move_assignable<tree_type>::value);
+  btree_set& operator=(const btree_set& s);
+
+  // Методы класса
+  size_type max_size() const { return std::numeric_limits<size_type>::max(); }
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return tree_type::tryEmplace(value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return tree_type::tryEmplace(s21::move(value));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  // Подсказка не используется, как в btree_map::insert(iterator, value)
+  iterator insert(iterator, const value_type& value) {
+    return insert(value).first;
+  }
+  template <typename... Args>
+  iterator emplace_hint(iterator, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+  void erase(iterator pos);
+  size_type erase(const key_type& key) { return tree_type::eraseKey(key); }
+  void swap(btree_set& other) { tree_type::swap(other); }
+  void merge(btree_set& other);
+  iterator find(const key_type& key) { return tree_type::findKey(key); }
+  const_iterator find(const key_type& key) const {
+    return tree_type::findKey(key);
+  }
+  bool contains(const key_type& key) const {
+    return find(key) != this->end();
+  }
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+  // Первый элемент, не меньший key, и первый элемент, больший key
+  iterator lower_bound(const key_type& key) {
+    return tree_type::lowerBound(key);
+  }
+  const_iterator lower_bound(const key_type& key) const {
+    return tree_type::lowerBound(key);
+  }
+  iterator upper_bound(const key_type& key) {
+    return tree_type::upperBound(key);
+  }
+  const_iterator upper_bound(const key_type& key) const {
+    return tree_type::upperBound(key);
+  }
+  // Поиск по значению другого типа без построения Key; только для
+  // прозрачного Compare (например, std::less<>)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) {
+    return tree_type::findKey(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K& key) const {
+    return tree_type::findKey(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const {
+    return find(key) != this->end();
+  }
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+};
+}  // namespace s21
+
+#include "s21_btree_set.tpp"
+
+#endif  // S21_BTREE_SET_H
@@ -0,0 +1,83 @@
+#ifndef S21_BTREE_SET_TPP
+#define S21_BTREE_SET_TPP
+
+#include "s21_btree_set.h"
+
+namespace s21 {
+template <typename Key, typename Compare, typename Allocator>
+btree_set<Key, Compare, Allocator>::btree_set(
+    std::initializer_list<value_type> const& items, const Allocator& alloc)
+    : tree_type(alloc) {
+  for (const auto& item : items) {
+    this->insert(item);
+  }
+}
+
+// Перегрузки оператора присвоения
+template <typename Key, typename Compare, typename Allocator>
+btree_set<Key, Compare, Allocator>&
+btree_set<Key, Compare, Allocator>::operator=(btree_set&& s) noexcept(
+    std::is_nothrow_move_assignable<tree_type>::value) {
+  if (this != &s) {
+    tree_type::operator=(s21::move(s));
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+btree_set<Key, Compare, Allocator>&
+btree_set<Key, Compare, Allocator>::operator=(const btree_set& s) {
+  if (this != &s) {
+    tree_type::operator=(s);
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename btree_set<Key, Compare, Allocator>::iterator, bool>
+btree_set<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+// Ключ под итератором разрушается уже после последнего сравнения с ним
+template <typename Key, typename Compare, typename Allocator>
+void btree_set<Key, Compare, Allocator>::erase(iterator pos) {
+  if (pos != this->end()) {
+    tree_type::eraseKey(*pos);
+  }
+}
+
+// Слияние, как у set: все ключи other вставляются, other очищается
+template <typename Key, typename Compare, typename Allocator>
+void btree_set<Key, Compare, Allocator>::merge(btree_set& other) {
+  if (this == &other) return;
+  for (auto it = other.begin(); it != other.end(); ++it) {
+    this->insert(*it);
+  }
+  other.clear();
+}
+
+// Итераторы ищутся заново, как в btree_map::insert_many
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::vector<
+    std::pair<typename btree_set<Key, Compare, Allocator>::iterator, bool>>
+btree_set<Key, Compare, Allocator>::insert_many(Args&&... args) {
+  std::vector<std::pair<iterator, bool>> result;
+  std::vector<Key> keys;
+  result.reserve(sizeof...(Args));
+  keys.reserve(sizeof...(Args));
+  (..., [&](auto&& arg) {
+    auto [it, inserted] = this->insert(std::forward<decltype(arg)>(arg));
+    keys.push_back(*it);
+    result.emplace_back(it, inserted);
+  }(std::forward<Args>(args)));
+  for (size_t i = 0; i < keys.size(); ++i) {
+    result[i].first = find(keys[i]);
+  }
+  return result;
+}
+}  // namespace s21
+
+#endif  // S21_BTREE_SET_TPP
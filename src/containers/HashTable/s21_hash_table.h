@@ -0,0 +1,271 @@
+#ifndef S21_HASH_TABLE_H
+#define S21_HASH_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "../Tree/s21_tree.h"
+
+namespace s21 {
+
+// Хеш-таблица с открытой адресацией в стиле SwissTable. Элементы лежат
+// прямо в массиве ячеек, а рядом хранится массив управляющих байтов:
+// ячейка пуста, удалена или занята, и тогда в байте 7 младших бит хеша.
+// Поиск сравнивает 16 управляющих байтов группы за раз (через SSE2, если
+// он есть) и обращается к ключу только при совпадении этих 7 бит, так что
+// на промах почти всегда хватает одного чтения группы. Любая вставка может
+// перестроить таблицу, поэтому итераторы после вставки недействительны
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class HashTable {
+ protected:
+  static constexpr bool key_only = std::is_same_v<Value, tree_key_only>;
+  static constexpr size_t group_width = 16;
+  // Занятая ячейка хранит в управляющем байте число от 0 до 127, свободные
+  // отрицательны, так что их маска - это просто знаковые биты группы
+  using ctrl_t = signed char;
+  static constexpr ctrl_t ctrl_empty = -128;
+  static constexpr ctrl_t ctrl_deleted = -2;
+  static constexpr float default_max_load = 0.875f;
+
+  struct alignas(group_width) Group {
+    ctrl_t ctrl[group_width];
+  };
+  // Неинициализированная ячейка: ключ и значение строятся вручную; для set
+  // место под значение вырождается в один байт
+  struct Slot {
+    alignas(Key) unsigned char key_bytes[sizeof(Key)];
+    alignas(Value) unsigned char value_bytes[key_only ? 1 : sizeof(Value)];
+    Key& key() { return *reinterpret_cast<Key*>(key_bytes); }
+    const Key& key() const { return *reinterpret_cast<const Key*>(key_bytes); }
+    Value& value() { return *reinterpret_cast<Value*>(value_bytes); }
+    const Value& value() const {
+      return *reinterpret_cast<const Value*>(value_bytes);
+    }
+  };
+
+  using slot_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Slot>;
+  using group_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Group>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+  using group_traits = std::allocator_traits<group_allocator>;
+
+  slot_allocator alloc_;
+  Hash hash_;
+  KeyEqual eq_;
+  Group* groups_;
+  Slot* slots_;
+  // Число ячеек: 0 или степень двойки не меньше group_width
+  size_t capacity_;
+  size_t size_;
+  // Ячейки с пометкой ctrl_deleted: они не пусты для поиска, но годятся
+  // для вставки
+  size_t deleted_;
+  float max_load_;
+
+ private:
+  void allocate(size_t capacity, Group*& groups, Slot*& slots);
+  void deallocate(Group* groups, Slot* slots, size_t capacity) noexcept;
+  void destroyElements() noexcept;
+  void copyFrom(const HashTable& other);
+  void resize(size_t capacity);
+  // Вместимость под count элементов без перестройки
+  size_t capacityFor(size_t count) const;
+  size_t maxLoad() const {
+    return static_cast<size_t>(static_cast<float>(capacity_) * max_load_);
+  }
+  template <typename K>
+  size_t hashOf(const K& key) const;
+  ctrl_t& ctrlAt(size_t index) const {
+    return groups_[index / group_width].ctrl[index % group_width];
+  }
+  // Первая свободная (пустая или удаленная) ячейка на пути поиска
+  static size_t freeIndex(const Group* groups, size_t capacity, size_t hash);
+  template <typename K>
+  size_t findIndex(const K& key, size_t hash) const;
+  // Первая занятая ячейка, начиная с index, или capacity_
+  size_t nextFull(size_t index) const;
+  // Построение элемента в свободной ячейке index
+  template <typename K, typename... Args>
+  void constructAt(size_t index, size_t hash, K&& key, Args&&... args);
+
+  // Битовые маски по группе: бит i установлен, если подошел байт i
+  static unsigned match(const Group& group, ctrl_t tag);
+  static unsigned matchEmpty(const Group& group);
+  static unsigned matchFree(const Group& group);
+  static size_t lowestBit(unsigned mask) {
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_ctz(mask));
+#else
+    size_t bit = 0;
+    while (!(mask >> bit & 1u)) ++bit;
+    return bit;
+#endif
+  }
+
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  HashTable();
+  explicit HashTable(const Allocator& alloc);
+  explicit HashTable(size_type bucket_count, const Hash& hash = Hash(),
+                     const KeyEqual& equal = KeyEqual(),
+                     const Allocator& alloc = Allocator());
+  HashTable(const HashTable& other);
+  HashTable(HashTable&& other) noexcept;
+  HashTable& operator=(const HashTable& other);
+  HashTable& operator=(HashTable&& other) noexcept(
+      slot_traits::propagate_on_container_move_assignment::value ||
+      slot_traits::is_always_equal::value);
+  ~HashTable();
+
+  // Удаляет элементы, но оставляет выделенные ячейки
+  void clear() noexcept;
+  void swap(HashTable& other) noexcept;
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return eq_; }
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Число ячеек и доля занятых
+  size_type bucket_count() const { return capacity_; }
+  float load_factor() const;
+  // Доля заполнения, при которой таблица растет. Допустимы значения от
+  // 0.125 до 0.9375; остальные заменяются ближайшим допустимым
+  float max_load_factor() const { return max_load_; }
+  void max_load_factor(float max_load);
+  // Готовит место под count элементов без перестроек
+  void reserve(size_type count);
+  // Перестраивает таблицу не меньше чем с bucket_count ячейками (и не
+  // меньше, чем нужно для текущих элементов); удаленные ячейки очищаются
+  void rehash(size_type bucket_count);
+
+  class const_iterator;
+  // Итератор - номер ячейки; end() - номер за последней ячейкой
+  class iterator {
+    friend class HashTable;
+    friend class const_iterator;
+
+   private:
+    const HashTable* table;
+    size_t index;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    iterator(const HashTable* table = nullptr, size_t index = 0)
+        : table(table), index(index) {}
+    iterator& operator++() {
+      index = table->nextFull(index + 1);
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator temp = *this;
+      ++*this;
+      return temp;
+    }
+    const Key& operator*() const { return table->slots_[index].key(); }
+    const Key& key() const { return table->slots_[index].key(); }
+    // Значение элемента (только для map)
+    Value& value() const { return table->slots_[index].value(); }
+    bool operator==(const iterator& other) const {
+      return index == other.index;
+    }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+  };
+  // Итератор для константных объектов
+  class const_iterator {
+    friend class HashTable;
+
+   private:
+    const HashTable* table;
+    size_t index;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    const_iterator(const HashTable* table = nullptr, size_t index = 0)
+        : table(table), index(index) {}
+    const_iterator(const iterator& other)
+        : table(other.table), index(other.index) {}
+    const_iterator& operator++() {
+      index = table->nextFull(index + 1);
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator temp = *this;
+      ++*this;
+      return temp;
+    }
+    const Key& operator*() const { return table->slots_[index].key(); }
+    const Key& key() const { return table->slots_[index].key(); }
+    const Value& value() const { return table->slots_[index].value(); }
+    bool operator==(const const_iterator& other) const {
+      return index == other.index;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+  };
+
+  iterator begin() { return iterator(this, nextFull(0)); }
+  iterator end() { return iterator(this, capacity_); }
+  const_iterator begin() const { return const_iterator(this, nextFull(0)); }
+  const_iterator end() const { return const_iterator(this, capacity_); }
+
+ protected:
+  template <typename K>
+  iterator findKey(const K& key) const {
+    return iterator(this, findIndex(key, hashOf(key)));
+  }
+  template <typename K>
+  bool containsKey(const K& key) const {
+    return findIndex(key, hashOf(key)) != capacity_;
+  }
+  // Элемент создается, только если ключа еще нет. Таблица растет до
+  // вставки, так что брошенное конструктором исключение оставляет ее
+  // без изменений
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> tryEmplace(K&& key, Args&&... args);
+  // Удаление элемента под итератором; таблица не перестраивается, так что
+  // остальные итераторы остаются действительными
+  void eraseAt(const_iterator pos) noexcept;
+  // Удаление по ключу; возвращает число удаленных элементов (0 или 1)
+  template <typename K>
+  size_type eraseKey(const K& key);
+  // Номер ячейки под итератором
+  static size_t indexOf(const_iterator pos) { return pos.index; }
+};
+
+}  // namespace s21
+
+#include "s21_hash_table.tpp"
+
+#endif
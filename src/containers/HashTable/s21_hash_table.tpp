@@ -0,0 +1,586 @@
+#ifndef S21_HASH_TABLE_TPP
+#define S21_HASH_TABLE_TPP
+
+#include "s21_hash_table.h"
+
+namespace s21 {
+// Конструкторы. Пустая таблица не выделяет память до первой вставки
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator>::HashTable()
+    : alloc_(),
+      hash_(),
+      eq_(),
+      groups_(nullptr),
+      slots_(nullptr),
+      capacity_(0),
+      size_(0),
+      deleted_(0),
+      max_load_(default_max_load) {}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator>::HashTable(
+    const Allocator& alloc)
+    : alloc_(alloc),
+      hash_(),
+      eq_(),
+      groups_(nullptr),
+      slots_(nullptr),
+      capacity_(0),
+      size_(0),
+      deleted_(0),
+      max_load_(default_max_load) {}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator>::HashTable(
+    size_type bucket_count, const Hash& hash, const KeyEqual& equal,
+    const Allocator& alloc)
+    : alloc_(alloc),
+      hash_(hash),
+      eq_(equal),
+      groups_(nullptr),
+      slots_(nullptr),
+      capacity_(0),
+      size_(0),
+      deleted_(0),
+      max_load_(default_max_load) {
+  if (bucket_count) {
+    rehash(bucket_count);
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator>::HashTable(
+    const HashTable& other)
+    : alloc_(slot_traits::select_on_container_copy_construction(other.alloc_)),
+      hash_(other.hash_),
+      eq_(other.eq_),
+      groups_(nullptr),
+      slots_(nullptr),
+      capacity_(0),
+      size_(0),
+      deleted_(0),
+      max_load_(other.max_load_) {
+  if (other.size_) {
+    copyFrom(other);
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator>::HashTable(
+    HashTable&& other) noexcept
+    : alloc_(std::move(other.alloc_)),
+      hash_(other.hash_),
+      eq_(other.eq_),
+      groups_(other.groups_),
+      slots_(other.slots_),
+      capacity_(other.capacity_),
+      size_(other.size_),
+      deleted_(other.deleted_),
+      max_load_(other.max_load_) {
+  other.groups_ = nullptr;
+  other.slots_ = nullptr;
+  other.capacity_ = other.size_ = other.deleted_ = 0;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator>&
+HashTable<Key, Value, Hash, KeyEqual, Allocator>::operator=(
+    const HashTable& other) {
+  if (this != &other) {
+    destroyElements();
+    deallocate(groups_, slots_, capacity_);
+    groups_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = size_ = deleted_ = 0;
+    if constexpr (slot_traits::propagate_on_container_copy_assignment::value) {
+      alloc_ = other.alloc_;
+    }
+    hash_ = other.hash_;
+    eq_ = other.eq_;
+    max_load_ = other.max_load_;
+    if (other.size_) {
+      copyFrom(other);
+    }
+  }
+  return *this;
+}
+
+// Массивы забираются целиком, только если наш аллокатор сможет их
+// освободить; иначе элементы копируются в собственную таблицу
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator>&
+HashTable<Key, Value, Hash, KeyEqual, Allocator>::operator=(
+    HashTable&& other) noexcept(slot_traits::
+                                    propagate_on_container_move_assignment::
+                                        value ||
+                                slot_traits::is_always_equal::value) {
+  if (this != &other) {
+    destroyElements();
+    deallocate(groups_, slots_, capacity_);
+    groups_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = size_ = deleted_ = 0;
+    hash_ = other.hash_;
+    eq_ = other.eq_;
+    max_load_ = other.max_load_;
+    if (slot_traits::propagate_on_container_move_assignment::value ||
+        alloc_ == other.alloc_) {
+      if constexpr (slot_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = std::move(other.alloc_);
+      }
+      std::swap(groups_, other.groups_);
+      std::swap(slots_, other.slots_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(size_, other.size_);
+      std::swap(deleted_, other.deleted_);
+    } else if (other.size_) {
+      copyFrom(other);
+      other.clear();
+    }
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator>::~HashTable() {
+  destroyElements();
+  deallocate(groups_, slots_, capacity_);
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator>::clear() noexcept {
+  destroyElements();
+  if (capacity_) {
+    std::memset(static_cast<void*>(groups_), ctrl_empty,
+                capacity_ / group_width * sizeof(Group));
+  }
+  size_ = deleted_ = 0;
+}
+
+// Обмен содержимым; аллокаторы меняются местами, только если это
+// разрешает propagate_on_container_swap
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator>::swap(
+    HashTable& other) noexcept {
+  if constexpr (slot_traits::propagate_on_container_swap::value) {
+    std::swap(alloc_, other.alloc_);
+  }
+  std::swap(hash_, other.hash_);
+  std::swap(eq_, other.eq_);
+  std::swap(groups_, other.groups_);
+  std::swap(slots_, other.slots_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(deleted_, other.deleted_);
+  std::swap(max_load_, other.max_load_);
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+float HashTable<Key, Value, Hash, KeyEqual, Allocator>::load_factor() const {
+  return capacity_ ? static_cast<float>(size_) / static_cast<float>(capacity_)
+                   : 0.0f;
+}
+
+// Хотя бы одна ячейка таблицы всегда остается пустой: на ней
+// останавливается поиск отсутствующего ключа
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator>::max_load_factor(
+    float max_load) {
+  max_load_ = max_load < 0.125f ? 0.125f : max_load;
+  max_load_ = max_load_ > 0.9375f ? 0.9375f : max_load_;
+  if (size_ + deleted_ > maxLoad()) {
+    resize(capacityFor(size_));
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator>::reserve(
+    size_type count) {
+  size_t capacity = capacityFor(count);
+  if (capacity > capacity_) {
+    resize(capacity);
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator>::rehash(
+    size_type bucket_count) {
+  size_t capacity = capacityFor(size_);
+  while (capacity < bucket_count) {
+    capacity *= 2;
+  }
+  resize(capacity);
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+size_t HashTable<Key, Value, Hash, KeyEqual, Allocator>::capacityFor(
+    size_t count) const {
+  size_t capacity = group_width;
+  while (static_cast<size_t>(static_cast<float>(capacity) * max_load_) <
+         count + 1) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+// Выделение массивов: управляющие байты сразу помечаются пустыми, ячейки
+// не инициализируются
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator>::allocate(
+    size_t capacity, Group*& groups, Slot*& slots) {
+  group_allocator group_alloc(alloc_);
+  groups = group_traits::allocate(group_alloc, capacity / group_width);
+  try {
+    slots = slot_traits::allocate(alloc_, capacity);
+  } catch (...) {
+    group_traits::deallocate(group_alloc, groups, capacity / group_width);
+    throw;
+  }
+  std::memset(static_cast<void*>(groups), ctrl_empty,
+              capacity / group_width * sizeof(Group));
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator>::deallocate(
+    Group* groups, Slot* slots, size_t capacity) noexcept {
+  if (capacity) {
+    group_allocator group_alloc(alloc_);
+    group_traits::deallocate(group_alloc, groups, capacity / group_width);
+    slot_traits::deallocate(alloc_, slots, capacity);
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, Value, Hash, KeyEqual,
+               Allocator>::destroyElements() noexcept {
+  for (size_t i = nextFull(0); i < capacity_; i = nextFull(i + 1)) {
+    slots_[i].key().~Key();
+    if constexpr (!key_only) {
+      slots_[i].value().~Value();
+    }
+  }
+}
+
+// Копия с той же вместимостью: хеши не пересчитываются, и каждый элемент
+// ложится в ту же ячейку. При исключении уже скопированное разрушается
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator>::copyFrom(
+    const HashTable& other) {
+  Group* groups;
+  Slot* slots;
+  allocate(other.capacity_, groups, slots);
+  size_t index = other.nextFull(0);
+  try {
+    for (; index < other.capacity_; index = other.nextFull(index + 1)) {
+      ::new (static_cast<void*>(slots[index].key_bytes))
+          Key(other.slots_[index].key());
+      if constexpr (!key_only) {
+        try {
+          ::new (static_cast<void*>(slots[index].value_bytes))
+              Value(other.slots_[index].value());
+        } catch (...) {
+          slots[index].key().~Key();
+          throw;
+        }
+      }
+    }
+  } catch (...) {
+    for (size_t i = other.nextFull(0); i < index; i = other.nextFull(i + 1)) {
+      slots[i].key().~Key();
+      if constexpr (!key_only) {
+        slots[i].value().~Value();
+      }
+    }
+    deallocate(groups, slots, other.capacity_);
+    throw;
+  }
+  std::memcpy(static_cast<void*>(groups), other.groups_,
+              other.capacity_ / group_width * sizeof(Group));
+  groups_ = groups;
+  slots_ = slots;
+  capacity_ = other.capacity_;
+  size_ = other.size_;
+  deleted_ = other.deleted_;
+}
+
+// Перестройка в новые массивы. Элементы переносятся перемещением, если оно
+// не бросает исключений, иначе копированием; тогда при исключении старая
+// таблица остается нетронутой
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator>::resize(
+    size_t capacity) {
+  Group* groups;
+  Slot* slots;
+  allocate(capacity, groups, slots);
+  size_t index = nextFull(0);
+  try {
+    for (; index < capacity_; index = nextFull(index + 1)) {
+      Slot& from = slots_[index];
+      size_t hash = hashOf(from.key());
+      size_t to = freeIndex(groups, capacity, hash);
+      ::new (static_cast<void*>(slots[to].key_bytes))
+          Key(std::move_if_noexcept(from.key()));
+      if constexpr (!key_only) {
+        try {
+          ::new (static_cast<void*>(slots[to].value_bytes))
+              Value(std::move_if_noexcept(from.value()));
+        } catch (...) {
+          slots[to].key().~Key();
+          throw;
+        }
+      }
+      groups[to / group_width].ctrl[to % group_width] =
+          static_cast<ctrl_t>(hash & 0x7F);
+    }
+  } catch (...) {
+    for (size_t i = 0; i < capacity; ++i) {
+      if (groups[i / group_width].ctrl[i % group_width] >= 0) {
+        slots[i].key().~Key();
+        if constexpr (!key_only) {
+          slots[i].value().~Value();
+        }
+      }
+    }
+    deallocate(groups, slots, capacity);
+    throw;
+  }
+  destroyElements();
+  deallocate(groups_, slots_, capacity_);
+  groups_ = groups;
+  slots_ = slots;
+  capacity_ = capacity;
+  deleted_ = 0;
+}
+
+// Хеш перемешивается умножением, так что и номер группы, и 7 бит метки
+// зависят от всех бит исходного хеша (std::hash для целых - тождество)
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K>
+size_t HashTable<Key, Value, Hash, KeyEqual, Allocator>::hashOf(
+    const K& key) const {
+  uint64_t hash = static_cast<uint64_t>(hash_(key));
+  hash *= 0x9E3779B97F4A7C15ull;
+  return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+// Группы перебираются с шагом 1, 2, 3, ...: при числе групп - степени
+// двойки такая последовательность обходит все группы
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+size_t HashTable<Key, Value, Hash, KeyEqual, Allocator>::freeIndex(
+    const Group* groups, size_t capacity, size_t hash) {
+  size_t mask = capacity / group_width - 1;
+  size_t group = (hash >> 7) & mask;
+  for (size_t step = 1;; ++step) {
+    unsigned free = matchFree(groups[group]);
+    if (free) {
+      return group * group_width + lowestBit(free);
+    }
+    group = (group + step) & mask;
+  }
+}
+
+// Поиск заканчивается на группе, где есть пустая ячейка: при вставке
+// ключ занял бы ее или одну из более ранних
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K>
+size_t HashTable<Key, Value, Hash, KeyEqual, Allocator>::findIndex(
+    const K& key, size_t hash) const {
+  if (capacity_ == 0) return 0;
+  size_t mask = capacity_ / group_width - 1;
+  size_t group = (hash >> 7) & mask;
+  ctrl_t tag = static_cast<ctrl_t>(hash & 0x7F);
+  for (size_t step = 1;; ++step) {
+    const Group& current = groups_[group];
+    for (unsigned found = match(current, tag); found; found &= found - 1) {
+      size_t index = group * group_width + lowestBit(found);
+      if (eq_(slots_[index].key(), key)) {
+        return index;
+      }
+    }
+    if (matchEmpty(current)) {
+      return capacity_;
+    }
+    group = (group + step) & mask;
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+size_t HashTable<Key, Value, Hash, KeyEqual, Allocator>::nextFull(
+    size_t index) const {
+  while (index < capacity_) {
+    unsigned full = ~matchFree(groups_[index / group_width]) & 0xFFFFu;
+    full >>= index % group_width;
+    if (full) {
+      return index + lowestBit(full);
+    }
+    index = (index / group_width + 1) * group_width;
+  }
+  return capacity_;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+unsigned HashTable<Key, Value, Hash, KeyEqual, Allocator>::match(
+    const Group& group, ctrl_t tag) {
+#ifdef __SSE2__
+  __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(group.ctrl));
+  return static_cast<unsigned>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), ctrl)));
+#else
+  unsigned mask = 0;
+  for (size_t i = 0; i < group_width; ++i) {
+    mask |= static_cast<unsigned>(group.ctrl[i] == tag) << i;
+  }
+  return mask;
+#endif
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+unsigned HashTable<Key, Value, Hash, KeyEqual, Allocator>::matchEmpty(
+    const Group& group) {
+  return match(group, ctrl_empty);
+}
+
+// Свободные ячейки - ровно те, у которых установлен знаковый бит
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+unsigned HashTable<Key, Value, Hash, KeyEqual, Allocator>::matchFree(
+    const Group& group) {
+#ifdef __SSE2__
+  __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(group.ctrl));
+  return static_cast<unsigned>(_mm_movemask_epi8(ctrl));
+#else
+  unsigned mask = 0;
+  for (size_t i = 0; i < group_width; ++i) {
+    mask |= static_cast<unsigned>(group.ctrl[i] < 0) << i;
+  }
+  return mask;
+#endif
+}
+
+// Сначала ключ ищется; таблица растет, только если ключа нет и вставка
+// заняла бы пустую ячейку сверх допустимой загрузки
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K, typename... Args>
+std::pair<typename HashTable<Key, Value, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+HashTable<Key, Value, Hash, KeyEqual, Allocator>::tryEmplace(
+    K&& key, Args&&... args) {
+  size_t hash = hashOf(key);
+  size_t index = findIndex(key, hash);
+  if (index != capacity_) {
+    return {iterator(this, index), false};
+  }
+  if (capacity_) {
+    index = freeIndex(groups_, capacity_, hash);
+  }
+  if (capacity_ == 0 ||
+      (ctrlAt(index) == ctrl_empty && size_ + deleted_ + 1 > maxLoad())) {
+    // key и args могут ссылаться на элементы этой же таблицы (например,
+    // insert(k, at(j))), а resize их перемещает и освобождает. Поэтому
+    // перед перестройкой элемент строится на стеке
+    Key new_key(std::forward<K>(key));
+    auto grow = [&] {
+      // Если больше половины занятого - удаленные ячейки, их хватит
+      // вычистить, не увеличивая таблицу
+      resize(size_ + 1 <= maxLoad() / 2 ? capacity_ : capacityFor(size_ + 1));
+      index = freeIndex(groups_, capacity_, hash);
+    };
+    if constexpr (key_only) {
+      grow();
+      constructAt(index, hash, s21::move(new_key));
+    } else {
+      Value value(std::forward<Args>(args)...);
+      grow();
+      constructAt(index, hash, s21::move(new_key), s21::move(value));
+    }
+  } else {
+    constructAt(index, hash, std::forward<K>(key), std::forward<Args>(args)...);
+  }
+  return {iterator(this, index), true};
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K, typename... Args>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator>::constructAt(
+    size_t index, size_t hash, K&& key, Args&&... args) {
+  Slot& slot = slots_[index];
+  ::new (static_cast<void*>(slot.key_bytes)) Key(std::forward<K>(key));
+  if constexpr (!key_only) {
+    try {
+      ::new (static_cast<void*>(slot.value_bytes))
+          Value(std::forward<Args>(args)...);
+    } catch (...) {
+      slot.key().~Key();
+      throw;
+    }
+  }
+  if (ctrlAt(index) == ctrl_deleted) {
+    --deleted_;
+  }
+  ctrlAt(index) = static_cast<ctrl_t>(hash & 0x7F);
+  ++size_;
+}
+
+// Ячейку можно сделать пустой, только если в ее группе уже есть пустая:
+// тогда ни один поиск не проходил через эту группу дальше. Иначе она
+// помечается удаленной, чтобы не оборвать чужую цепочку поиска
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator>::eraseAt(
+    const_iterator pos) noexcept {
+  size_t index = pos.index;
+  slots_[index].key().~Key();
+  if constexpr (!key_only) {
+    slots_[index].value().~Value();
+  }
+  --size_;
+  if (matchEmpty(groups_[index / group_width])) {
+    ctrlAt(index) = ctrl_empty;
+  } else {
+    ctrlAt(index) = ctrl_deleted;
+    ++deleted_;
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K>
+typename HashTable<Key, Value, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, Hash, KeyEqual, Allocator>::eraseKey(const K& key) {
+  size_t index = findIndex(key, hashOf(key));
+  if (index == capacity_) return 0;
+  eraseAt(const_iterator(this, index));
+  return 1;
+}
+}  // namespace s21
+
+#endif
@@ -1,10 +1,17 @@
 #ifndef S21_MAP_H
 #define S21_MAP_H
+
+#include <limits>
+#include <vector>
+
 #include "../Tree/s21_tree.h"
 
 namespace s21 {
-template <typename Key, typename T>
-class map : public RBTree<Key, T> {
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class map : public RBTree<Key, T, Compare, Allocator> {
+  using tree_type = RBTree<Key, T, Compare, Allocator>;
+
  public:
   using key_type = Key;
   using mapped_type = T;
@@ -12,35 +19,36 @@ class map : public RBTree<Key, T> {
   using reference = value_type&;
   using const_reference = const value_type&;
   using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
-  // Итератор
+  // Итератор указывает прямо на узел: разыменование возвращает ссылку на
+  // пару в узле без поиска по дереву, инкремент - амортизированное O(1)
   class MapIterator {
+    friend class map;
+    friend class MapConstIterator;
+
    private:
-    typename RBTree<Key, T>::iterator tree_iter;
-    map<Key, T>* parent_map;
+    typename tree_type::iterator tree_iter;
 
    public:
-    MapIterator(typename RBTree<Key, T>::iterator iter, map<Key, T>* map_ptr)
-        : tree_iter(iter), parent_map(map_ptr) {}
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
 
-    value_type operator*() const {
-      if (tree_iter == parent_map->end().tree_iter) {
-        throw std::out_of_range("Iterator is out of range or uninitialized.");
-      }
-      Key key = *tree_iter;
-      return {key, parent_map->at(key)};
-    }
+    MapIterator() = default;
+    explicit MapIterator(typename tree_type::iterator iter)
+        : tree_iter(iter) {}
 
-    const value_type* operator->() const {
-      if (tree_iter == parent_map->end().tree_iter) {
+    reference operator*() const {
+      if (tree_iter == typename tree_type::iterator()) {
         throw std::out_of_range("Iterator is out of range or uninitialized.");
       }
-      static std::optional<value_type>
-          current_value;  // Значение может отсутствовать
-      Key key = *tree_iter;
-      current_value.emplace(key, parent_map->at(key));
-      return &*current_value;
+      return tree_iter.entry();
     }
+    pointer operator->() const { return &**this; }
     MapIterator& operator++() {
       ++tree_iter;
       return *this;
@@ -50,6 +58,15 @@ class map : public RBTree<Key, T> {
       ++tree_iter;
       return temp;
     }
+    MapIterator& operator--() {
+      --tree_iter;
+      return *this;
+    }
+    MapIterator operator--(int) {
+      MapIterator temp = *this;
+      --tree_iter;
+      return temp;
+    }
     bool operator==(const MapIterator& other) const {
       return tree_iter == other.tree_iter;
     }
@@ -57,20 +74,96 @@ class map : public RBTree<Key, T> {
       return tree_iter != other.tree_iter;
     }
   };
+  // Итератор для константных объектов; строится и из обычного итератора
+  class MapConstIterator {
+    friend class map;
+
+   private:
+    typename tree_type::const_iterator tree_iter;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    MapConstIterator() = default;
+    explicit MapConstIterator(typename tree_type::const_iterator iter)
+        : tree_iter(iter) {}
+    MapConstIterator(const MapIterator& other) : tree_iter(other.tree_iter) {}
+
+    reference operator*() const {
+      if (tree_iter == typename tree_type::const_iterator()) {
+        throw std::out_of_range("Iterator is out of range or uninitialized.");
+      }
+      return tree_iter.entry();
+    }
+    pointer operator->() const { return &**this; }
+    MapConstIterator& operator++() {
+      ++tree_iter;
+      return *this;
+    }
+    MapConstIterator operator++(int) {
+      MapConstIterator temp = *this;
+      ++tree_iter;
+      return temp;
+    }
+    MapConstIterator& operator--() {
+      --tree_iter;
+      return *this;
+    }
+    MapConstIterator operator--(int) {
+      MapConstIterator temp = *this;
+      --tree_iter;
+      return temp;
+    }
+    friend bool operator==(const MapConstIterator& left,
+                           const MapConstIterator& right) {
+      return left.tree_iter == right.tree_iter;
+    }
+    friend bool operator!=(const MapConstIterator& left,
+                           const MapConstIterator& right) {
+      return left.tree_iter != right.tree_iter;
+    }
+  };
   using iterator = MapIterator;
-  using const_iterator = const MapIterator;
-  iterator begin() { return iterator(RBTree<Key, T>::begin(), this); }
-  iterator end() { return iterator(RBTree<Key, T>::end(), this); }
+  using const_iterator = MapConstIterator;
+  iterator begin() { return iterator(tree_type::begin()); }
+  iterator end() { return iterator(tree_type::end()); }
+  const_iterator begin() const { return const_iterator(tree_type::begin()); }
+  const_iterator end() const { return const_iterator(tree_type::end()); }
+  // Вынутый из словаря элемент; см. RBTree::NodeHandle
+  using node_type = typename tree_type::NodeHandle;
+  // Результат insert(node_type&&): если ключ уже был, узел остается в node,
+  // а position указывает на найденный элемент
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
 
   // Конструкторы и деструктор
-  map() : RBTree<Key, T>() {}
-  map(std::initializer_list<value_type> const& items);
-  map(const map& m) : RBTree<Key, T>(m) {}
-  map(map&& m) noexcept : RBTree<Key, T>(s21::move(m)) {}
+  map() : tree_type() {}
+  explicit map(const Allocator& alloc) : tree_type(alloc) {}
+  explicit map(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
+  map(std::initializer_list<value_type> const& items,
+      const Allocator& alloc = Allocator());
+  map(const map& m) : tree_type(m) {}
+  map(map&& m) noexcept : tree_type(s21::move(m)) {}
   ~map() = default;
+  // Построение map из отсортированного диапазона за O(n) без балансировок.
+  // С check_sorted вход проверяется заранее, и при нарушении порядка
+  // бросается std::invalid_argument; без проверки порядок - предусловие
+  template <typename ForwardIt>
+  static map from_sorted(ForwardIt first, ForwardIt last,
+                         bool check_sorted = false,
+                         const Allocator& alloc = Allocator());
 
   // Перегрузка оператора
-  map& operator=(map&& m) noexcept;
+  map& operator=(map&& m) noexcept(
+      std::is_nothrow_move_assignable<tree_type>::value);
 
   // Методы класса
   T& at(const Key& key);
@@ -78,20 +171,98 @@ class map : public RBTree<Key, T> {
   T& operator[](const Key& key);
   iterator find(const key_type& key);
   const_iterator find(const key_type& key) const;
+  // Поиск по ключу другого типа без построения Key (например,
+  // std::string_view при Compare = std::less<>)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) {
+    return iterator(
+        typename tree_type::iterator(this, this->findNode(key)));
+  }
   bool empty() const { return this->size() == 0; }
   size_type size() const { return this->node_count; }
   size_type max_size() const { return std::numeric_limits<size_type>::max(); }
-  void clear() { RBTree<Key, T>::clear(this->root); }
+  void clear() { tree_type::clear(); }
   std::pair<iterator, bool> insert(const value_type& value);
   std::pair<iterator, bool> insert(const Key& key, const T& obj);
   std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj);
+  // Значение строится из args, только если ключа еще нет; иначе ни узел,
+  // ни значение не создаются
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  // Вставка с подсказкой: амортизированное O(1), если ключ встает рядом
+  // с hint (например, при вставке по возрастанию с hint == end())
+  iterator insert(iterator hint, const value_type& value);
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args&&... args);
   void erase(iterator pos);
   void swap(map& other);
+  // Слияние за O(min(n + m, m log n)): отсутствующие ключи переносятся
+  // из other (при равных аллокаторах - вместе с узлами), а у общих
+  // значение в this заменяется значением из other, и сами они остаются в
+  // other
   void merge(map& other);
+  // Перенос элементов с ключами из [lo, hi) в новый словарь, например
+  // всего, что старше отметки времени. Дерево режется и склеивается за
+  // O(log n) вместо удаления по одному; перенос k элементов стоит O(k)
+  map extract_range(const Key& lo, const Key& hi);
+  // Элемент вынимается из дерева вместе с узлом и переходит в другой
+  // словарь без выделения памяти и копирования (при первом extract узел
+  // один раз покидает пул). Ключ в node_type можно поменять до вставки
+  node_type extract(const_iterator pos) {
+    return tree_type::extractAt(pos.tree_iter);
+  }
+  node_type extract(const Key& key) { return tree_type::extractKey(key); }
+  insert_return_type insert(node_type&& node);
+  // Замена содержимого строго возрастающим по ключу диапазоном пар
+  template <typename ForwardIt>
+  void bulk_load(ForwardIt first, ForwardIt last, bool check_sorted = false);
   bool contains(const Key& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const {
+    return this->findNode(key) != nullptr;
+  }
+  // Порядковые статистики по ключам за O(log n)
+  size_type rank(const Key& key) const { return tree_type::rank(key); }
+  iterator select(size_type index) {
+    return iterator(tree_type::select(index));
+  }
+  size_type count_range(const Key& lo, const Key& hi) const {
+    return tree_type::count_range(lo, hi);
+  }
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  template <typename K, typename V, typename C, typename A>
+  friend map<K, V, C, A> set_union(const map<K, V, C, A>& a,
+                                   const map<K, V, C, A>& b);
+  template <typename K, typename V, typename C, typename A>
+  friend map<K, V, C, A> set_intersection(const map<K, V, C, A>& a,
+                                          const map<K, V, C, A>& b);
+  template <typename K, typename V, typename C, typename A>
+  friend map<K, V, C, A> set_difference(const map<K, V, C, A>& a,
+                                        const map<K, V, C, A>& b);
 };
+
+// Объединение, пересечение и разность по ключам за O(n + m); для ключа,
+// который есть в обоих словарях, значение берется из a
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator> set_union(
+    const map<Key, T, Compare, Allocator>& a,
+    const map<Key, T, Compare, Allocator>& b);
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator> set_intersection(
+    const map<Key, T, Compare, Allocator>& a,
+    const map<Key, T, Compare, Allocator>& b);
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator> set_difference(
+    const map<Key, T, Compare, Allocator>& a,
+    const map<Key, T, Compare, Allocator>& b);
 }  // namespace s21
 
 #include "s21_map.tpp"
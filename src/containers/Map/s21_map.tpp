@@ -4,122 +4,245 @@
 #include "s21_map.h"
 
 namespace s21 {
-template <typename Key, typename T>
-map<Key, T>::map(std::initializer_list<value_type> const& items)
-    : RBTree<key_type, mapped_type>() {
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator>::map(
+    std::initializer_list<value_type> const& items, const Allocator& alloc)
+    : tree_type(alloc) {
   for (const auto& item : items) {
     this->insert(item.first, item.second);
   }
 }
 
-template <typename Key, typename T>
-map<Key, T>& map<Key, T>::operator=(map&& m) noexcept {
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator>&
+map<Key, T, Compare, Allocator>::operator=(map&& m) noexcept(
+    std::is_nothrow_move_assignable<tree_type>::value) {
   if (this != &m) {
-    RBTree<key_type, mapped_type>::operator=(std::move(m));
+    tree_type::operator=(std::move(m));
   }
   return *this;
 }
 
-template <typename Key, typename T>
-T& map<Key, T>::at(const Key& key) {
-  return RBTree<key_type, mapped_type>::at(key);
+template <typename Key, typename T, typename Compare, typename Allocator>
+T& map<Key, T, Compare, Allocator>::at(const Key& key) {
+  return tree_type::at(key);
 }
 
-template <typename Key, typename T>
-const T& map<Key, T>::at(const Key& key) const {
-  return RBTree<key_type, mapped_type>::at(key);
+template <typename Key, typename T, typename Compare, typename Allocator>
+const T& map<Key, T, Compare, Allocator>::at(const Key& key) const {
+  return tree_type::at(key);
 }
 
-template <typename Key, typename T>
-T& map<Key, T>::operator[](const Key& key) {
-  return RBTree<key_type, mapped_type>::getOrInsert(key);
+template <typename Key, typename T, typename Compare, typename Allocator>
+T& map<Key, T, Compare, Allocator>::operator[](const Key& key) {
+  return tree_type::getOrInsert(key);
 }
 
 // Вставка по значению
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert(
-    const value_type& value) {
-  auto [node, inserted] = RBTree<Key, T>::insert(value.first, value.second);
-  return {iterator(node, this), inserted};
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert(const value_type& value) {
+  auto [node, inserted] = tree_type::insert(value.first, value.second);
+  return {iterator(typename tree_type::iterator(this, node)),
+          inserted};
 }
 
 // Вставка по ключу и значению
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert(
-    const Key& key, const T& obj) {
-  auto [node, inserted] = RBTree<key_type, mapped_type>::insert(key, obj);
-  return {iterator(node, this), inserted};
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert(const Key& key, const T& obj) {
+  auto [node, inserted] = tree_type::insert(key, obj);
+  return {iterator(typename tree_type::iterator(this, node)),
+          inserted};
 }
 
 // Вставка или изменение существующего значения
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert_or_assign(
-    const Key& key, const T& obj) {
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert_or_assign(const Key& key,
+                                                  const T& obj) {
   auto node = this->findNode(key);
   if (node) {
-    node->value = obj;
-    return {iterator(node, this), false};
+    node->value() = obj;
+    return {iterator(typename tree_type::iterator(this, node)),
+            false};
   } else {
     return insert(key, obj);
   }
 }
 
+// Вставка с построением значения на месте
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::try_emplace(const Key& key, Args&&... args) {
+  auto [node, inserted] =
+      tree_type::tryEmplace(key, std::forward<Args>(args)...);
+  return {iterator(typename tree_type::iterator(this, node)),
+          inserted};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::try_emplace(Key&& key, Args&&... args) {
+  auto [node, inserted] =
+      tree_type::tryEmplace(s21::move(key), std::forward<Args>(args)...);
+  return {iterator(typename tree_type::iterator(this, node)),
+          inserted};
+}
+
+// Пара собирается на стеке: для проверки нужен ключ, а узел выделяется
+// только при вставке
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::emplace(Args&&... args) {
+  std::pair<Key, T> value(std::forward<Args>(args)...);
+  return try_emplace(s21::move(value.first), s21::move(value.second));
+}
+
+// Вставка с подсказкой
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::insert(iterator hint,
+                                        const value_type& value) {
+  auto node =
+      tree_type::tryEmplaceHint(hint.tree_iter, value.first, value.second)
+          .first;
+  return iterator(typename tree_type::iterator(this, node));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::emplace_hint(iterator hint, Args&&... args) {
+  std::pair<Key, T> value(std::forward<Args>(args)...);
+  auto node = tree_type::tryEmplaceHint(hint.tree_iter, s21::move(value.first),
+                                        s21::move(value.second))
+                  .first;
+  return iterator(typename tree_type::iterator(this, node));
+}
+
+// Построение из отсортированного диапазона
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename ForwardIt>
+map<Key, T, Compare, Allocator>
+map<Key, T, Compare, Allocator>::from_sorted(ForwardIt first, ForwardIt last,
+                                             bool check_sorted,
+                                             const Allocator& alloc) {
+  map result(alloc);
+  result.bulk_load(first, last, check_sorted);
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename ForwardIt>
+void map<Key, T, Compare, Allocator>::bulk_load(ForwardIt first,
+                                                ForwardIt last,
+                                                bool check_sorted) {
+  tree_type::bulkLoad(
+      first, last, [](const auto& item) -> const auto& { return item; },
+      true, check_sorted);
+}
+
 // Удаление элемента
-template <typename Key, typename T>
-void map<Key, T>::erase(iterator pos) {
-  if (pos != end()) {
-    Key key_to_erase = (*pos).first;
-    RBTree<Key, T>::erase(key_to_erase);
-  }
+template <typename Key, typename T, typename Compare, typename Allocator>
+void map<Key, T, Compare, Allocator>::erase(iterator pos) {
+  tree_type::eraseAt(pos.tree_iter);
 }
 
 // Обмен объектов
-template <typename Key, typename T>
-void map<Key, T>::swap(map& other) {
-  std::swap(this->root, other.root);
-  std::swap(this->node_count, other.node_count);
-}
-
-// Слияение объектов
-template <typename Key, typename T>
-void map<Key, T>::merge(map& other) {
-  for (auto it = other.begin(); it != other.end();) {
-    auto key = it->first;
-    auto value = it->second;
-    auto [inserted_it, inserted] = this->insert_or_assign(key, value);
-    ++it;
-    if (inserted) {
-      other.erase(other.find(key));
-    }
-  }
+template <typename Key, typename T, typename Compare, typename Allocator>
+void map<Key, T, Compare, Allocator>::swap(map& other) {
+  tree_type::swap(other);
+}
+
+// Общие ключи получают значение из other и остаются в нем
+template <typename Key, typename T, typename Compare, typename Allocator>
+void map<Key, T, Compare, Allocator>::merge(map& other) {
+  tree_type::mergeFrom(other, true, [](auto* mine, auto* theirs) {
+    mine->value() = theirs->value();
+    return true;
+  });
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::insert_return_type
+map<Key, T, Compare, Allocator>::insert(node_type&& node) {
+  auto [found, inserted] = tree_type::insertHandle(node, true);
+  return {iterator(typename tree_type::iterator(this, found)), inserted,
+          std::move(node)};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator> map<Key, T, Compare, Allocator>::extract_range(
+    const Key& lo, const Key& hi) {
+  map result(this->key_comp(), this->get_allocator());
+  tree_type::extractRange(result, lo, hi);
+  return result;
 }
 
 // Проверка на существование объекта
-template <typename Key, typename T>
-bool map<Key, T>::contains(const Key& key) const {
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool map<Key, T, Compare, Allocator>::contains(const Key& key) const {
   return this->findNode(key) != nullptr;
 }
 
 // Поиск узла по ключу
-template <typename Key, typename T>
-typename map<Key, T>::iterator map<Key, T>::find(const key_type& key) {
-  auto node = this->findNode(key);
-  if (node) {
-    return iterator(typename RBTree<Key, T>::iterator(this->root, node), this);
-  } else {
-    return end();
-  }
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::find(const key_type& key) {
+  return iterator(
+      typename tree_type::iterator(this, this->findNode(key)));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::const_iterator
+map<Key, T, Compare, Allocator>::find(const key_type& key) const {
+  return const_iterator(
+      typename tree_type::const_iterator(this, this->findNode(key)));
 }
 
 // Множественная вставка
-template <typename Key, typename T>
+template <typename Key, typename T, typename Compare, typename Allocator>
 template <typename... Args>
-std::vector<std::pair<typename map<Key, T>::iterator, bool>>
-map<Key, T>::insert_many(Args&&... args) {
+std::vector<std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>>
+map<Key, T, Compare, Allocator>::insert_many(Args&&... args) {
   std::vector<std::pair<iterator, bool>> results;
   (..., results.push_back(this->insert(std::forward<Args>(args))));
   return results;
 }
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator> set_union(
+    const map<Key, T, Compare, Allocator>& a,
+    const map<Key, T, Compare, Allocator>& b) {
+  map<Key, T, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assignSetOperation(
+      a, b, map<Key, T, Compare, Allocator>::SetOperation::unite);
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator> set_intersection(
+    const map<Key, T, Compare, Allocator>& a,
+    const map<Key, T, Compare, Allocator>& b) {
+  map<Key, T, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assignSetOperation(
+      a, b, map<Key, T, Compare, Allocator>::SetOperation::intersect);
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator> set_difference(
+    const map<Key, T, Compare, Allocator>& a,
+    const map<Key, T, Compare, Allocator>& b) {
+  map<Key, T, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assignSetOperation(
+      a, b, map<Key, T, Compare, Allocator>::SetOperation::subtract);
+  return result;
+}
 }  // namespace s21
 
 #endif
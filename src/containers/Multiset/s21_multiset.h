@@ -2,64 +2,194 @@
 #define S21_MULTISET_H
 
 #include <initializer_list>
+#include <limits>
 #include <vector>
 
 #include "../Tree/s21_tree.h"
 
 namespace s21 {
-template <typename Key>
-class multiset : public RBTree<Key, Key> {
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class multiset : public RBTree<Key, tree_key_only, Compare, Allocator> {
+  using tree_type = RBTree<Key, tree_key_only, Compare, Allocator>;
+
  public:
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = typename RBTree<Key, Key>::iterator;
-  using const_iterator = typename RBTree<Key, Key>::const_iterator;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
   using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  // Вынутый из множества элемент; см. RBTree::NodeHandle
+  using node_type = typename tree_type::NodeHandle;
 
   // Конструкторы и деструктор
   multiset();
-  multiset(std::initializer_list<value_type> const& items);
+  explicit multiset(const Allocator& alloc);
+  explicit multiset(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
+  multiset(std::initializer_list<value_type> const& items,
+           const Allocator& alloc = Allocator());
   multiset(const multiset& ms);
   multiset(multiset&& ms) noexcept;
   ~multiset() = default;
+  // Построение из отсортированного диапазона за O(n) без балансировок.
+  // С check_sorted вход проверяется заранее, и при нарушении порядка
+  // бросается std::invalid_argument; без проверки порядок - предусловие
+  template <typename ForwardIt>
+  static multiset from_sorted(ForwardIt first, ForwardIt last,
+                              bool check_sorted = false,
+                              const Allocator& alloc = Allocator());
 
   // Перегрузки операторов
   multiset& operator=(const multiset& ms);
-  multiset& operator=(multiset&& ms) noexcept;
+  multiset& operator=(multiset&& ms) noexcept(
+      std::is_nothrow_move_assignable<tree_type>::value);
 
   // Методы класса
-  bool empty() const { return RBTree<Key, Key>::size() == 0; }
-  size_type size() const { return RBTree<Key, Key>::size(); }
+  bool empty() const { return tree_type::size() == 0; }
+  size_type size() const { return tree_type::size(); }
   size_type max_size() const { return std::numeric_limits<size_type>::max(); }
   void clear();
   iterator insert(const value_type& value);
+  template <typename... Args>
+  iterator emplace(Args&&... args);
+  // Вставка с подсказкой: амортизированное O(1), если значение встает
+  // рядом с hint
+  iterator insert(iterator hint, const value_type& value);
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args&&... args);
   void erase(iterator pos);
   void swap(multiset& other);
+  // Слияние за O(min(n + m, m log n)): все элементы other переносятся,
+  // равные ключи из other встают после своих, и other становится пустым
+  void merge(multiset& other);
+  // extract(key) вынимает первый из равных элементов; insert(node_type&&)
+  // ставит узел после равных и для пустого node возвращает end()
+  node_type extract(const_iterator pos) { return tree_type::extractAt(pos); }
+  node_type extract(const Key& key) { return tree_type::extractKey(key); }
+  iterator insert(node_type&& node);
+  // Замена содержимого неубывающим диапазоном
+  template <typename ForwardIt>
+  void bulk_load(ForwardIt first, ForwardIt last, bool check_sorted = false);
   iterator find(const key_type& key);
   const_iterator find(const key_type& key) const;
-  size_type count(const Key& key) const { return RBTree<Key, Key>::count(key); }
+  size_type count(const Key& key) const { return tree_type::count(key); }
   // Проверяет, содержится ли элемент с указанным ключом
-  bool contains(const Key& key) const {
-    return RBTree<Key, Key>::contains(key);
-  }
+  bool contains(const Key& key) const { return tree_type::contains(key); }
   // Возвращает диапазон элементов с данным ключом
   std::pair<iterator, iterator> equal_range(const Key& key) {
-    return RBTree<Key, Key>::equal_range(key);
+    return tree_type::equal_range(key);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const {
+    return tree_type::equal_range(key);
   }
   // Возвращает первый элемент, не меньший key
-  iterator lower_bound(const Key& key) {
-    return RBTree<Key, Key>::lower_bound(key);
+  iterator lower_bound(const Key& key) { return tree_type::lower_bound(key); }
+  const_iterator lower_bound(const Key& key) const {
+    return tree_type::lower_bound(key);
   }
   // Возвращает первый элемент, больший key
-  iterator upper_bound(const Key& key) {
-    return RBTree<Key, Key>::upper_bound(key);
+  iterator upper_bound(const Key& key) { return tree_type::upper_bound(key); }
+  const_iterator upper_bound(const Key& key) const {
+    return tree_type::upper_bound(key);
+  }
+  // Те же запросы по значению другого типа без построения Key; только
+  // для прозрачного Compare (например, std::less<>)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) {
+    return iterator(this, tree_type::findNode(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K& key) const {
+    return const_iterator(this, tree_type::findNode(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K& key) const {
+    return tree_type::count(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const {
+    return tree_type::contains(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    return tree_type::equal_range(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return tree_type::equal_range(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K& key) {
+    return tree_type::lower_bound(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator lower_bound(const K& key) const {
+    return tree_type::lower_bound(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K& key) {
+    return tree_type::upper_bound(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator upper_bound(const K& key) const {
+    return tree_type::upper_bound(key);
+  }
+  // Порядковые статистики за O(log n): число ключей меньше key, элемент
+  // с номером index и число ключей в [lo, hi)
+  size_type rank(const Key& key) const { return tree_type::rank(key); }
+  iterator select(size_type index) { return tree_type::select(index); }
+  const_iterator select(size_type index) const {
+    return tree_type::select(index);
+  }
+  size_type count_range(const Key& lo, const Key& hi) const {
+    return tree_type::count_range(lo, hi);
   }
   // Множественная вставка
   template <typename... Args>
   std::vector<iterator> insert_many(Args&&... args);
+
+  template <typename K, typename C, typename A>
+  friend multiset<K, C, A> set_union(const multiset<K, C, A>& a,
+                                     const multiset<K, C, A>& b);
+  template <typename K, typename C, typename A>
+  friend multiset<K, C, A> set_intersection(const multiset<K, C, A>& a,
+                                            const multiset<K, C, A>& b);
+  template <typename K, typename C, typename A>
+  friend multiset<K, C, A> set_difference(const multiset<K, C, A>& a,
+                                          const multiset<K, C, A>& b);
 };
+
+// Объединение, пересечение и разность за O(n + m). Ключ, который
+// встречается в a m раз и в b n раз, попадает в результат max(m, n),
+// min(m, n) и max(m - n, 0) раз, как у std::set_union и соседей
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator> set_union(
+    const multiset<Key, Compare, Allocator>& a,
+    const multiset<Key, Compare, Allocator>& b);
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator> set_intersection(
+    const multiset<Key, Compare, Allocator>& a,
+    const multiset<Key, Compare, Allocator>& b);
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator> set_difference(
+    const multiset<Key, Compare, Allocator>& a,
+    const multiset<Key, Compare, Allocator>& b);
 }  // namespace s21
 
 #include "s21_multiset.tpp"
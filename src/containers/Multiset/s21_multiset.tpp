@@ -4,87 +4,183 @@
 #include "s21_multiset.h"
 
 namespace s21 {
-template <typename Key>
-multiset<Key>::multiset() : RBTree<Key, Key>() {}
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>::multiset() : tree_type() {}
 
-template <typename Key>
-multiset<Key>::multiset(std::initializer_list<value_type> const& items)
-    : RBTree<Key, Key>() {
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>::multiset(const Allocator& alloc)
+    : tree_type(alloc) {}
+
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>::multiset(
+    std::initializer_list<value_type> const& items, const Allocator& alloc)
+    : tree_type(alloc) {
   for (const auto& item : items) {
     this->insert(item);
   }
 }
 
-template <typename Key>
-multiset<Key>::multiset(const multiset& ms) : RBTree<Key, Key>(ms) {}
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>::multiset(const multiset& ms)
+    : tree_type(ms) {}
 
-template <typename Key>
-multiset<Key>::multiset(multiset&& ms) noexcept
-    : RBTree<Key, Key>(s21::move(ms)) {}
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>::multiset(multiset&& ms) noexcept
+    : tree_type(s21::move(ms)) {}
 
-template <typename Key>
-multiset<Key>& multiset<Key>::operator=(const multiset& ms) {
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>&
+multiset<Key, Compare, Allocator>::operator=(const multiset& ms) {
   if (this != &ms) {
-    RBTree<Key, Key>::operator=(ms);
+    tree_type::operator=(ms);
   }
   return *this;
 }
 
-template <typename Key>
-multiset<Key>& multiset<Key>::operator=(multiset&& ms) noexcept {
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>&
+multiset<Key, Compare, Allocator>::operator=(multiset&& ms) noexcept(
+    std::is_nothrow_move_assignable<tree_type>::value) {
   if (this != &ms) {
-    RBTree<Key, Key>::operator=(s21::move(ms));
+    tree_type::operator=(s21::move(ms));
   }
   return *this;
 }
 
-template <typename Key>
-void multiset<Key>::clear() {
-  RBTree<Key, Key>::clear(RBTree<Key, Key>::root);
-  RBTree<Key, Key>::root = nullptr;
-  RBTree<Key, Key>::node_count = 0;
+template <typename Key, typename Compare, typename Allocator>
+void multiset<Key, Compare, Allocator>::clear() {
+  tree_type::clear();
 }
 
-template <typename Key>
-typename multiset<Key>::iterator multiset<Key>::insert(
-    const value_type& value) {
-  auto result = RBTree<Key, Key>::insertMulti(value, value);
-  return iterator(RBTree<Key, Key>::root, result.first);
+template <typename Key, typename Compare, typename Allocator>
+typename multiset<Key, Compare, Allocator>::iterator
+multiset<Key, Compare, Allocator>::insert(const value_type& value) {
+  return iterator(this, tree_type::emplaceMulti(value));
 }
 
-template <typename Key>
-void multiset<Key>::erase(iterator pos) {
-  if (pos != this->end()) {
-    RBTree<Key, Key>::erase(*pos);
-  }
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename multiset<Key, Compare, Allocator>::iterator
+multiset<Key, Compare, Allocator>::emplace(Args&&... args) {
+  value_type value(std::forward<Args>(args)...);
+  auto node = tree_type::emplaceMulti(s21::move(value));
+  return iterator(this, node);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename multiset<Key, Compare, Allocator>::iterator
+multiset<Key, Compare, Allocator>::insert(iterator hint,
+                                          const value_type& value) {
+  auto node = tree_type::emplaceMultiHint(hint, value);
+  return iterator(this, node);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename multiset<Key, Compare, Allocator>::iterator
+multiset<Key, Compare, Allocator>::emplace_hint(iterator hint, Args&&... args) {
+  value_type value(std::forward<Args>(args)...);
+  auto node = tree_type::emplaceMultiHint(hint, s21::move(value));
+  return iterator(this, node);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void multiset<Key, Compare, Allocator>::erase(iterator pos) {
+  tree_type::eraseAt(pos);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void multiset<Key, Compare, Allocator>::swap(multiset& other) {
+  tree_type::swap(other);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void multiset<Key, Compare, Allocator>::merge(multiset& other) {
+  if (this == &other) return;
+  tree_type::mergeFrom(other, false, [](auto*, auto*) { return false; });
+  other.clear();
 }
 
-template <typename Key>
-void multiset<Key>::swap(multiset& other) {
-  std::swap(RBTree<Key, Key>::root, other.root);
-  std::swap(RBTree<Key, Key>::node_count, other.node_count);
+template <typename Key, typename Compare, typename Allocator>
+typename multiset<Key, Compare, Allocator>::iterator
+multiset<Key, Compare, Allocator>::insert(node_type&& node) {
+  return iterator(this, tree_type::insertHandle(node, false).first);
 }
 
-template <typename Key>
-typename multiset<Key>::iterator multiset<Key>::find(const key_type& key) {
-  return iterator(RBTree<Key, Key>::root, RBTree<Key, Key>::findNode(key));
+template <typename Key, typename Compare, typename Allocator>
+typename multiset<Key, Compare, Allocator>::iterator
+multiset<Key, Compare, Allocator>::find(const key_type& key) {
+  return iterator(this, tree_type::findNode(key));
 }
 
-template <typename Key>
-typename multiset<Key>::const_iterator multiset<Key>::find(
-    const key_type& key) const {
-  return const_iterator(RBTree<Key, Key>::root,
-                        RBTree<Key, Key>::findNode(key));
+template <typename Key, typename Compare, typename Allocator>
+typename multiset<Key, Compare, Allocator>::const_iterator
+multiset<Key, Compare, Allocator>::find(const key_type& key) const {
+  return const_iterator(this, tree_type::findNode(key));
 }
 
-template <typename Key>
+template <typename Key, typename Compare, typename Allocator>
 template <typename... Args>
-std::vector<typename multiset<Key>::iterator> multiset<Key>::insert_many(
-    Args&&... args) {
+std::vector<typename multiset<Key, Compare, Allocator>::iterator>
+multiset<Key, Compare, Allocator>::insert_many(Args&&... args) {
   std::vector<iterator> result;
   (result.push_back(this->insert(std::forward<Args>(args))), ...);
   return result;
 }
+
+// Построение из отсортированного диапазона
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt>
+multiset<Key, Compare, Allocator>
+multiset<Key, Compare, Allocator>::from_sorted(ForwardIt first,
+                                               ForwardIt last,
+                                               bool check_sorted,
+                                               const Allocator& alloc) {
+  multiset result(alloc);
+  result.bulk_load(first, last, check_sorted);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt>
+void multiset<Key, Compare, Allocator>::bulk_load(ForwardIt first,
+                                                  ForwardIt last,
+                                                  bool check_sorted) {
+  tree_type::bulkLoad(
+      first, last,
+      [](const Key& key) -> const Key& { return key; },
+      false, check_sorted);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator> set_union(
+    const multiset<Key, Compare, Allocator>& a,
+    const multiset<Key, Compare, Allocator>& b) {
+  multiset<Key, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assignSetOperation(
+      a, b, multiset<Key, Compare, Allocator>::SetOperation::unite);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator> set_intersection(
+    const multiset<Key, Compare, Allocator>& a,
+    const multiset<Key, Compare, Allocator>& b) {
+  multiset<Key, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assignSetOperation(
+      a, b, multiset<Key, Compare, Allocator>::SetOperation::intersect);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator> set_difference(
+    const multiset<Key, Compare, Allocator>& a,
+    const multiset<Key, Compare, Allocator>& b) {
+  multiset<Key, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assignSetOperation(
+      a, b, multiset<Key, Compare, Allocator>::SetOperation::subtract);
+  return result;
+}
 }  // namespace s21
 
 #endif  // S21_MULTISET_TPP
@@ -8,45 +8,143 @@
 #include "../Tree/s21_tree.h"
 
 namespace s21 {
-template <typename Key>
-class set : public RBTree<Key, Key> {
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class set : public RBTree<Key, tree_key_only, Compare, Allocator> {
+  using tree_type = RBTree<Key, tree_key_only, Compare, Allocator>;
+
  public:
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = typename RBTree<Key, Key>::iterator;
-  using const_iterator = typename RBTree<Key, Key>::const_iterator;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
   using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  // Вынутый из множества элемент; см. RBTree::NodeHandle
+  using node_type = typename tree_type::NodeHandle;
+  // Результат insert(node_type&&): если ключ уже был, узел остается в node,
+  // а position указывает на найденный элемент
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
 
   // Конструкторы и деструктор
   set();
-  set(std::initializer_list<value_type> const& items);
+  explicit set(const Allocator& alloc);
+  explicit set(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
+  set(std::initializer_list<value_type> const& items,
+      const Allocator& alloc = Allocator());
   set(const set& s);
   set(set&& s) noexcept;
   ~set() = default;
+  // Построение из отсортированного диапазона за O(n) без балансировок.
+  // С check_sorted вход проверяется заранее, и при нарушении порядка
+  // бросается std::invalid_argument; без проверки порядок - предусловие
+  template <typename ForwardIt>
+  static set from_sorted(ForwardIt first, ForwardIt last,
+                         bool check_sorted = false,
+                         const Allocator& alloc = Allocator());
 
   // Перегрузки операторов
-  set& operator=(set&& s) noexcept;
+  set& operator=(set&& s) noexcept(
+      std::is_nothrow_move_assignable<tree_type>::value);
   set& operator=(const set& s);
 
   // Методы класса
-  bool empty() const { return RBTree<Key, Key>::size() == 0; }
-  size_type size() const { return RBTree<Key, Key>::size(); }
+  bool empty() const { return tree_type::size() == 0; }
+  size_type size() const { return tree_type::size(); }
   size_type max_size() const { return std::numeric_limits<size_type>::max(); }
   void clear();
   std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  // Ключ строится из args на стеке; узел выделяется только при вставке
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  // Вставка с подсказкой: амортизированное O(1), если значение встает
+  // рядом с hint
+  iterator insert(iterator hint, const value_type& value);
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args&&... args);
   void erase(iterator pos);
   void swap(set& other);
+  // Замена содержимого строго возрастающим диапазоном
+  template <typename ForwardIt>
+  void bulk_load(ForwardIt first, ForwardIt last, bool check_sorted = false);
+  // Слияние за O(min(n + m, m log n)): ключи из other переносятся,
+  // повторяющиеся отбрасываются, и other становится пустым
   void merge(set& other);
+  // Перенос ключей из [lo, hi) в новое множество. Само дерево режется и
+  // склеивается за O(log n), так что после удаления диапазона
+  // балансировать нечего; перенос k ключей стоит O(k)
+  set extract_range(const Key& lo, const Key& hi);
+  // Узел вынимается из дерева и переходит в другое множество без выделения
+  // памяти и копирования (при первом extract узел один раз покидает пул)
+  node_type extract(const_iterator pos) { return tree_type::extractAt(pos); }
+  node_type extract(const Key& key) { return tree_type::extractKey(key); }
+  insert_return_type insert(node_type&& node);
   iterator find(const key_type& key);
   const_iterator find(const key_type& key) const;
-  bool contains(const key_type& key) const {
-    return RBTree<Key, Key>::contains(key);
+  bool contains(const key_type& key) const { return tree_type::contains(key); }
+  // Поиск по значению другого типа без построения Key; только для
+  // прозрачного Compare (например, std::less<>)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) {
+    return iterator(this, tree_type::findNode(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K& key) const {
+    return const_iterator(this, tree_type::findNode(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const {
+    return tree_type::contains(key);
+  }
+  // Порядковые статистики за O(log n): число ключей меньше key, элемент
+  // с номером index и число ключей в [lo, hi)
+  size_type rank(const Key& key) const { return tree_type::rank(key); }
+  iterator select(size_type index) { return tree_type::select(index); }
+  const_iterator select(size_type index) const {
+    return tree_type::select(index);
+  }
+  size_type count_range(const Key& lo, const Key& hi) const {
+    return tree_type::count_range(lo, hi);
   }
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  template <typename K, typename C, typename A>
+  friend set<K, C, A> set_union(const set<K, C, A>& a,
+                                const set<K, C, A>& b);
+  template <typename K, typename C, typename A>
+  friend set<K, C, A> set_intersection(const set<K, C, A>& a,
+                                       const set<K, C, A>& b);
+  template <typename K, typename C, typename A>
+  friend set<K, C, A> set_difference(const set<K, C, A>& a,
+                                     const set<K, C, A>& b);
 };
+
+// Объединение, пересечение и разность двух множеств за O(n + m) одним
+// проходом по обоим; порядок и аллокатор берутся у a
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator> set_union(const set<Key, Compare, Allocator>& a,
+                                       const set<Key, Compare, Allocator>& b);
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator> set_intersection(
+    const set<Key, Compare, Allocator>& a,
+    const set<Key, Compare, Allocator>& b);
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator> set_difference(
+    const set<Key, Compare, Allocator>& a,
+    const set<Key, Compare, Allocator>& b);
 }  // namespace s21
 
 #include "s21_set.tpp"
@@ -5,104 +5,203 @@
 
 namespace s21 {
 // Конструкторы
-template <typename Key>
-set<Key>::set() : RBTree<Key, Key>() {}
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>::set() : tree_type() {}
 
-template <typename Key>
-set<Key>::set(std::initializer_list<value_type> const& items)
-    : RBTree<Key, Key>() {
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>::set(const Allocator& alloc) : tree_type(alloc) {}
+
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>::set(
+    std::initializer_list<value_type> const& items, const Allocator& alloc)
+    : tree_type(alloc) {
   for (const auto& item : items) {
     this->insert(item);
   }
 }
 
-template <typename Key>
-set<Key>::set(const set& s) : RBTree<Key, Key>(s) {}
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>::set(const set& s) : tree_type(s) {}
 
-template <typename Key>
-set<Key>::set(set&& s) noexcept : RBTree<Key, Key>(s21::move(s)) {}
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>::set(set&& s) noexcept : tree_type(s21::move(s)) {}
 
 // Перегрузки оператора присвоения
-template <typename Key>
-set<Key>& set<Key>::operator=(set&& s) noexcept {
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>&
+set<Key, Compare, Allocator>::operator=(set&& s) noexcept(
+    std::is_nothrow_move_assignable<tree_type>::value) {
   if (this != &s) {
-    RBTree<Key, Key>::operator=(s21::move(s));
+    tree_type::operator=(s21::move(s));
   }
   return *this;
 }
 
-template <typename Key>
-set<Key>& set<Key>::operator=(const set& s) {
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>&
+set<Key, Compare, Allocator>::operator=(const set& s) {
   if (this != &s) {
-    RBTree<Key, Key>::operator=(s);
+    tree_type::operator=(s);
   }
   return *this;
 }
 
 // Очистка памяти при удалении ключа
-template <typename Key>
-void set<Key>::clear() {
-  RBTree<Key, Key>::clear(RBTree<Key, Key>::root);
-  RBTree<Key, Key>::root = nullptr;
-  RBTree<Key, Key>::node_count = 0;
+template <typename Key, typename Compare, typename Allocator>
+void set<Key, Compare, Allocator>::clear() {
+  tree_type::clear();
 }
 
 // Вставка нового элемента
-template <typename Key>
-std::pair<typename set<Key>::iterator, bool> set<Key>::insert(
-    const value_type& value) {
-  auto result = RBTree<Key, Key>::insert(value, value);
-  return std::make_pair(iterator(RBTree<Key, Key>::root, result.first),
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename set<Key, Compare, Allocator>::iterator, bool>
+set<Key, Compare, Allocator>::insert(const value_type& value) {
+  auto result = tree_type::tryEmplace(value);
+  return std::make_pair(iterator(this, result.first),
+                        result.second);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename set<Key, Compare, Allocator>::iterator, bool>
+set<Key, Compare, Allocator>::insert(value_type&& value) {
+  auto result = tree_type::tryEmplace(s21::move(value));
+  return std::make_pair(iterator(this, result.first),
                         result.second);
 }
 
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename set<Key, Compare, Allocator>::iterator, bool>
+set<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+// Вставка с подсказкой
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::insert(iterator hint, const value_type& value) {
+  auto node = tree_type::tryEmplaceHint(hint, value).first;
+  return iterator(this, node);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::emplace_hint(iterator hint, Args&&... args) {
+  value_type value(std::forward<Args>(args)...);
+  auto node = tree_type::tryEmplaceHint(hint, s21::move(value)).first;
+  return iterator(this, node);
+}
+
 // Удаление ключа по итератору
-template <typename Key>
-void set<Key>::erase(iterator pos) {
-  if (pos != this->end()) {
-    RBTree<Key, Key>::erase(*pos);
-  }
+template <typename Key, typename Compare, typename Allocator>
+void set<Key, Compare, Allocator>::erase(iterator pos) {
+  tree_type::eraseAt(pos);
 }
 
 // Обмен содержимым между узлами
-template <typename Key>
-void set<Key>::swap(set& other) {
-  std::swap(RBTree<Key, Key>::root, other.root);
-  std::swap(RBTree<Key, Key>::node_count, other.node_count);
+template <typename Key, typename Compare, typename Allocator>
+void set<Key, Compare, Allocator>::swap(set& other) {
+  tree_type::swap(other);
 }
 
-// Слияние узлов
-template <typename Key>
-void set<Key>::merge(set& other) {
-  for (auto it = other.begin(); it != other.end(); ++it) {
-    this->insert(*it);
-  }
+// Повторяющиеся ключи удаляются вместе с узлами; other остается пустым
+template <typename Key, typename Compare, typename Allocator>
+void set<Key, Compare, Allocator>::merge(set& other) {
+  if (this == &other) return;
+  tree_type::mergeFrom(other, true, [](auto*, auto*) { return false; });
   other.clear();
 }
 
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator> set<Key, Compare, Allocator>::extract_range(
+    const Key& lo, const Key& hi) {
+  set result(this->key_comp(), this->get_allocator());
+  tree_type::extractRange(result, lo, hi);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::insert_return_type
+set<Key, Compare, Allocator>::insert(node_type&& node) {
+  auto [found, inserted] = tree_type::insertHandle(node, true);
+  return {iterator(this, found), inserted, std::move(node)};
+}
+
 // Поиск узла по ключу
-template <typename Key>
-typename set<Key>::iterator set<Key>::find(const key_type& key) {
-  return iterator(RBTree<Key, Key>::root, RBTree<Key, Key>::findNode(key));
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::find(const key_type& key) {
+  return iterator(this, tree_type::findNode(key));
 }
 
-template <typename Key>
-typename set<Key>::const_iterator set<Key>::find(const key_type& key) const {
-  return const_iterator(RBTree<Key, Key>::root,
-                        RBTree<Key, Key>::findNode(key));
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::const_iterator
+set<Key, Compare, Allocator>::find(const key_type& key) const {
+  return const_iterator(this, tree_type::findNode(key));
 }
 
 // Вставка множества элементов
-template <typename Key>
+template <typename Key, typename Compare, typename Allocator>
 template <typename... Args>  // Параметрическая упаковка. Args — список типов
                              // аргументов
-std::vector<std::pair<typename set<Key>::iterator, bool>> set<Key>::insert_many(
-    Args&&... args) {
+std::vector<std::pair<typename set<Key, Compare, Allocator>::iterator, bool>>
+set<Key, Compare, Allocator>::insert_many(Args&&... args) {
   std::vector<std::pair<iterator, bool>> result;
   (result.push_back(this->insert(std::forward<Args>(args))),
    ...);  // Fold expression (свёртка выражений)
   return result;
 }
+
+// Построение из отсортированного диапазона
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt>
+set<Key, Compare, Allocator> set<Key, Compare, Allocator>::from_sorted(
+    ForwardIt first, ForwardIt last, bool check_sorted,
+    const Allocator& alloc) {
+  set result(alloc);
+  result.bulk_load(first, last, check_sorted);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt>
+void set<Key, Compare, Allocator>::bulk_load(ForwardIt first, ForwardIt last,
+                                             bool check_sorted) {
+  tree_type::bulkLoad(
+      first, last,
+      [](const Key& key) -> const Key& { return key; },
+      true, check_sorted);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator> set_union(const set<Key, Compare, Allocator>& a,
+                                       const set<Key, Compare, Allocator>& b) {
+  set<Key, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assignSetOperation(
+      a, b, set<Key, Compare, Allocator>::SetOperation::unite);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator> set_intersection(
+    const set<Key, Compare, Allocator>& a,
+    const set<Key, Compare, Allocator>& b) {
+  set<Key, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assignSetOperation(
+      a, b, set<Key, Compare, Allocator>::SetOperation::intersect);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator> set_difference(
+    const set<Key, Compare, Allocator>& a,
+    const set<Key, Compare, Allocator>& b) {
+  set<Key, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assignSetOperation(
+      a, b, set<Key, Compare, Allocator>::SetOperation::subtract);
+  return result;
+}
 }  // namespace s21
 
 #endif  // S21_SET_TPP
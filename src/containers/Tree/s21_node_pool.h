@@ -0,0 +1,199 @@
+#ifndef S21_NODE_POOL_H
+#define S21_NODE_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace s21 {
+
+constexpr size_t cache_line_size = 64;
+
+// Per-container slab of fixed-size node slots. Chunks come from the
+// container's allocator, start on a cache line and double in size up to
+// max_chunk_slots. Freed slots go on an intrusive free list and are handed
+// out again before any fresh slot; chunks go back only through release().
+// reserve() may add a single larger chunk to fit a whole batch, and
+// adopt() takes over another pool's chunks together with the nodes in them.
+//
+// The pool does not keep an allocator: the owning container passes its own
+// to allocate() and release() and must call release() before it dies.
+template <typename Node, typename Allocator>
+class node_pool {
+  struct alignas(cache_line_size) line {
+    unsigned char bytes[cache_line_size];
+  };
+  union slot {
+    slot *next;
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+  // Lives in the first cache line of every chunk.
+  struct chunk_header {
+    line *next;
+    size_t lines;
+  };
+
+  using line_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<line>;
+  using line_traits = std::allocator_traits<line_allocator>;
+
+  static_assert(alignof(Node) <= cache_line_size,
+                "node_pool cannot align nodes past a cache line");
+
+ public:
+  static constexpr size_t first_chunk_slots = 8;
+  static constexpr size_t max_chunk_slots = 1024;
+
+  node_pool() noexcept = default;
+  node_pool(node_pool &&other) noexcept { swap(other); }
+  node_pool(const node_pool &) = delete;
+  node_pool &operator=(const node_pool &) = delete;
+  node_pool &operator=(node_pool &&) = delete;
+
+  Node *allocate(const Allocator &alloc);
+  void deallocate(Node *node) noexcept;
+  // Makes sure the next count allocations do not call alloc, so a batch of
+  // nodes can be built after a single point of failure.
+  void reserve(size_t count, const Allocator &alloc);
+  // Returns every chunk to alloc. All nodes must already be destroyed.
+  void release(const Allocator &alloc) noexcept;
+  // Takes over every chunk of other, so the nodes built there now belong
+  // to this pool; other is left empty. Both pools must draw from equal
+  // allocators. Costs one step per chunk and per free slot of other.
+  void adopt(node_pool &other) noexcept;
+  void swap(node_pool &other) noexcept;
+
+  // Slots served from the free list and fresh slots carved from a chunk.
+  size_t hits() const noexcept { return hits_; }
+  size_t misses() const noexcept { return misses_; }
+  size_t chunks() const noexcept { return chunk_count_; }
+
+ private:
+  void add_chunk(const Allocator &alloc, size_t slots);
+
+  slot *free_ = nullptr;
+  slot *cursor_ = nullptr;
+  slot *end_ = nullptr;
+  line *chunks_ = nullptr;
+  size_t chunk_count_ = 0;
+  size_t next_slots_ = first_chunk_slots;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+};
+
+template <typename Node, typename Allocator>
+inline Node *node_pool<Node, Allocator>::allocate(const Allocator &alloc) {
+  slot *result;
+  if (free_) {
+    result = free_;
+    free_ = free_->next;
+    ++hits_;
+  } else {
+    if (cursor_ == end_) add_chunk(alloc, next_slots_);
+    result = cursor_++;
+    ++misses_;
+  }
+  return reinterpret_cast<Node *>(result->storage);
+}
+
+template <typename Node, typename Allocator>
+inline void node_pool<Node, Allocator>::deallocate(Node *node) noexcept {
+  slot *freed = reinterpret_cast<slot *>(node);
+  freed->next = free_;
+  free_ = freed;
+}
+
+template <typename Node, typename Allocator>
+inline void node_pool<Node, Allocator>::reserve(size_t count,
+                                                const Allocator &alloc) {
+  size_t available = static_cast<size_t>(end_ - cursor_);
+  if (available < count) {
+    add_chunk(alloc, std::max(count - available, next_slots_));
+  }
+}
+
+template <typename Node, typename Allocator>
+inline void node_pool<Node, Allocator>::release(
+    const Allocator &alloc) noexcept {
+  line_allocator lines(alloc);
+  while (chunks_) {
+    chunk_header *header = reinterpret_cast<chunk_header *>(chunks_);
+    line *next = header->next;
+    line_traits::deallocate(lines, chunks_, header->lines);
+    chunks_ = next;
+  }
+  free_ = cursor_ = end_ = nullptr;
+  chunk_count_ = 0;
+  next_slots_ = first_chunk_slots;
+}
+
+template <typename Node, typename Allocator>
+inline void node_pool<Node, Allocator>::adopt(node_pool &other) noexcept {
+  if (other.chunks_ == nullptr) return;
+  // The larger run of fresh slots stays fresh, the other one is freed.
+  if (end_ - cursor_ < other.end_ - other.cursor_) {
+    std::swap(cursor_, other.cursor_);
+    std::swap(end_, other.end_);
+  }
+  while (other.cursor_ != other.end_) {
+    slot *spare = other.cursor_++;
+    spare->next = other.free_;
+    other.free_ = spare;
+  }
+  if (other.free_) {
+    slot *tail = other.free_;
+    while (tail->next) tail = tail->next;
+    tail->next = free_;
+    free_ = other.free_;
+  }
+  line *last = other.chunks_;
+  while (line *next = reinterpret_cast<chunk_header *>(last)->next) {
+    last = next;
+  }
+  reinterpret_cast<chunk_header *>(last)->next = chunks_;
+  chunks_ = other.chunks_;
+  chunk_count_ += other.chunk_count_;
+  other.free_ = other.cursor_ = other.end_ = nullptr;
+  other.chunks_ = nullptr;
+  other.chunk_count_ = 0;
+  other.next_slots_ = first_chunk_slots;
+}
+
+template <typename Node, typename Allocator>
+inline void node_pool<Node, Allocator>::swap(node_pool &other) noexcept {
+  std::swap(free_, other.free_);
+  std::swap(cursor_, other.cursor_);
+  std::swap(end_, other.end_);
+  std::swap(chunks_, other.chunks_);
+  std::swap(chunk_count_, other.chunk_count_);
+  std::swap(next_slots_, other.next_slots_);
+  std::swap(hits_, other.hits_);
+  std::swap(misses_, other.misses_);
+}
+
+template <typename Node, typename Allocator>
+inline void node_pool<Node, Allocator>::add_chunk(const Allocator &alloc,
+                                                  size_t slots) {
+  size_t lines_needed =
+      1 + (slots * sizeof(slot) + cache_line_size - 1) / cache_line_size;
+  line_allocator lines(alloc);
+  line *chunk = line_traits::allocate(lines, lines_needed);
+  ::new (static_cast<void *>(chunk)) chunk_header{chunks_, lines_needed};
+  // Slots left in the previous chunk stay usable through the free list.
+  while (cursor_ != end_) {
+    slot *spare = cursor_++;
+    spare->next = free_;
+    free_ = spare;
+  }
+  chunks_ = chunk;
+  ++chunk_count_;
+  cursor_ = reinterpret_cast<slot *>(chunk + 1);
+  // Use whatever the rounding up to whole lines left over as well.
+  end_ = cursor_ + (lines_needed - 1) * cache_line_size / sizeof(slot);
+  if (next_slots_ < max_chunk_slots) next_slots_ *= 2;
+}
+
+}  // namespace s21
+
+#endif
@@ -1,63 +1,333 @@
 #ifndef S21_TREE_H
 #define S21_TREE_H
 
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>  // std::pair
 
-template <typename Key, typename Value>
+#include "s21_node_pool.h"
+
+namespace s21 {
+
+// Компаратор считается трехсторонним, если объявляет is_three_way: тогда
+// comp(a, b) возвращает число меньше, равное или больше нуля, и на каждом
+// узле при спуске хватает одного вызова
+template <typename Compare, typename = void>
+struct is_three_way_compare : std::false_type {};
+template <typename Compare>
+struct is_three_way_compare<Compare,
+                            std::void_t<typename Compare::is_three_way>>
+    : std::true_type {};
+
+// Прозрачный компаратор позволяет искать по ключам другого типа
+template <typename Compare, typename = void>
+struct is_transparent_compare : std::false_type {};
+template <typename Compare>
+struct is_transparent_compare<Compare,
+                              std::void_t<typename Compare::is_transparent>>
+    : std::true_type {};
+
+// Трехстороннее сравнение: через a.compare(b), если он есть (строки),
+// иначе через два operator<
+struct three_way_compare {
+  using is_three_way = void;
+  using is_transparent = void;
+
+  template <typename A, typename B>
+  int operator()(const A& a, const B& b) const {
+    if constexpr (has_compare<A, B>::value) {
+      int result = a.compare(b);
+      return result < 0 ? -1 : (result > 0 ? 1 : 0);
+    } else {
+      return a < b ? -1 : (b < a ? 1 : 0);
+    }
+  }
+
+ private:
+  template <typename A, typename B, typename = void>
+  struct has_compare : std::false_type {};
+  template <typename A, typename B>
+  struct has_compare<A, B,
+                     std::void_t<decltype(std::declval<const A&>().compare(
+                         std::declval<const B&>()))>> : std::true_type {};
+};
+
+// Значение для деревьев set и multiset: узел хранит только ключ
+struct tree_key_only {};
+
+}  // namespace s21
+
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
 class RBTree {
  private:
-  enum Color { RED, BLACK };
+  enum Color : unsigned char { RED, BLACK };
+  static constexpr bool key_only = std::is_same_v<Value, s21::tree_key_only>;
+  // Содержимое узла: только ключ для set, иначе пара, на которую итератор
+  // map отдает ссылку прямо из узла
+  using data_type =
+      std::conditional_t<key_only, Key, std::pair<const Key, Value>>;
   struct Node {
-    Key key;
-    Value value;
+    data_type data;
     Node* left;
     Node* right;
     Node* parent;
-    Color color;
-    Node(Key k, Value v, Color c = RED)
-        : key(k),
-          value(v),
+    // Цвет, признак узла из пула и число узлов в поддереве (порядковая
+    // статистика) делят одно машинное слово. Узел не из пула побывал в
+    // NodeHandle: он выделен прямо аллокатором и ему же возвращается
+    Color color : 1;
+    bool pooled : 1;
+    size_t size : 62;
+    // Значение строится прямо в узле из оставшихся аргументов
+    template <typename K, typename... Args>
+    explicit Node(K&& k, Args&&... args)
+        : data(makeData(std::forward<K>(k), std::forward<Args>(args)...)),
           left(nullptr),
           right(nullptr),
           parent(nullptr),
-          color(c) {}
+          color(RED),
+          pooled(true),
+          size(1) {}
+    const Key& key() const {
+      if constexpr (key_only) {
+        return data;
+      } else {
+        return data.first;
+      }
+    }
+    Value& value() { return data.second; }
+    const Value& value() const { return data.second; }
+
+   private:
+    template <typename K, typename... Args>
+    static data_type makeData(K&& k, Args&&... args) {
+      if constexpr (key_only) {
+        return data_type(std::forward<K>(k));
+      } else {
+        return data_type(std::piecewise_construct,
+                         std::forward_as_tuple(std::forward<K>(k)),
+                         std::forward_as_tuple(std::forward<Args>(args)...));
+      }
+    }
   };
 
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+  node_allocator alloc_;
+  // Узлы берутся из собственного пула дерева; освобожденные узлы
+  // переиспользуются, а память возвращается аллокатору только в clear()
+  s21::node_pool<Node, node_allocator> pool_;
+  Compare comp_;
+
   // Приватные методы класса
+  template <typename... Args>
+  Node* createNode(Args&&... args);
+  // Узел вне пула: его можно отдать в NodeHandle и вставить в другое
+  // дерево
+  template <typename... Args>
+  Node* createLooseNode(Args&&... args);
+  // Узел из готового содержимого: ключа для set или пары для map
+  template <typename Entry>
+  Node* createFromEntry(const Entry& entry) {
+    if constexpr (key_only) {
+      return createNode(entry);
+    } else {
+      return createNode(entry.first, entry.second);
+    }
+  }
+  template <typename Entry>
+  static const auto& entryKey(const Entry& entry) {
+    if constexpr (key_only) {
+      return entry;
+    } else {
+      return entry.first;
+    }
+  }
+  void destroyNode(Node* node) noexcept;
   void leftRotate(Node* node);
   void rightRotate(Node* node);
-  void insertFixup(Node* node);
+  // Возвращает true, если корень пришлось перекрасить в черный, то есть
+  // черная высота дерева выросла на единицу
+  bool insertFixup(Node* node);
   Node* minimum(Node* node) const;
   Node* maximum(Node* node) const;
   void transplant(Node* first_node, Node* second_node);
-  void deleteFixup(Node* node);
+  // Вырезание узла из дерева с балансировкой; сам узел не удаляется
+  void unlinkNode(Node* node);
+  // Место для неуникального ключа: после всех равных
+  template <typename K>
+  void findMultiInsertPos(const K& key, Node*& parent, bool& as_left) const;
+  void deleteFixup(Node* node, Node* parent);
   Node* copySubtree(Node* node, Node* parent);
-  void handleBrother(Node* node, Node* brother);
+  static bool isBlack(const Node* node) {
+    return node == nullptr || node->color == BLACK;
+  }
+  static size_t subtreeSize(const Node* node) {
+    return node ? node->size : 0;
+  }
+  static void updateSize(Node* node) {
+    node->size = subtreeSize(node->left) + subtreeSize(node->right) + 1;
+  }
+  // a < b через компаратор
+  template <typename A, typename B>
+  bool keyLess(const A& a, const B& b) const {
+    if constexpr (s21::is_three_way_compare<Compare>::value) {
+      return comp_(a, b) < 0;
+    } else {
+      return comp_(a, b);
+    }
+  }
+  template <typename K>
+  size_t countLess(const K& key) const;
+  template <typename K>
+  size_t countNotGreater(const K& key) const;
+  Node* selectNode(size_t index) const;
+  template <typename InputIt, typename Extract>
+  Node* buildSorted(InputIt& it, size_t count, size_t depth, size_t red_depth,
+                    Extract& extract);
+  // Число полностью заполненных уровней сбалансированного дерева из count
+  // узлов
+  static size_t fullLevels(size_t count) {
+    size_t full_levels = 0;
+    while ((size_t(2) << full_levels) - 1 <= count) ++full_levels;
+    return full_levels;
+  }
+  // Разворот дерева в список по возрастанию, связанный через right
+  Node* flatten(Node* node) const;
+  // Сбалансированное дерево из первых count узлов списка, как в
+  // buildSorted, но из готовых узлов; head сдвигается за последний
+  static Node* linkList(Node*& head, size_t count, size_t depth,
+                        size_t red_depth);
+  // Замена содержимого деревом из списка head длины count
+  void relink(Node* head, size_t count);
+  // Ключ и значение перемещаются без исключений
+  static constexpr bool nothrow_transfer =
+      std::is_nothrow_move_constructible_v<Key> &&
+      std::is_nothrow_move_constructible_v<Value>;
+  // Копия содержимого чужого узла в новом узле этого дерева (с loose - вне
+  // пула); при nothrow_transfer содержимое переносится
+  Node* createFromNode(Node* from, bool loose = false);
+  // Черная высота: число черных узлов на пути от node до пустой ссылки
+  static size_t blackHeight(const Node* node) {
+    size_t height = 0;
+    for (; node != nullptr; node = node->left) {
+      if (node->color == BLACK) ++height;
+    }
+    return height;
+  }
+  // Склейка поддеревьев left < middle < right с черными высотами
+  // left_height и right_height в одно за O(|left_height - right_height|
+  // + 1): middle подвешивается к краю более высокого дерева на уровне
+  // другого, и балансировка идет как после вставки. Корень - в root,
+  // высота результата - в height
+  Node* joinNodes(Node* left, size_t left_height, Node* middle, Node* right,
+                  size_t right_height, size_t& height);
+  // Разрез поддерева node высоты height: первые rank узлов по порядку
+  // уходят в left, остальные в right. Узлы на пути спуска склеиваются с
+  // отрезанными частями, и высоты склеек убывают, так что всего O(log n)
+  void splitRank(Node* node, size_t height, size_t rank, Node*& left,
+                 size_t& left_height, Node*& right, size_t& right_height);
 
  protected:
   Node* root;
+  // Крайние узлы кешируются: begin() и --end() не спускаются от корня
+  Node* leftmost_;
+  Node* rightmost_;
   size_t node_count;
-  Node* findNode(const Key& key) const;
+  // Пересчет крайних узлов после перестройки всего дерева
+  void resetBounds() {
+    leftmost_ = minimum(root);
+    rightmost_ = maximum(root);
+  }
+  template <typename K>
+  Node* findNode(const K& key) const;
+  Node* findInsertPos(const Key& key, Node*& parent, bool& as_left) const;
+  void attachNode(Node* node, Node* parent, bool as_left);
+  // Подвешивание узла сразу за anchor в порядке обхода (в начало при
+  // nullptr)
+  void attachAfter(Node* node, Node* anchor);
+  bool findHintPos(Node* hint, const Key& key, bool unique, Node*& parent,
+                   bool& as_left) const;
+  static Node* nextNode(Node* node);
+  static Node* prevNode(Node* node);
+  // Замена содержимого деревом из отсортированного диапазона за O(n);
+  // extract(*it) возвращает содержимое узла: ключ для set или пару
+  // (ключ, значение)
+  template <typename ForwardIt, typename Extract>
+  void bulkLoad(ForwardIt first, ForwardIt last, Extract extract, bool unique,
+                bool check_sorted);
+  template <typename K>
+  Node* lowerBoundNode(const K& key) const;
+  template <typename K>
+  Node* upperBoundNode(const K& key) const;
+  // Слияние за O(min(n + m, m log n)): если m log n < n, каждый ключ
+  // other ищется спуском, иначе оба дерева сливаются списками. При равных
+  // аллокаторах узлы other перевешиваются без выделения памяти (пул other
+  // переходит к этому дереву), иначе содержимое переносится в новые узлы.
+  // При unique для равных ключей вызывается on_equal(mine, theirs): если
+  // он вернул true, элемент остается в other, иначе удаляется
+  template <typename OnEqual>
+  void mergeFrom(RBTree& other, bool unique, OnEqual on_equal);
+  // Теоретико-множественные операции над отсортированными деревьями
+  enum class SetOperation { unite, intersect, subtract };
+  // Замена содержимого результатом операции над a и b за O(n + m). Для
+  // равных ключей берется элемент из a; для повторяющихся ключей
+  // кратности как у std::set_union, std::set_intersection и
+  // std::set_difference: максимум, минимум и разность
+  void assignSetOperation(const RBTree& a, const RBTree& b, SetOperation op);
+  // Перенос элементов с ключами из [lo, hi) в пустое дерево out. Дерево
+  // разрезается и склеивается за O(log n) без единого сравнения; сами k
+  // элементов переезжают в новые узлы out за O(k), потому что узлы
+  // принадлежат пулу своего дерева. Узлы вне пула (побывавшие в
+  // NodeHandle) при равных аллокаторах и nothrow_transfer переходят в out
+  // как есть. Место в out выделяется заранее, так что при исключении оба
+  // дерева остаются прежними
+  void extractRange(RBTree& out, const Key& lo, const Key& hi);
 
  public:
   using key_type = Key;
   using value_type = Value;
   using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
   // Конструкторы и деструктор
   RBTree();
+  explicit RBTree(const Allocator& alloc);
+  explicit RBTree(const Compare& comp, const Allocator& alloc = Allocator());
   RBTree(const RBTree& other);
   RBTree(RBTree&& other) noexcept;
   RBTree& operator=(const RBTree& other);
-  RBTree& operator=(RBTree&& other) noexcept;
+  RBTree& operator=(RBTree&& other) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value);
   ~RBTree();
   void clear(Node* node);
+  void clear();
+  void swap(RBTree& other) noexcept;
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+  key_compare key_comp() const { return comp_; }
+  // Статистика пула узлов: повторно использованные и новые узлы
+  size_type poolHits() const { return pool_.hits(); }
+  size_type poolMisses() const { return pool_.misses(); }
 
   // Публичные методы класса
   std::pair<Node*, bool> insert(const Key& key, const Value& value);
   std::pair<Node*, bool> insertMulti(const Key& key, const Value& value);
+  // Узел выделяется только если ключа еще нет в дереве
+  template <typename K, typename... Args>
+  std::pair<Node*, bool> tryEmplace(K&& key, Args&&... args);
+  template <typename K, typename... Args>
+  Node* emplaceMulti(K&& key, Args&&... args);
   void erase(const Key& key);
   bool contains(const Key& key) const;
   void print() const;
@@ -66,27 +336,54 @@ class RBTree {
   Value& at(const Key& key);
   const Value& at(const Key& key) const;
   Value& getOrInsert(const Key& key);
+  // Число элементов с ключом key за O(log n) по размерам поддеревьев
   size_type count(const Key& key) const {
-    size_type count = 0;
-    for (auto it = begin(); it != end(); ++it) {
-      if (*it == key) ++count;
-    }
-    return count;
+    return countNotGreater(key) - countLess(key);
+  }
+  // Порядковые статистики за O(log n)
+  // Число элементов, строго меньших key
+  size_type rank(const Key& key) const { return countLess(key); }
+  // Число элементов в полуинтервале [lo, hi)
+  size_type count_range(const Key& lo, const Key& hi) const {
+    return keyLess(lo, hi) ? countLess(hi) - countLess(lo) : 0;
+  }
+  // Поиск по ключу другого типа (например, std::string_view для
+  // std::string) без построения Key; только для прозрачного Compare
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const {
+    return findNode(key) != nullptr;
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K& key) const {
+    return countNotGreater(key) - countLess(key);
   }
 
+  class const_iterator;
   // Итератор
   class iterator {
+    friend class RBTree;
+    friend class const_iterator;
+
    private:
     Node* current;
-    Node* root;
+    // Дерево нужно только для --end(): последний узел берется из кеша
+    const RBTree* tree;
     Node* treeMinimum(Node* node) const;
     Node* treeMaximum(Node* node) const;
     Node* successor(Node* node) const;
     Node* predecessor(Node* node) const;
 
    public:
-    iterator(Node* root = nullptr, Node* start = nullptr)
-        : current(start), root(root) {}
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    iterator(const RBTree* tree = nullptr, Node* start = nullptr)
+        : current(start), tree(tree) {}
     iterator& operator++() {
       current = successor(current);
       return *this;
@@ -98,7 +395,7 @@ class RBTree {
     }
     iterator& operator--() {
       if (current == nullptr) {
-        current = treeMaximum(root);
+        current = tree->rightmost_;
       } else {
         current = predecessor(current);
       }
@@ -107,13 +404,16 @@ class RBTree {
     iterator operator--(int) {
       iterator temp = *this;
       if (current == nullptr) {
-        current = treeMaximum(root);
+        current = tree->rightmost_;
       } else {
         current = predecessor(current);
       }
       return temp;
     }
-    Key& operator*() const { return current->key; }
+    const Key& operator*() const { return current->key(); }
+    // Содержимое текущего узла (для map - пара ключ-значение) без поиска
+    // и копирования
+    data_type& entry() const { return current->data; }
     bool operator==(const iterator& other) const {
       return current == other.current;
     }
@@ -123,17 +423,28 @@ class RBTree {
   };
   // Итератор для константных объектов
   class const_iterator {
+    friend class RBTree;
+
    private:
     const Node* current;
-    const Node* root;
+    // Дерево нужно только для --end(): последний узел берется из кеша
+    const RBTree* tree;
     const Node* treeMinimum(const Node* node) const;
     const Node* treeMaximum(const Node* node) const;
     const Node* successor(const Node* node) const;
     const Node* predecessor(const Node* node) const;
 
    public:
-    const_iterator(const Node* root = nullptr, const Node* start = nullptr)
-        : current(start), root(root) {}
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    const_iterator(const RBTree* tree = nullptr, const Node* start = nullptr)
+        : current(start), tree(tree) {}
+    const_iterator(const iterator& other)
+        : current(other.current), tree(other.tree) {}
     const_iterator& operator++() {
       current = successor(current);
       return *this;
@@ -145,7 +456,7 @@ class RBTree {
     }
     const_iterator& operator--() {
       if (current == nullptr) {
-        current = treeMaximum(root);
+        current = tree->rightmost_;
       } else {
         current = predecessor(current);
       }
@@ -154,13 +465,14 @@ class RBTree {
     const_iterator operator--(int) {
       const_iterator temp = *this;
       if (current == nullptr) {
-        current = treeMaximum(root);
+        current = tree->rightmost_;
       } else {
         current = predecessor(current);
       }
       return temp;
     }
-    const Key& operator*() const { return current->key; }
+    const Key& operator*() const { return current->key(); }
+    const data_type& entry() const { return current->data; }
     bool operator==(const const_iterator& other) const {
       return current == other.current;
     }
@@ -170,40 +482,158 @@ class RBTree {
   };
   // Первый элемент, больший или равный key
   iterator lower_bound(const Key& key) {
-    Node* node = root;
-    Node* result = nullptr;
-    while (node) {
-      if (key <= node->key) {
-        result = node;
-        node = node->left;
-      } else {
-        node = node->right;
-      }
-    }
-    return iterator(root, result);
+    return iterator(this, lowerBoundNode(key));
+  }
+  const_iterator lower_bound(const Key& key) const {
+    return const_iterator(this, lowerBoundNode(key));
   }
   // Первый элемент, больший key
   iterator upper_bound(const Key& key) {
-    Node* node = root;
-    Node* result = nullptr;
-    while (node) {
-      if (key < node->key) {
-        result = node;
-        node = node->left;
-      } else {
-        node = node->right;
-      }
-    }
-    return iterator(root, result);
+    return iterator(this, upperBoundNode(key));
+  }
+  const_iterator upper_bound(const Key& key) const {
+    return const_iterator(this, upperBoundNode(key));
   }
   // Диапазон элементов с данным ключом
   std::pair<iterator, iterator> equal_range(const Key& key) {
     return {lower_bound(key), upper_bound(key)};
   }
-  iterator begin() { return iterator(root, minimum(root)); }
-  iterator end() { return iterator(root, nullptr); }
-  const_iterator begin() const { return const_iterator(root, minimum(root)); }
-  const_iterator end() const { return const_iterator(root, nullptr); }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  // Те же границы для ключа другого типа при прозрачном Compare
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K& key) {
+    return iterator(this, lowerBoundNode(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator lower_bound(const K& key) const {
+    return const_iterator(this, lowerBoundNode(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K& key) {
+    return iterator(this, upperBoundNode(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator upper_bound(const K& key) const {
+    return const_iterator(this, upperBoundNode(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  // Элемент с номером index (с нуля) в порядке возрастания; end(),
+  // если index >= size()
+  iterator select(size_type index) {
+    return iterator(this, selectNode(index));
+  }
+  const_iterator select(size_type index) const {
+    return const_iterator(this, selectNode(index));
+  }
+  // Вставка рядом с подсказкой: если ключ встает прямо перед hint (или
+  // сразу после него для уникальных ключей), спуска от корня нет, и
+  // вставка выполняется за амортизированное O(1)
+  template <typename K, typename... Args>
+  std::pair<Node*, bool> tryEmplaceHint(iterator hint, K&& key,
+                                        Args&&... args);
+  template <typename K, typename... Args>
+  Node* emplaceMultiHint(iterator hint, K&& key, Args&&... args);
+  iterator begin() { return iterator(this, leftmost_); }
+  iterator end() { return iterator(this, nullptr); }
+  const_iterator begin() const { return const_iterator(this, leftmost_); }
+  const_iterator end() const { return const_iterator(this, nullptr); }
+
+  // Элемент, вынутый из дерева, как node_type в std: владеет узлом и
+  // переходит в другое дерево того же типа (с равным аллокатором) без
+  // выделения памяти и копирования. Ключ в нем можно менять
+  class NodeHandle {
+    friend class RBTree;
+
+   public:
+    using key_type = Key;
+    using allocator_type = Allocator;
+
+    NodeHandle() noexcept = default;
+    NodeHandle(NodeHandle&& other) noexcept
+        : node_(other.node_), alloc_(std::move(other.alloc_)) {
+      other.node_ = nullptr;
+      other.alloc_.reset();
+    }
+    NodeHandle& operator=(NodeHandle&& other) noexcept {
+      if (this != &other) {
+        reset();
+        node_ = other.node_;
+        alloc_ = std::move(other.alloc_);
+        other.node_ = nullptr;
+        other.alloc_.reset();
+      }
+      return *this;
+    }
+    ~NodeHandle() { reset(); }
+
+    bool empty() const noexcept { return node_ == nullptr; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+    allocator_type get_allocator() const { return allocator_type(*alloc_); }
+    // Ключ и значение для map
+    template <bool K = key_only, typename = std::enable_if_t<!K>>
+    Key& key() const {
+      return const_cast<Key&>(node_->data.first);
+    }
+    template <bool K = key_only, typename = std::enable_if_t<!K>>
+    Value& mapped() const {
+      return node_->data.second;
+    }
+    // Значение для set и multiset
+    template <bool K = key_only, typename = std::enable_if_t<K>>
+    Key& value() const {
+      return node_->data;
+    }
+    void swap(NodeHandle& other) noexcept {
+      std::swap(node_, other.node_);
+      std::swap(alloc_, other.alloc_);
+    }
+
+   private:
+    NodeHandle(Node* node, const node_allocator& alloc)
+        : node_(node), alloc_(alloc) {}
+    // Узел в NodeHandle всегда вне пула
+    void reset() noexcept {
+      if (node_ != nullptr) {
+        node_traits::destroy(*alloc_, node_);
+        node_traits::deallocate(*alloc_, node_, 1);
+        node_ = nullptr;
+      }
+      alloc_.reset();
+    }
+
+    Node* node_ = nullptr;
+    std::optional<node_allocator> alloc_;
+  };
+
+ protected:
+  // Удаление именно узла под итератором, без повторного поиска по ключу:
+  // в multiset равных ключей может быть несколько
+  void eraseAt(const_iterator pos);
+  // Вынимает узел из дерева за O(log n). Узел из пула сначала отдает
+  // содержимое новому узлу вне пула: узлы пула не переживают свое дерево.
+  // Узел, который уже был в NodeHandle, переходит без копирования
+  NodeHandle extractAt(const_iterator pos);
+  // Первый элемент с ключом key или пустой NodeHandle
+  NodeHandle extractKey(const Key& key);
+  // Подвешивание узла из handle без выделения памяти. Если unique и ключ
+  // занят, узел остается в handle, и возвращается найденный узел
+  std::pair<Node*, bool> insertHandle(NodeHandle& handle, bool unique);
 };
 
 #include "s21_tree.tpp"
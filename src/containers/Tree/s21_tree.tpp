@@ -4,122 +4,1053 @@
 #include "s21_tree.h"
 
 // Конструкторы
-template <typename Key, typename Value>
-RBTree<Key, Value>::RBTree() : root(nullptr), node_count(0) {}
+template <typename Key, typename Value, typename Compare, typename Allocator>
+RBTree<Key, Value, Compare, Allocator>::RBTree()
+    : alloc_(),
+      root(nullptr),
+      leftmost_(nullptr),
+      rightmost_(nullptr),
+      node_count(0) {}
 
-template <typename Key, typename Value>
-RBTree<Key, Value>::RBTree(const RBTree& other) : root(nullptr), node_count(0) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+RBTree<Key, Value, Compare, Allocator>::RBTree(const Allocator& alloc)
+    : alloc_(alloc),
+      root(nullptr),
+      leftmost_(nullptr),
+      rightmost_(nullptr),
+      node_count(0) {}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+RBTree<Key, Value, Compare, Allocator>::RBTree(const Compare& comp,
+                                               const Allocator& alloc)
+    : alloc_(alloc),
+      comp_(comp),
+      root(nullptr),
+      leftmost_(nullptr),
+      rightmost_(nullptr),
+      node_count(0) {}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+RBTree<Key, Value, Compare, Allocator>::RBTree(const RBTree& other)
+    : alloc_(node_traits::select_on_container_copy_construction(other.alloc_)),
+      comp_(other.comp_),
+      root(nullptr),
+      leftmost_(nullptr),
+      rightmost_(nullptr),
+      node_count(0) {
   if (other.root) {
     root = copySubtree(other.root, nullptr);
     node_count = other.node_count;
+    resetBounds();
   }
 }
 
-template <typename Key, typename Value>
-RBTree<Key, Value>::RBTree(RBTree&& other) noexcept
-    : root(other.root), node_count(other.node_count) {
-  other.root = nullptr;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+RBTree<Key, Value, Compare, Allocator>::RBTree(RBTree&& other) noexcept
+    : alloc_(std::move(other.alloc_)),
+      pool_(std::move(other.pool_)),
+      comp_(other.comp_),
+      root(other.root),
+      leftmost_(other.leftmost_),
+      rightmost_(other.rightmost_),
+      node_count(other.node_count) {
+  other.root = other.leftmost_ = other.rightmost_ = nullptr;
   other.node_count = 0;
 }
 
 // Деструктор
-template <typename Key, typename Value>
-RBTree<Key, Value>::~RBTree() {
-  clear(root);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+RBTree<Key, Value, Compare, Allocator>::~RBTree() {
+  clear();
 }
 
-template <typename Key, typename Value>
-void RBTree<Key, Value>::clear(Node* node) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::clear(Node* node) {
   if (node) {
     clear(node->left);
     clear(node->right);
-    delete node;
+    destroyNode(node);
+  }
+}
+
+// Удаление всех узлов и возврат памяти пула аллокатору
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::clear() {
+  clear(root);
+  pool_.release(alloc_);
+  root = leftmost_ = rightmost_ = nullptr;
+  node_count = 0;
+}
+
+// Обмен содержимым; аллокаторы меняются местами, только если это
+// разрешает propagate_on_container_swap
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::swap(RBTree& other) noexcept {
+  if constexpr (node_traits::propagate_on_container_swap::value) {
+    std::swap(alloc_, other.alloc_);
+  }
+  pool_.swap(other.pool_);
+  std::swap(comp_, other.comp_);
+  std::swap(root, other.root);
+  std::swap(leftmost_, other.leftmost_);
+  std::swap(rightmost_, other.rightmost_);
+  std::swap(node_count, other.node_count);
+}
+
+// Выделение и освобождение узлов через пул
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::createNode(Args&&... args) {
+  Node* node = pool_.allocate(alloc_);
+  try {
+    node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    pool_.deallocate(node);
+    throw;
+  }
+  return node;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::createLooseNode(Args&&... args) {
+  Node* node = node_traits::allocate(alloc_, 1);
+  try {
+    node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  node->pooled = false;
+  return node;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::destroyNode(Node* node) noexcept {
+  bool pooled = node->pooled;
+  node_traits::destroy(alloc_, node);
+  if (pooled) {
+    pool_.deallocate(node);
+  } else {
+    node_traits::deallocate(alloc_, node, 1);
+  }
+}
+
+// Нахождение узла по ключу. Трехсторонний компаратор останавливается на
+// первом равном узле; обычный спускается к нижней границе и проверяет
+// равенство один раз в конце, так что на уровень приходится один вызов
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::findNode(const K& key) const {
+  if constexpr (s21::is_three_way_compare<Compare>::value) {
+    Node* current = root;
+    while (current) {
+      int order = comp_(key, current->key());
+      if (order < 0) {
+        current = current->left;
+      } else if (order > 0) {
+        current = current->right;
+      } else {
+        return current;
+      }
+    }
+    return nullptr;
+  } else {
+    Node* candidate = lowerBoundNode(key);
+    return candidate && !comp_(key, candidate->key()) ? candidate : nullptr;
+  }
+}
+
+// Первый узел с ключом, не меньшим key
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::lowerBoundNode(const K& key) const {
+  Node* node = root;
+  Node* result = nullptr;
+  while (node) {
+    if (!keyLess(node->key(), key)) {
+      result = node;
+      node = node->left;
+    } else {
+      node = node->right;
+    }
   }
+  return result;
 }
 
-// Нахождение узла по ключу
-template <typename Key, typename Value>
-typename RBTree<Key, Value>::Node* RBTree<Key, Value>::findNode(
-    const Key& key) const {
-  Node* current = root;
-  while (current) {
-    if (key < current->key) {
-      current = current->left;
-    } else if (key > current->key) {
-      current = current->right;
-    } else
-      return current;
+// Первый узел с ключом, большим key
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::upperBoundNode(const K& key) const {
+  Node* node = root;
+  Node* result = nullptr;
+  while (node) {
+    if (keyLess(key, node->key())) {
+      result = node;
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  return result;
+}
+
+// Число ключей, меньших key: при каждом повороте направо к ответу
+// добавляется левое поддерево и сам узел
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+size_t RBTree<Key, Value, Compare, Allocator>::countLess(const K& key) const {
+  size_t result = 0;
+  for (Node* node = root; node;) {
+    if (keyLess(node->key(), key)) {
+      result += subtreeSize(node->left) + 1;
+      node = node->right;
+    } else {
+      node = node->left;
+    }
+  }
+  return result;
+}
+
+// Число ключей, не больших key
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+size_t RBTree<Key, Value, Compare, Allocator>::countNotGreater(
+    const K& key) const {
+  size_t result = 0;
+  for (Node* node = root; node;) {
+    if (keyLess(key, node->key())) {
+      node = node->left;
+    } else {
+      result += subtreeSize(node->left) + 1;
+      node = node->right;
+    }
+  }
+  return result;
+}
+
+// Узел с номером index в порядке возрастания или nullptr
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::selectNode(size_t index) const {
+  Node* node = root;
+  while (node) {
+    size_t left_size = subtreeSize(node->left);
+    if (index < left_size) {
+      node = node->left;
+    } else if (index == left_size) {
+      return node;
+    } else {
+      index -= left_size + 1;
+      node = node->right;
+    }
   }
   return nullptr;
 }
 
-// Вставка нового узла
-template <typename Key, typename Value>
-std::pair<typename RBTree<Key, Value>::Node*, bool> RBTree<Key, Value>::insert(
-    const Key& key, const Value& value) {
-  Node* new_node = new Node(key, value);
-  Node* parent_node = nullptr;
-  Node* find_place_node = root;
-
-  while (find_place_node != nullptr) {
-    parent_node = find_place_node;
-    if (new_node->key < find_place_node->key) {
-      find_place_node = find_place_node->left;
-    } else if (new_node->key > find_place_node->key) {
-      find_place_node = find_place_node->right;
+// Построение дерева из отсортированного диапазона без балансировок.
+// Каждое поддерево делится пополам, поэтому все пустые ссылки лежат на
+// двух соседних уровнях: узлы неполного нижнего уровня красные, остальные
+// черные, и черная высота всех путей одинакова
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename ForwardIt, typename Extract>
+void RBTree<Key, Value, Compare, Allocator>::bulkLoad(ForwardIt first,
+                                                      ForwardIt last,
+                                                      Extract extract,
+                                                      bool unique,
+                                                      bool check_sorted) {
+  if (check_sorted && first != last) {
+    ForwardIt prev = first;
+    for (ForwardIt it = std::next(first); it != last; prev = it++) {
+      const auto& prev_key = entryKey(extract(*prev));
+      const auto& key = entryKey(extract(*it));
+      if (unique ? !keyLess(prev_key, key) : keyLess(key, prev_key)) {
+        throw std::invalid_argument("bulk load input is not sorted");
+      }
+    }
+  }
+  clear();
+  size_t count = static_cast<size_t>(std::distance(first, last));
+  root = buildSorted(first, count, 0, fullLevels(count), extract);
+  node_count = count;
+  resetBounds();
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename InputIt, typename Extract>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::buildSorted(InputIt& it, size_t count,
+                                                    size_t depth,
+                                                    size_t red_depth,
+                                                    Extract& extract) {
+  if (count == 0) return nullptr;
+  size_t left_count = (count - 1) / 2;
+  Node* left = buildSorted(it, left_count, depth + 1, red_depth, extract);
+  Node* node = nullptr;
+  try {
+    node = createFromEntry(extract(*it));
+  } catch (...) {
+    clear(left);
+    throw;
+  }
+  ++it;
+  node->left = left;
+  if (left) left->parent = node;
+  node->color = depth == red_depth ? RED : BLACK;
+  node->size = count;
+  try {
+    node->right =
+        buildSorted(it, count - 1 - left_count, depth + 1, red_depth, extract);
+  } catch (...) {
+    clear(node);
+    throw;
+  }
+  if (node->right) node->right->parent = node;
+  return node;
+}
+
+// Обход идет от максимума назад: prevNode не читает right у пройденных
+// узлов, так что их можно перевешивать сразу
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::flatten(Node* node) const {
+  Node* head = nullptr;
+  for (node = maximum(node); node != nullptr;) {
+    Node* prev = prevNode(node);
+    node->right = head;
+    head = node;
+    node = prev;
+  }
+  return head;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::linkList(Node*& head, size_t count,
+                                                 size_t depth,
+                                                 size_t red_depth) {
+  if (count == 0) return nullptr;
+  size_t left_count = (count - 1) / 2;
+  Node* left = linkList(head, left_count, depth + 1, red_depth);
+  Node* node = head;
+  head = head->right;
+  node->left = left;
+  if (left) left->parent = node;
+  node->color = depth == red_depth ? RED : BLACK;
+  node->size = count;
+  node->right = linkList(head, count - 1 - left_count, depth + 1, red_depth);
+  if (node->right) node->right->parent = node;
+  return node;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::relink(Node* head, size_t count) {
+  root = linkList(head, count, 0, fullLevels(count));
+  if (root) root->parent = nullptr;
+  node_count = count;
+  resetBounds();
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::createFromNode(Node* from,
+                                                       bool loose) {
+  auto create = [this, loose](auto&&... args) {
+    return loose ? createLooseNode(std::forward<decltype(args)>(args)...)
+                 : createNode(std::forward<decltype(args)>(args)...);
+  };
+  if constexpr (!nothrow_transfer && key_only) {
+    return create(from->data);
+  } else if constexpr (!nothrow_transfer) {
+    return create(from->data.first, from->data.second);
+  } else if constexpr (key_only) {
+    return create(std::move(from->data));
+  } else {
+    // Узел from удаляется сразу после переноса, так что ключ можно забрать
+    return create(std::move(const_cast<Key&>(from->data.first)),
+                  std::move(from->data.second));
+  }
+}
+
+// Первый проход только решает судьбу каждого узла other и может бросить
+// исключение (компаратор, on_equal, копирование): для переносимого узла в
+// parent запоминается последний узел этого дерева перед ним, в size -
+// решение, в left - копия, если ее построение может бросить. При
+// исключении копии удаляются, и оба дерева собираются заново. Второй
+// проход исключений не бросает: память для переносов выделена заранее.
+// При равных аллокаторах старый пул other переходит к этому дереву вместе
+// с узлами, и они перевешиваются как есть; остающиеся в other узлы
+// переезжают в его новый пул
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename OnEqual>
+void RBTree<Key, Value, Compare, Allocator>::mergeFrom(RBTree& other,
+                                                       bool unique,
+                                                       OnEqual on_equal) {
+  if (this == &other || other.root == nullptr) return;
+  enum : size_t { move_in, keep, drop };
+  const bool adopt = alloc_ == other.alloc_;
+  // Несколько ключей в большое дерево ищутся спуском от корня за
+  // O(m log n), иначе оба дерева сливаются списками за O(n + m)
+  const bool by_node =
+      other.node_count * (fullLevels(node_count) + 1) < node_count;
+  s21::node_pool<Node, node_allocator> old_pool;
+  if (adopt) old_pool.swap(other.pool_);
+  const size_t theirs_count = other.node_count;
+  Node* theirs = other.flatten(other.root);
+  Node* mine = by_node ? nullptr : flatten(root);
+  size_t moved = 0;
+  size_t kept = 0;
+  Node* node = theirs;
+  try {
+    Node* before = nullptr;
+    Node* next_mine = mine;
+    for (; node != nullptr; node = node->right) {
+      Node* equal = nullptr;
+      if (by_node) {
+        Node* bound = unique ? lowerBoundNode(node->key())
+                             : upperBoundNode(node->key());
+        if (unique && bound && !keyLess(node->key(), bound->key())) {
+          equal = bound;
+        } else {
+          before = bound ? prevNode(bound) : rightmost_;
+        }
+      } else {
+        while (next_mine &&
+               (unique ? keyLess(next_mine->key(), node->key())
+                       : !keyLess(node->key(), next_mine->key()))) {
+          before = next_mine;
+          next_mine = next_mine->right;
+        }
+        if (unique && next_mine && !keyLess(node->key(), next_mine->key())) {
+          equal = next_mine;
+        }
+      }
+      node->left = nullptr;
+      if (equal == nullptr) {
+        node->size = move_in;
+        node->parent = before;
+        ++moved;
+        if (!adopt && !nothrow_transfer) node->left = createFromNode(node);
+      } else if (on_equal(equal, node)) {
+        node->size = keep;
+        ++kept;
+        if (adopt && !nothrow_transfer && node->pooled) {
+          node->left = other.createFromNode(node);
+        }
+      } else {
+        node->size = drop;
+      }
+    }
+    if constexpr (nothrow_transfer) {
+      if (adopt) {
+        other.pool_.reserve(kept, other.alloc_);
+      } else {
+        pool_.reserve(moved, alloc_);
+      }
+    }
+  } catch (...) {
+    for (Node* done = theirs; done != node; done = done->right) {
+      if (done->left == nullptr) continue;
+      if (done->size == move_in) {
+        destroyNode(done->left);
+      } else {
+        other.destroyNode(done->left);
+      }
+    }
+    if (adopt) {
+      other.pool_.release(other.alloc_);
+      other.pool_.swap(old_pool);
+    }
+    if (!by_node) relink(mine, node_count);
+    other.relink(theirs, theirs_count);
+    throw;
+  }
+
+  if (adopt) pool_.adopt(old_pool);
+  Node* merged = nullptr;
+  Node** merged_tail = &merged;
+  Node* next_mine = mine;
+  Node* last_mine = nullptr;
+  Node* stayed = nullptr;
+  Node** stayed_tail = &stayed;
+  Node* last_before = nullptr;
+  Node* last_moved = nullptr;
+  for (node = theirs; node != nullptr;) {
+    Node* next = node->right;
+    Node* copy = node->left;
+    if (node->size == drop) {
+      if (adopt) {
+        destroyNode(node);
+      } else {
+        other.destroyNode(node);
+      }
+    } else if (node->size == keep) {
+      Node* stays = node;
+      if (adopt && node->pooled) {
+        stays = copy ? copy : other.createFromNode(node);
+        destroyNode(node);
+      }
+      *stayed_tail = stays;
+      stayed_tail = &stays->right;
     } else {
-      delete new_node;
-      return std::make_pair(find_place_node, false);
+      Node* before = node->parent;
+      Node* moving = node;
+      if (!adopt) {
+        moving = copy ? copy : createFromNode(node);
+        other.destroyNode(node);
+      }
+      if (by_node) {
+        // Узлы с общим соседом слева встают друг за другом
+        attachAfter(moving, last_moved && before == last_before ? last_moved
+                                                                : before);
+      } else {
+        while (before != nullptr && last_mine != before) {
+          last_mine = next_mine;
+          *merged_tail = next_mine;
+          merged_tail = &next_mine->right;
+          next_mine = next_mine->right;
+        }
+        *merged_tail = moving;
+        merged_tail = &moving->right;
+      }
+      last_before = before;
+      last_moved = moving;
     }
+    node = next;
   }
-  new_node->parent = parent_node;
-  if (parent_node == nullptr)
-    root = new_node;
-  else if (new_node->key < parent_node->key)
-    parent_node->left = new_node;
-  else
-    parent_node->right = new_node;
+  if (!by_node) {
+    *merged_tail = next_mine;
+    relink(merged, node_count + moved);
+  }
+  *stayed_tail = nullptr;
+  other.relink(stayed, kept);
+}
 
-  new_node->color = RED;
-  insertFixup(new_node);
+// Подвешивание без сравнений: за anchor в порядке обхода стоит минимум
+// его правого поддерева, и место есть либо справа у anchor, либо слева
+// у этого минимума
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::attachAfter(Node* node,
+                                                         Node* anchor) {
+  node->left = node->right = nullptr;
+  node->size = 1;
+  if (anchor == nullptr) {
+    attachNode(node, leftmost_, true);
+  } else if (anchor->right == nullptr) {
+    attachNode(node, anchor, false);
+  } else {
+    attachNode(node, minimum(anchor->right), true);
+  }
+}
+
+// Два указателя идут по деревьям по возрастанию, и выбранные элементы
+// копируются в новые узлы, которые сразу собираются в список. Перестройки
+// и повороты не нужны: готовый список подвешивается как при bulkLoad
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::assignSetOperation(
+    const RBTree& a, const RBTree& b, SetOperation op) {
+  clear();
+  Node* first = a.leftmost_;
+  Node* second = b.leftmost_;
+  Node* head = nullptr;
+  Node** tail = &head;
+  size_t count = 0;
+  try {
+    while (first != nullptr || second != nullptr) {
+      // Оставшиеся элементы одного дерева уже не попадут в результат
+      if (second == nullptr ? op == SetOperation::intersect
+                            : first == nullptr && op != SetOperation::unite) {
+        break;
+      }
+      const Node* pick = nullptr;
+      if (second == nullptr ||
+          (first != nullptr && keyLess(first->key(), second->key()))) {
+        if (op != SetOperation::intersect) pick = first;
+        first = nextNode(first);
+      } else if (first == nullptr || keyLess(second->key(), first->key())) {
+        if (op == SetOperation::unite) pick = second;
+        second = nextNode(second);
+      } else {
+        if (op != SetOperation::subtract) pick = first;
+        first = nextNode(first);
+        second = nextNode(second);
+      }
+      if (pick != nullptr) {
+        Node* node = createFromEntry(pick->data);
+        *tail = node;
+        tail = &node->right;
+        ++count;
+      }
+    }
+  } catch (...) {
+    *tail = nullptr;
+    relink(head, count);
+    throw;
+  }
+  *tail = nullptr;
+  relink(head, count);
+}
+
+// Корни сначала перекрашиваются в черный (высота при этом может вырасти),
+// чтобы красный middle не встал под красный корень или над ним. root
+// служит рабочим корнем для поворотов внутри insertFixup
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::joinNodes(Node* left,
+                                                  size_t left_height,
+                                                  Node* middle, Node* right,
+                                                  size_t right_height,
+                                                  size_t& height) {
+  if (left) {
+    left->parent = nullptr;
+    if (left->color == RED) {
+      left->color = BLACK;
+      ++left_height;
+    }
+  }
+  if (right) {
+    right->parent = nullptr;
+    if (right->color == RED) {
+      right->color = BLACK;
+      ++right_height;
+    }
+  }
+  middle->parent = nullptr;
+  if (left_height == right_height) {
+    middle->left = left;
+    middle->right = right;
+    if (left) left->parent = middle;
+    if (right) right->parent = middle;
+    middle->color = BLACK;
+    updateSize(middle);
+    height = left_height + 1;
+    return middle;
+  }
+  bool to_right = left_height > right_height;
+  Node* tall = to_right ? left : right;
+  Node* low = to_right ? right : left;
+  size_t tall_height = to_right ? left_height : right_height;
+  size_t low_height = to_right ? right_height : left_height;
+  // Спуск по ближнему к low краю до черного узла той же высоты, что у low
+  Node* parent = nullptr;
+  Node* cut = tall;
+  size_t cut_height = tall_height;
+  while (!isBlack(cut) || cut_height != low_height) {
+    if (cut->color == BLACK) --cut_height;
+    parent = cut;
+    cut = to_right ? cut->right : cut->left;
+  }
+  middle->left = to_right ? cut : low;
+  middle->right = to_right ? low : cut;
+  if (cut) cut->parent = middle;
+  if (low) low->parent = middle;
+  middle->parent = parent;
+  middle->color = RED;
+  updateSize(middle);
+  if (to_right) {
+    parent->right = middle;
+  } else {
+    parent->left = middle;
+  }
+  for (Node* ancestor = parent; ancestor; ancestor = ancestor->parent) {
+    ancestor->size += subtreeSize(low) + 1;
+  }
+  root = tall;
+  height = tall_height + (insertFixup(middle) ? 1 : 0);
+  return root;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::splitRank(
+    Node* node, size_t height, size_t rank, Node*& left, size_t& left_height,
+    Node*& right, size_t& right_height) {
+  if (rank == 0 || node == nullptr) {
+    left = nullptr;
+    left_height = 0;
+    right = node;
+    right_height = height;
+    return;
+  }
+  if (rank >= node->size) {
+    left = node;
+    left_height = height;
+    right = nullptr;
+    right_height = 0;
+    return;
+  }
+  size_t child_height = height - (node->color == BLACK ? 1 : 0);
+  Node* node_left = node->left;
+  Node* node_right = node->right;
+  size_t left_size = subtreeSize(node_left);
+  Node* inner = nullptr;
+  size_t inner_height = 0;
+  if (rank <= left_size) {
+    splitRank(node_left, child_height, rank, left, left_height, inner,
+              inner_height);
+    right = joinNodes(inner, inner_height, node, node_right, child_height,
+                      right_height);
+  } else {
+    splitRank(node_right, child_height, rank - left_size - 1, inner,
+              inner_height, right, right_height);
+    left = joinNodes(node_left, child_height, node, inner, inner_height,
+                     left_height);
+  }
+}
+
+// Дерево режется по номерам элементов на три части, крайние склеиваются
+// через первый узел правой части, а средняя переезжает в out. Если
+// содержимое переносится без исключений, средняя часть проходится один
+// раз: каждый узел отдает содержимое новому узлу out и сразу удаляется.
+// Иначе копии строятся до разреза, чтобы исключение ничего не меняло
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::extractRange(RBTree& out,
+                                                          const Key& lo,
+                                                          const Key& hi) {
+  if (this == &out || !keyLess(lo, hi)) return;
+  size_t first = countLess(lo);
+  size_t count = countLess(hi) - first;
+  if (count == 0) return;
+  out.pool_.reserve(count, out.alloc_);
+  Node* head = nullptr;
+  Node** tail = &head;
+  if constexpr (!nothrow_transfer) {
+    try {
+      Node* node = selectNode(first);
+      for (size_t made = 0; made < count; ++made, node = nextNode(node)) {
+        Node* copy = out.createFromNode(node);
+        *tail = copy;
+        tail = &copy->right;
+      }
+    } catch (...) {
+      *tail = nullptr;
+      while (head != nullptr) {
+        Node* next = head->right;
+        out.destroyNode(head);
+        head = next;
+      }
+      throw;
+    }
+  }
+
+  Node *before, *rest, *range, *after;
+  size_t before_height, rest_height, range_height, after_height;
+  splitRank(root, blackHeight(root), first, before, before_height, rest,
+            rest_height);
+  splitRank(rest, rest_height, count, range, range_height, after,
+            after_height);
+  if (before == nullptr || after == nullptr) {
+    root = before ? before : after;
+  } else {
+    Node* pivot;
+    size_t pivot_height;
+    splitRank(after, after_height, 1, pivot, pivot_height, after,
+              after_height);
+    size_t height;
+    root = joinNodes(before, before_height, pivot, after, after_height,
+                     height);
+  }
+  if (root) {
+    root->parent = nullptr;
+    root->color = BLACK;
+  }
+  node_count -= count;
+  resetBounds();
+
+  if constexpr (nothrow_transfer) {
+    // Симметричный обход со стеком предков: узел удаляется, как только
+    // из него прочитана правая ссылка. Высота красно-черного дерева не
+    // больше 2 * log2(n + 1), то есть меньше 128
+    const bool adopt_loose = alloc_ == out.alloc_;
+    Node* ancestors[128];
+    size_t depth = 0;
+    for (Node* node = range; node != nullptr || depth != 0;) {
+      for (; node != nullptr; node = node->left) ancestors[depth++] = node;
+      node = ancestors[--depth];
+      Node* next = node->right;
+      Node* moved = node;
+      if (node->pooled || !adopt_loose) {
+        moved = out.createFromNode(node);
+        destroyNode(node);
+      }
+      *tail = moved;
+      tail = &moved->right;
+      node = next;
+    }
+  } else {
+    clear(range);
+  }
+  *tail = nullptr;
+  out.relink(head, count);
+}
+
+// Спуск к месту вставки: возвращает узел с таким же ключом, если он
+// есть, иначе nullptr, будущего родителя в parent и сторону в as_left.
+// На каждом уровне один вызов компаратора: с обычным компаратором
+// запоминается последний узел, где спуск ушел вправо (кандидат в равные),
+// и равенство проверяется один раз внизу
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::findInsertPos(const Key& key,
+                                                      Node*& parent,
+                                                      bool& as_left) const {
+  parent = nullptr;
+  as_left = false;
+  Node* candidate = nullptr;
+  for (Node* current = root; current != nullptr;) {
+    parent = current;
+    if constexpr (s21::is_three_way_compare<Compare>::value) {
+      int order = comp_(key, current->key());
+      if (order == 0) return current;
+      as_left = order < 0;
+    } else {
+      as_left = comp_(key, current->key());
+      if (!as_left) candidate = current;
+    }
+    current = as_left ? current->left : current->right;
+  }
+  if (candidate && !keyLess(candidate->key(), key)) return candidate;
+  return nullptr;
+}
+
+// Подвешивание нового узла к parent слева или справа и балансировка
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::attachNode(Node* node,
+                                                        Node* parent,
+                                                        bool as_left) {
+  node->parent = parent;
+  if (parent == nullptr) {
+    root = leftmost_ = rightmost_ = node;
+  } else if (as_left) {
+    parent->left = node;
+    if (parent == leftmost_) leftmost_ = node;
+  } else {
+    parent->right = node;
+    if (parent == rightmost_) rightmost_ = node;
+  }
+  for (Node* ancestor = parent; ancestor; ancestor = ancestor->parent) {
+    ancestor->size++;
+  }
+
+  node->color = RED;
+  insertFixup(node);
   node_count++;
-  return std::make_pair(new_node, true);
+}
+
+// Вставка нового узла
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename RBTree<Key, Value, Compare, Allocator>::Node*, bool>
+RBTree<Key, Value, Compare, Allocator>::insert(const Key& key,
+                                               const Value& value) {
+  return tryEmplace(key, value);
 }
 
 // Вставка нового узла (значения могут повторяться, для multiset)
-template <typename Key, typename Value>
-std::pair<typename RBTree<Key, Value>::Node*, bool>
-RBTree<Key, Value>::insertMulti(const Key& key, const Value& value) {
-  Node* new_node = new Node(key, value);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename RBTree<Key, Value, Compare, Allocator>::Node*, bool>
+RBTree<Key, Value, Compare, Allocator>::insertMulti(const Key& key,
+                                                    const Value& value) {
+  return std::make_pair(emplaceMulti(key, value), true);
+}
+
+// Сначала спуск по дереву, и только при отсутствии ключа - выделение узла
+// и построение значения из args
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename... Args>
+std::pair<typename RBTree<Key, Value, Compare, Allocator>::Node*, bool>
+RBTree<Key, Value, Compare, Allocator>::tryEmplace(K&& key, Args&&... args) {
   Node* parent_node = nullptr;
-  Node* find_place_node = root;
+  bool as_left = false;
+  if (Node* found = findInsertPos(key, parent_node, as_left)) {
+    return std::make_pair(found, false);
+  }
+  Node* new_node =
+      createNode(std::forward<K>(key), std::forward<Args>(args)...);
+  attachNode(new_node, parent_node, as_left);
+  return std::make_pair(new_node, true);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename... Args>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::emplaceMulti(K&& key, Args&&... args) {
+  Node* parent_node = nullptr;
+  bool as_left = false;
+  findMultiInsertPos(key, parent_node, as_left);
+  Node* new_node =
+      createNode(std::forward<K>(key), std::forward<Args>(args)...);
+  attachNode(new_node, parent_node, as_left);
+  return new_node;
+}
 
-  while (find_place_node != nullptr) {
-    parent_node = find_place_node;
-    if (new_node->key < find_place_node->key)
-      find_place_node = find_place_node->left;
-    else
-      find_place_node = find_place_node->right;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+void RBTree<Key, Value, Compare, Allocator>::findMultiInsertPos(
+    const K& key, Node*& parent, bool& as_left) const {
+  parent = nullptr;
+  as_left = false;
+  for (Node* current = root; current != nullptr;) {
+    parent = current;
+    as_left = keyLess(key, current->key());
+    current = as_left ? current->left : current->right;
   }
+}
 
-  new_node->parent = parent_node;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::eraseAt(const_iterator pos) {
+  Node* node = const_cast<Node*>(pos.current);
+  if (node == nullptr) return;
+  unlinkNode(node);
+  destroyNode(node);
+}
 
-  if (parent_node == nullptr)
-    root = new_node;
-  else if (new_node->key < parent_node->key)
-    parent_node->left = new_node;
-  else
-    parent_node->right = new_node;
+// Узел для NodeHandle строится до вырезания, так что исключение при
+// выделении или копировании оставляет дерево прежним
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::NodeHandle
+RBTree<Key, Value, Compare, Allocator>::extractAt(const_iterator pos) {
+  Node* node = const_cast<Node*>(pos.current);
+  if (node == nullptr) return NodeHandle();
+  Node* loose = node->pooled ? createFromNode(node, true) : node;
+  unlinkNode(node);
+  if (loose != node) destroyNode(node);
+  return NodeHandle(loose, alloc_);
+}
 
-  new_node->color = RED;
-  insertFixup(new_node);
-  node_count++;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::NodeHandle
+RBTree<Key, Value, Compare, Allocator>::extractKey(const Key& key) {
+  Node* node = lowerBoundNode(key);
+  if (node == nullptr || keyLess(key, node->key())) return NodeHandle();
+  return extractAt(const_iterator(this, node));
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename RBTree<Key, Value, Compare, Allocator>::Node*, bool>
+RBTree<Key, Value, Compare, Allocator>::insertHandle(NodeHandle& handle,
+                                                     bool unique) {
+  Node* node = handle.node_;
+  if (node == nullptr) return {nullptr, false};
+  Node* parent = nullptr;
+  bool as_left = false;
+  if (unique) {
+    if (Node* found = findInsertPos(node->key(), parent, as_left)) {
+      return {found, false};
+    }
+  } else {
+    findMultiInsertPos(node->key(), parent, as_left);
+  }
+  handle.node_ = nullptr;
+  handle.alloc_.reset();
+  node->left = node->right = nullptr;
+  node->size = 1;
+  attachNode(node, parent, as_left);
+  return {node, true};
+}
+
+// Соседние узлы в порядке обхода
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::nextNode(Node* node) {
+  if (node->right) {
+    node = node->right;
+    while (node->left) node = node->left;
+    return node;
+  }
+  while (node->parent && node == node->parent->right) node = node->parent;
+  return node->parent;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::prevNode(Node* node) {
+  if (node->left) {
+    node = node->left;
+    while (node->right) node = node->right;
+    return node;
+  }
+  while (node->parent && node == node->parent->left) node = node->parent;
+  return node->parent;
+}
+
+// Проверка, встает ли key между соседями подсказки. Между соседними
+// узлами prev и next всегда есть свободная ссылка: левая у next, если она
+// пуста, иначе правая у prev (prev - максимум левого поддерева next)
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool RBTree<Key, Value, Compare, Allocator>::findHintPos(Node* hint,
+                                                         const Key& key,
+                                                         bool unique,
+                                                         Node*& parent,
+                                                         bool& as_left) const {
+  Node* prev = nullptr;
+  Node* next = nullptr;
+  // Прямо перед hint: prev <= key <= hint (строго для уникальных ключей)
+  Node* before = hint ? prevNode(hint) : rightmost_;
+  bool fits_hint = !hint || (unique ? keyLess(key, hint->key())
+                                    : !keyLess(hint->key(), key));
+  bool fits_before = !before || (unique ? keyLess(before->key(), key)
+                                        : !keyLess(key, before->key()));
+  if (fits_hint && fits_before) {
+    prev = before;
+    next = hint;
+  } else if (unique && hint && keyLess(hint->key(), key)) {
+    // Сразу после hint: типичный случай вставки по возрастанию
+    Node* after = nextNode(hint);
+    if (after && !keyLess(key, after->key())) return false;
+    prev = hint;
+    next = after;
+  } else {
+    return false;
+  }
+  if (next && next->left == nullptr) {
+    parent = next;
+    as_left = true;
+  } else {
+    parent = prev;
+    as_left = false;
+  }
+  return true;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename... Args>
+std::pair<typename RBTree<Key, Value, Compare, Allocator>::Node*, bool>
+RBTree<Key, Value, Compare, Allocator>::tryEmplaceHint(iterator hint, K&& key,
+                                                       Args&&... args) {
+  Node* parent_node = nullptr;
+  bool as_left = false;
+  if (!findHintPos(hint.current, key, true, parent_node, as_left)) {
+    return tryEmplace(std::forward<K>(key), std::forward<Args>(args)...);
+  }
+  Node* new_node =
+      createNode(std::forward<K>(key), std::forward<Args>(args)...);
+  attachNode(new_node, parent_node, as_left);
   return std::make_pair(new_node, true);
 }
 
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename... Args>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::emplaceMultiHint(iterator hint, K&& key,
+                                                         Args&&... args) {
+  Node* parent_node = nullptr;
+  bool as_left = false;
+  if (!findHintPos(hint.current, key, false, parent_node, as_left)) {
+    return emplaceMulti(std::forward<K>(key), std::forward<Args>(args)...);
+  }
+  Node* new_node =
+      createNode(std::forward<K>(key), std::forward<Args>(args)...);
+  attachNode(new_node, parent_node, as_left);
+  return new_node;
+}
+
 // Балансировка дерева при вставке узла
-template <typename Key, typename Value>
-void RBTree<Key, Value>::insertFixup(Node* node) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool RBTree<Key, Value, Compare, Allocator>::insertFixup(Node* node) {
   while (node->parent && node->parent->color == RED) {
     if (node->parent == node->parent->parent->left) {
       Node* uncle_node = node->parent->parent->right;
@@ -155,12 +1086,14 @@ void RBTree<Key, Value>::insertFixup(Node* node) {
       }
     }
   }
+  bool grew = root->color == RED;
   root->color = BLACK;
+  return grew;
 }
 
 // Левый поворот дерев
-template <typename Key, typename Value>
-void RBTree<Key, Value>::leftRotate(Node* node) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::leftRotate(Node* node) {
   Node* new_parent = node->right;
   node->right = new_parent->left;
   if (new_parent->left != nullptr) {
@@ -176,11 +1109,13 @@ void RBTree<Key, Value>::leftRotate(Node* node) {
   }
   new_parent->left = node;
   node->parent = new_parent;
+  new_parent->size = node->size;
+  updateSize(node);
 }
 
 // Правый поворот дерева
-template <typename Key, typename Value>
-void RBTree<Key, Value>::rightRotate(Node* node) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::rightRotate(Node* node) {
   Node* new_parent = node->left;
   node->left = new_parent->right;
   if (new_parent->right != nullptr) {
@@ -196,54 +1131,70 @@ void RBTree<Key, Value>::rightRotate(Node* node) {
   }
   new_parent->right = node;
   node->parent = new_parent;
+  new_parent->size = node->size;
+  updateSize(node);
 }
 
 // Поиск минимального узла
-template <typename Key, typename Value>
-typename RBTree<Key, Value>::Node* RBTree<Key, Value>::minimum(
-    Node* node) const {
-  while (node->left != nullptr) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::minimum(Node* node) const {
+  while (node && node->left != nullptr) {
     node = node->left;
   }
   return node;
 }
 
 // Поиск максимального узла
-template <typename Key, typename Value>
-typename RBTree<Key, Value>::Node* RBTree<Key, Value>::maximum(
-    Node* node) const {
-  while (node->right != nullptr) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::maximum(Node* node) const {
+  while (node && node->right != nullptr) {
     node = node->right;
   }
   return node;
 }
 
 // Проверка на существование узла
-template <typename Key, typename Value>
-bool RBTree<Key, Value>::contains(const Key& key) const {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool RBTree<Key, Value, Compare, Allocator>::contains(const Key& key) const {
   return findNode(key) != nullptr;
 }
 
 // Количество узлов в дереве
-template <typename Key, typename Value>
-typename RBTree<Key, Value>::size_type RBTree<Key, Value>::size() const {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::size_type
+RBTree<Key, Value, Compare, Allocator>::size() const {
   return node_count;
 }
 
 // Удаление узла по ключу
-template <typename Key, typename Value>
-void RBTree<Key, Value>::erase(const Key& key) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::erase(const Key& key) {
   Node* node = findNode(key);
   if (node == nullptr) return;
+  unlinkNode(node);
+  destroyNode(node);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::unlinkNode(Node* node) {
+  // Узлы не переставляются, поэтому соседи остаются валидными
+  if (node == leftmost_) leftmost_ = nextNode(node);
+  if (node == rightmost_) rightmost_ = prevNode(node);
   Node* delete_node = node;
   Node* replace_node = nullptr;
+  // Родитель replace_node: сам replace_node может быть nullptr
+  Node* replace_parent = nullptr;
   Color orig_color = delete_node->color;
 
   if (node->left == nullptr) {
     replace_node = node->right;
+    replace_parent = node->parent;
     transplant(node, node->right);
   } else if (node->right == nullptr) {
     replace_node = node->left;
+    replace_parent = node->parent;
     transplant(node, node->left);
   } else {  // Есть оба потомка
     delete_node = minimum(node->right);
@@ -251,10 +1202,11 @@ void RBTree<Key, Value>::erase(const Key& key) {
     replace_node = delete_node->right;
 
     if (delete_node->parent == node) {
-      if (replace_node) replace_node->parent = delete_node;
+      replace_parent = delete_node;
     } else {
+      replace_parent = delete_node->parent;
       transplant(delete_node, delete_node->right);
-      delete_node->right = node;
+      delete_node->right = node->right;
       delete_node->right->parent = delete_node;
     }
 
@@ -264,14 +1216,20 @@ void RBTree<Key, Value>::erase(const Key& key) {
     delete_node->color = node->color;
   }
 
-  delete node;
+  // Размеры меняются только на пути от места вырезания до корня
+  for (Node* ancestor = replace_parent; ancestor;
+       ancestor = ancestor->parent) {
+    updateSize(ancestor);
+  }
+
   node_count--;
-  if (orig_color == BLACK && replace_node) deleteFixup(replace_node);
+  if (orig_color == BLACK) deleteFixup(replace_node, replace_parent);
 }
 
 // Перестановка узлов местами
-template <typename Key, typename Value>
-void RBTree<Key, Value>::transplant(Node* first_node, Node* second_node) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::transplant(Node* first_node,
+                                                        Node* second_node) {
   if (first_node->parent == nullptr) {
     root = second_node;
   } else if (first_node == first_node->parent->left) {
@@ -285,92 +1243,131 @@ void RBTree<Key, Value>::transplant(Node* first_node, Node* second_node) {
   }
 }
 
-// Балансировка дерева при удалении узла
-template <typename Key, typename Value>
-void RBTree<Key, Value>::deleteFixup(Node* node) {
-  while (node != root && node->color == BLACK) {
-    Node* brother =
-        (node == node->parent->left) ? node->parent->right : node->parent->left;
-    if (node == node->parent->left) {
+// Балансировка дерева при удалении узла; отсутствующие узлы (nullptr)
+// считаются черными
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::deleteFixup(Node* node,
+                                                         Node* parent) {
+  while (node != root && isBlack(node)) {
+    if (node == parent->left) {
+      Node* brother = parent->right;
       if (brother->color == RED) {
         brother->color = BLACK;
-        node->parent->color = RED;
-        leftRotate(node->parent);
-        brother = node->parent->right;
+        parent->color = RED;
+        leftRotate(parent);
+        brother = parent->right;
+      }
+      if (isBlack(brother->left) && isBlack(brother->right)) {
+        brother->color = RED;
+        node = parent;
+        parent = node->parent;
+      } else {
+        if (isBlack(brother->right)) {
+          brother->left->color = BLACK;
+          brother->color = RED;
+          rightRotate(brother);
+          brother = parent->right;
+        }
+        brother->color = parent->color;
+        parent->color = BLACK;
+        brother->right->color = BLACK;
+        leftRotate(parent);
+        node = root;
       }
-      handleBrother(node, brother);
     } else {
+      Node* brother = parent->left;
       if (brother->color == RED) {
         brother->color = BLACK;
-        node->parent->color = RED;
-        rightRotate(node->parent);
-        brother = node->parent->left;
+        parent->color = RED;
+        rightRotate(parent);
+        brother = parent->left;
+      }
+      if (isBlack(brother->left) && isBlack(brother->right)) {
+        brother->color = RED;
+        node = parent;
+        parent = node->parent;
+      } else {
+        if (isBlack(brother->left)) {
+          brother->right->color = BLACK;
+          brother->color = RED;
+          leftRotate(brother);
+          brother = parent->left;
+        }
+        brother->color = parent->color;
+        parent->color = BLACK;
+        brother->left->color = BLACK;
+        rightRotate(parent);
+        node = root;
       }
-      handleBrother(node, brother);
-    }
-  }
-  node->color = BLACK;
-}
-
-// Проверка "брата" узла при балансировке
-template <typename Key, typename Value>
-void RBTree<Key, Value>::handleBrother(Node* node, Node* brother) {
-  if (brother->left->color == BLACK && brother->right->color == BLACK) {
-    brother->color = RED;
-    node = node->parent;
-  } else {
-    if (brother->right->color == BLACK) {
-      brother->left->color = BLACK;
-      brother->color = RED;
-      rightRotate(brother);
-      brother = node->parent->right;
     }
-    brother->color = node->parent->color;
-    node->parent->color = BLACK;
-    brother->right->color = BLACK;
-    leftRotate(node->parent);
-    node = root;
   }
+  if (node) node->color = BLACK;
 }
 
 // Перегрузка оператора = (копирующее присваивание)
-template <typename Key, typename Value>
-RBTree<Key, Value>& RBTree<Key, Value>::operator=(const RBTree& other) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+RBTree<Key, Value, Compare, Allocator>&
+RBTree<Key, Value, Compare, Allocator>::operator=(const RBTree& other) {
   if (this != &other) {
-    clear(root);
-    root = nullptr;
-    node_count = 0;
+    clear();
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+      alloc_ = other.alloc_;
+    }
+    comp_ = other.comp_;
 
     if (other.root) {
       root = copySubtree(other.root, nullptr);
       node_count = other.node_count;
+      resetBounds();
     }
   }
   return *this;
 }
 
-// Перегрузка оператора = (перемещающее присваивание)
-template <typename Key, typename Value>
-RBTree<Key, Value>& RBTree<Key, Value>::operator=(RBTree&& other) noexcept {
+// Перегрузка оператора = (перемещающее присваивание). Узлы забираются
+// целиком, только если наш аллокатор сможет их освободить; иначе дерево
+// копируется в собственные узлы
+template <typename Key, typename Value, typename Compare, typename Allocator>
+RBTree<Key, Value, Compare, Allocator>&
+RBTree<Key, Value, Compare, Allocator>::operator=(RBTree&& other) noexcept(
+    node_traits::propagate_on_container_move_assignment::value ||
+    node_traits::is_always_equal::value) {
   if (this != &other) {
-    clear(root);
-    root = other.root;
-    node_count = other.node_count;
+    clear();
+    comp_ = other.comp_;
+    if (node_traits::propagate_on_container_move_assignment::value ||
+        alloc_ == other.alloc_) {
+      if constexpr (node_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = std::move(other.alloc_);
+      }
+      pool_.swap(other.pool_);
+      root = other.root;
+      leftmost_ = other.leftmost_;
+      rightmost_ = other.rightmost_;
+      node_count = other.node_count;
 
-    other.root = nullptr;
-    other.node_count = 0;
+      other.root = other.leftmost_ = other.rightmost_ = nullptr;
+      other.node_count = 0;
+    } else if (other.root) {
+      root = copySubtree(other.root, nullptr);
+      node_count = other.node_count;
+      resetBounds();
+      other.clear();
+    }
   }
   return *this;
 }
 
 // Копирование узла
-template <typename Key, typename Value>
-typename RBTree<Key, Value>::Node* RBTree<Key, Value>::copySubtree(
-    Node* node, Node* parent) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::copySubtree(Node* node, Node* parent) {
   if (node == nullptr) return nullptr;
 
-  Node* new_node = new Node(node->key);
+  Node* new_node = createFromEntry(node->data);
   new_node->color = node->color;
+  new_node->size = node->size;
   new_node->parent = parent;
 
   new_node->left = copySubtree(node->left, new_node);
@@ -380,8 +1377,8 @@ typename RBTree<Key, Value>::Node* RBTree<Key, Value>::copySubtree(
 }
 
 // Вспомогательные функции для вывода дерева в консоль
-template <typename Key, typename Value>
-void RBTree<Key, Value>::print() const {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::print() const {
   if (root == nullptr)
     std::cout << "Tree is empty!" << std::endl;
   else {
@@ -390,9 +1387,10 @@ void RBTree<Key, Value>::print() const {
   }
 }
 
-template <typename Key, typename Value>
-void RBTree<Key, Value>::printTree(Node* node, char prefix[],
-                                   bool isLeft) const {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void RBTree<Key, Value, Compare, Allocator>::printTree(Node* node,
+                                                       char prefix[],
+                                                       bool isLeft) const {
   if (node != nullptr) {
     char newPrefix[1000];
     strcpy(newPrefix, prefix);
@@ -402,9 +1400,9 @@ void RBTree<Key, Value>::printTree(Node* node, char prefix[],
       printTree(node->right, newPrefix, false);
       strcpy(newPrefix, prefix);
     }
-    std::cout << prefix << (isLeft ? "└── " : "┌── ") << node->key << " | "
-              << node->value << (node->color == RED ? " (R)" : " (B)")
-              << std::endl;
+    std::cout << prefix << (isLeft ? "└── " : "┌── ") << node->key();
+    if constexpr (!key_only) std::cout << " | " << node->value();
+    std::cout << (node->color == RED ? " (R)" : " (B)") << std::endl;
     strcpy(newPrefix, prefix);
     strcat(newPrefix, (isLeft ? "    " : "│   "));
     if (node->left) {
@@ -414,8 +1412,9 @@ void RBTree<Key, Value>::printTree(Node* node, char prefix[],
 }
 
 // Реализация методов для итератора
-template <typename Key, typename Value>
-typename RBTree<Key, Value>::Node* RBTree<Key, Value>::iterator::treeMinimum(
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::iterator::treeMinimum(
     Node* node) const {
   while (node && node->left) {
     node = node->left;
@@ -423,8 +1422,9 @@ typename RBTree<Key, Value>::Node* RBTree<Key, Value>::iterator::treeMinimum(
   return node;
 }
 
-template <typename Key, typename Value>
-typename RBTree<Key, Value>::Node* RBTree<Key, Value>::iterator::treeMaximum(
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::iterator::treeMaximum(
     Node* node) const {
   while (node && node->right) {
     node = node->right;
@@ -433,9 +1433,9 @@ typename RBTree<Key, Value>::Node* RBTree<Key, Value>::iterator::treeMaximum(
 }
 
 // Поиск следующего узла
-template <typename Key, typename Value>
-typename RBTree<Key, Value>::Node* RBTree<Key, Value>::iterator::successor(
-    Node* node) const {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::iterator::successor(Node* node) const {
   if (node->right) {
     return treeMinimum(node->right);
   }
@@ -448,8 +1448,9 @@ typename RBTree<Key, Value>::Node* RBTree<Key, Value>::iterator::successor(
 }
 
 // Поиск предыдущего узла
-template <typename Key, typename Value>
-typename RBTree<Key, Value>::Node* RBTree<Key, Value>::iterator::predecessor(
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::iterator::predecessor(
     Node* node) const {
   if (node->left) {
     return treeMaximum(node->left);
@@ -463,27 +1464,30 @@ typename RBTree<Key, Value>::Node* RBTree<Key, Value>::iterator::predecessor(
 }
 
 // Реализация константных методов для итератора
-template <typename Key, typename Value>
-const typename RBTree<Key, Value>::Node*
-RBTree<Key, Value>::const_iterator::treeMinimum(const Node* node) const {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::const_iterator::treeMinimum(
+    const Node* node) const {
   while (node && node->left) {
     node = node->left;
   }
   return node;
 }
 
-template <typename Key, typename Value>
-const typename RBTree<Key, Value>::Node*
-RBTree<Key, Value>::const_iterator::treeMaximum(const Node* node) const {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::const_iterator::treeMaximum(
+    const Node* node) const {
   while (node && node->right) {
     node = node->right;
   }
   return node;
 }
 
-template <typename Key, typename Value>
-const typename RBTree<Key, Value>::Node*
-RBTree<Key, Value>::const_iterator::successor(const Node* node) const {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::const_iterator::successor(
+    const Node* node) const {
   if (node->right) {
     return treeMinimum(node->right);
   }
@@ -495,9 +1499,10 @@ RBTree<Key, Value>::const_iterator::successor(const Node* node) const {
   return parent;
 }
 
-template <typename Key, typename Value>
-const typename RBTree<Key, Value>::Node*
-RBTree<Key, Value>::const_iterator::predecessor(const Node* node) const {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const typename RBTree<Key, Value, Compare, Allocator>::Node*
+RBTree<Key, Value, Compare, Allocator>::const_iterator::predecessor(
+    const Node* node) const {
   if (node->left) {
     return treeMaximum(node->left);
   }
@@ -510,35 +1515,30 @@ RBTree<Key, Value>::const_iterator::predecessor(const Node* node) const {
 }
 
 // Возврат значения по ключу
-template <typename Key, typename Value>
-Value& RBTree<Key, Value>::at(const Key& key) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Value& RBTree<Key, Value, Compare, Allocator>::at(const Key& key) {
   Node* node = findNode(key);
   if (node) {
-    return node->value;
+    return node->value();
   } else {
     throw std::out_of_range("Key not found in map");
   }
 }
 
-template <typename Key, typename Value>
-const Value& RBTree<Key, Value>::at(const Key& key) const {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const Value& RBTree<Key, Value, Compare, Allocator>::at(const Key& key) const {
   Node* node = findNode(key);
   if (node) {
-    return node->value;
+    return node->value();
   } else {
     throw std::out_of_range("Key not found in map");
   }
 }
 
 // Вставка или изменение существующего ключа
-template <typename Key, typename Value>
-Value& RBTree<Key, Value>::getOrInsert(const Key& key) {
-  Node* node = findNode(key);
-  if (node) {
-    return node->value;
-  }
-  auto [new_node, inserted] = insert(key, Value{});
-  return new_node->value;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Value& RBTree<Key, Value, Compare, Allocator>::getOrInsert(const Key& key) {
+  return tryEmplace(key).first->value();
 }
 
 #endif
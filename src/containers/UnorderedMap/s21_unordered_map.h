@@ -0,0 +1,191 @@
+#ifndef S21_UNORDERED_MAP_H
+#define S21_UNORDERED_MAP_H
+
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../HashTable/s21_hash_table.h"
+
+namespace s21 {
+// Хеш-словарь с открытой адресацией: тот же интерфейс, что у map, но
+// поиск в среднем O(1) и без обхода указателей. Ключи и значения лежат в
+// ячейках таблицы, пары std::pair<const Key, T> в памяти нет, и итератор
+// отдает пару ссылок на ключ и значение. Порядок обхода не определен.
+// Итераторы становятся недействительными после любой вставки
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class unordered_map : public HashTable<Key, T, Hash, KeyEqual, Allocator> {
+  using table_type = HashTable<Key, T, Hash, KeyEqual, Allocator>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = std::pair<const Key&, T&>;
+  using const_reference = std::pair<const Key&, const T&>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  // Итератор по элементам; IsConst выбирает константный вариант
+  template <bool IsConst>
+  class UnorderedMapIterator {
+    friend class unordered_map;
+    template <bool>
+    friend class UnorderedMapIterator;
+    using table_iterator =
+        std::conditional_t<IsConst, typename table_type::const_iterator,
+                           typename table_type::iterator>;
+
+   private:
+    table_iterator table_iter;
+    // Ячейка за последней; разыменовать end() нельзя
+    size_type end_index;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<IsConst, const_reference,
+                                         unordered_map::reference>;
+    // it->second работает через временную пару ссылок
+    struct pointer {
+      reference ref;
+      const reference* operator->() const { return &ref; }
+    };
+
+    UnorderedMapIterator() : table_iter(), end_index(0) {}
+    UnorderedMapIterator(table_iterator iter, size_type end_index)
+        : table_iter(iter), end_index(end_index) {}
+    template <bool C = IsConst, typename = std::enable_if_t<C>>
+    UnorderedMapIterator(const UnorderedMapIterator<false>& other)
+        : table_iter(other.table_iter), end_index(other.end_index) {}
+
+    reference operator*() const {
+      if (table_type::indexOf(table_iter) == end_index) {
+        throw std::out_of_range("Iterator is out of range or uninitialized.");
+      }
+      return reference(table_iter.key(), table_iter.value());
+    }
+    pointer operator->() const { return pointer{**this}; }
+    UnorderedMapIterator& operator++() {
+      ++table_iter;
+      return *this;
+    }
+    UnorderedMapIterator operator++(int) {
+      UnorderedMapIterator temp = *this;
+      ++table_iter;
+      return temp;
+    }
+    friend bool operator==(const UnorderedMapIterator& left,
+                           const UnorderedMapIterator& right) {
+      return left.table_iter == right.table_iter;
+    }
+    friend bool operator!=(const UnorderedMapIterator& left,
+                           const UnorderedMapIterator& right) {
+      return left.table_iter != right.table_iter;
+    }
+  };
+  using iterator = UnorderedMapIterator<false>;
+  using const_iterator = UnorderedMapIterator<true>;
+  iterator begin() { return wrap(table_type::begin()); }
+  iterator end() { return wrap(table_type::end()); }
+  const_iterator begin() const { return wrap(table_type::begin()); }
+  const_iterator end() const { return wrap(table_type::end()); }
+
+  // Конструкторы и деструктор
+  unordered_map() : table_type() {}
+  explicit unordered_map(const Allocator& alloc) : table_type(alloc) {}
+  explicit unordered_map(size_type bucket_count, const Hash& hash = Hash(),
+                         const KeyEqual& equal = KeyEqual(),
+                         const Allocator& alloc = Allocator())
+      : table_type(bucket_count, hash, equal, alloc) {}
+  unordered_map(std::initializer_list<value_type> const& items,
+                const Allocator& alloc = Allocator());
+  unordered_map(const unordered_map& m) : table_type(m) {}
+  unordered_map(unordered_map&& m) noexcept : table_type(s21::move(m)) {}
+  ~unordered_map() = default;
+
+  // Перегрузки операторов
+  unordered_map& operator=(const unordered_map& m);
+  unordered_map& operator=(unordered_map&& m) noexcept(
+      std::is_nothrow_move_assignable<table_type>::value);
+
+  // Методы класса
+  T& at(const Key& key);
+  const T& at(const Key& key) const;
+  T& operator[](const Key& key) {
+    return table_type::tryEmplace(key).first.value();
+  }
+  iterator find(const key_type& key) {
+    return wrap(table_type::findKey(key));
+  }
+  const_iterator find(const key_type& key) const {
+    return wrap(typename table_type::const_iterator(table_type::findKey(key)));
+  }
+  // Поиск по ключу другого типа без построения Key; только если и Hash, и
+  // KeyEqual прозрачны (например, для std::string_view)
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = typename H::is_transparent,
+            typename = typename E::is_transparent>
+  iterator find(const K& key) {
+    return wrap(table_type::findKey(key));
+  }
+  bool contains(const Key& key) const {
+    return table_type::containsKey(key);
+  }
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = typename H::is_transparent,
+            typename = typename E::is_transparent>
+  bool contains(const K& key) const {
+    return table_type::containsKey(key);
+  }
+  size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+  size_type max_size() const { return std::numeric_limits<size_type>::max(); }
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return insert(value.first, value.second);
+  }
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return try_emplace(key, obj);
+  }
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj);
+  // Значение строится из args, только если ключа еще нет
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  // Подсказка принимается ради совместимости с map; в хеш-таблице ей
+  // нечего подсказывать
+  iterator insert(iterator, const value_type& value) {
+    return insert(value).first;
+  }
+  template <typename... Args>
+  iterator emplace_hint(iterator, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+  void erase(iterator pos);
+  size_type erase(const Key& key) { return table_type::eraseKey(key); }
+  void swap(unordered_map& other) { table_type::swap(other); }
+  void merge(unordered_map& other);
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+ private:
+  iterator wrap(typename table_type::iterator iter) {
+    return iterator(iter, this->bucket_count());
+  }
+  const_iterator wrap(typename table_type::const_iterator iter) const {
+    return const_iterator(iter, this->bucket_count());
+  }
+};
+}  // namespace s21
+
+#include "s21_unordered_map.tpp"
+
+#endif
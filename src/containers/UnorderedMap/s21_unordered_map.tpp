@@ -0,0 +1,168 @@
+#ifndef S21_UNORDERED_MAP_TPP
+#define S21_UNORDERED_MAP_TPP
+
+#include "s21_unordered_map.h"
+
+namespace s21 {
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::unordered_map(
+    std::initializer_list<value_type> const& items, const Allocator& alloc)
+    : table_type(alloc) {
+  this->reserve(items.size());
+  for (const auto& item : items) {
+    this->insert(item.first, item.second);
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>&
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::operator=(
+    const unordered_map& m) {
+  if (this != &m) {
+    table_type::operator=(m);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>&
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::operator=(
+    unordered_map&& m) noexcept(std::is_nothrow_move_assignable<
+                                table_type>::value) {
+  if (this != &m) {
+    table_type::operator=(s21::move(m));
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+T& unordered_map<Key, T, Hash, KeyEqual, Allocator>::at(const Key& key) {
+  auto it = table_type::findKey(key);
+  if (it == table_type::end()) {
+    throw std::out_of_range("Key not found in map");
+  }
+  return it.value();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+const T& unordered_map<Key, T, Hash, KeyEqual, Allocator>::at(
+    const Key& key) const {
+  auto it = table_type::findKey(key);
+  if (it == table_type::end()) {
+    throw std::out_of_range("Key not found in map");
+  }
+  return it.value();
+}
+
+// Вставка или изменение существующего значения
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::insert_or_assign(
+    const Key& key, const T& obj) {
+  auto result = table_type::tryEmplace(key, obj);
+  if (!result.second) {
+    result.first.value() = obj;
+  }
+  return {wrap(result.first), result.second};
+}
+
+// Вставка с построением значения на месте
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::try_emplace(
+    const Key& key, Args&&... args) {
+  auto [it, inserted] =
+      table_type::tryEmplace(key, std::forward<Args>(args)...);
+  return {wrap(it), inserted};
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::try_emplace(
+    Key&& key, Args&&... args) {
+  auto [it, inserted] =
+      table_type::tryEmplace(s21::move(key), std::forward<Args>(args)...);
+  return {wrap(it), inserted};
+}
+
+// Как map::emplace
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::emplace(Args&&... args) {
+  std::pair<Key, T> value(std::forward<Args>(args)...);
+  return try_emplace(s21::move(value.first), s21::move(value.second));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void unordered_map<Key, T, Hash, KeyEqual, Allocator>::erase(iterator pos) {
+  if (pos != end()) {
+    table_type::eraseAt(pos.table_iter);
+  }
+}
+
+// Слияние с той же семантикой, что у map: отсутствующие ключи
+// переносятся из other, а у общих ключей значение в this заменяется
+// значением из other, и сами они остаются в other. Удаление из other не
+// перестраивает его таблицу, так что обход продолжается с того же места
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void unordered_map<Key, T, Hash, KeyEqual, Allocator>::merge(
+    unordered_map& other) {
+  if (this == &other) return;
+  this->reserve(this->size() + other.size());
+  for (auto it = other.table_type::begin(); it != other.table_type::end();) {
+    auto current = it++;
+    Key& key = const_cast<Key&>(current.key());
+    auto [mine, inserted] = table_type::tryEmplace(
+        std::move_if_noexcept(key), std::move_if_noexcept(current.value()));
+    if (inserted) {
+      other.eraseAt(current);
+    } else {
+      mine.value() = current.value();
+    }
+  }
+}
+
+// Множественная вставка. Следующая вставка может перестроить таблицу,
+// поэтому итераторы ищутся заново после всех вставок
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::vector<std::pair<
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator, bool>>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::insert_many(
+    Args&&... args) {
+  std::vector<std::pair<iterator, bool>> results;
+  std::vector<Key> keys;
+  results.reserve(sizeof...(Args));
+  keys.reserve(sizeof...(Args));
+  (..., [&](auto&& arg) {
+    auto [it, inserted] = this->insert(std::forward<decltype(arg)>(arg));
+    keys.push_back(it.table_iter.key());
+    results.emplace_back(it, inserted);
+  }(std::forward<Args>(args)));
+  for (size_t i = 0; i < keys.size(); ++i) {
+    results[i].first = find(keys[i]);
+  }
+  return results;
+}
+}  // namespace s21
+
+#endif
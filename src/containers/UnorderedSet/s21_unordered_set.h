@@ -0,0 +1,108 @@
+#ifndef S21_UNORDERED_SET_H
+#define S21_UNORDERED_SET_H
+
+#include <initializer_list>
+#include <limits>
+#include <vector>
+
+#include "../HashTable/s21_hash_table.h"
+
+namespace s21 {
+// Хеш-множество с открытой адресацией: тот же интерфейс, что у set, кроме
+// поиска границ, но поиск в среднем O(1). Порядок обхода не определен.
+// Итераторы становятся недействительными после любой вставки
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class unordered_set
+    : public HashTable<Key, tree_key_only, Hash, KeyEqual, Allocator> {
+  using table_type = HashTable<Key, tree_key_only, Hash, KeyEqual, Allocator>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  // Конструкторы и деструктор
+  unordered_set() : table_type() {}
+  explicit unordered_set(const Allocator& alloc) : table_type(alloc) {}
+  explicit unordered_set(size_type bucket_count, const Hash& hash = Hash(),
+                         const KeyEqual& equal = KeyEqual(),
+                         const Allocator& alloc = Allocator())
+      : table_type(bucket_count, hash, equal, alloc) {}
+  unordered_set(std::initializer_list<value_type> const& items,
+                const Allocator& alloc = Allocator());
+  unordered_set(const unordered_set& s) : table_type(s) {}
+  unordered_set(unordered_set&& s) noexcept : table_type(s21::move(s)) {}
+  ~unordered_set() = default;
+
+  // Перегрузки операторов
+  unordered_set& operator=(unordered_set&& s) noexcept(
+      std::is_nothrow_move_assignable<table_type>::value);
+  unordered_set& operator=(const unordered_set& s);
+
+  // Методы класса
+  size_type max_size() const { return std::numeric_limits<size_type>::max(); }
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return table_type::tryEmplace(value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return table_type::tryEmplace(s21::move(value));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  // Подсказка не используется, как в unordered_map::insert(iterator, value)
+  iterator insert(iterator, const value_type& value) {
+    return insert(value).first;
+  }
+  template <typename... Args>
+  iterator emplace_hint(iterator, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+  void erase(iterator pos);
+  size_type erase(const key_type& key) { return table_type::eraseKey(key); }
+  void swap(unordered_set& other) { table_type::swap(other); }
+  void merge(unordered_set& other);
+  iterator find(const key_type& key) { return table_type::findKey(key); }
+  const_iterator find(const key_type& key) const {
+    return table_type::findKey(key);
+  }
+  bool contains(const key_type& key) const {
+    return table_type::containsKey(key);
+  }
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+  // Поиск по значению другого типа без построения Key; только если и
+  // Hash, и KeyEqual прозрачны
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = typename H::is_transparent,
+            typename = typename E::is_transparent>
+  iterator find(const K& key) {
+    return table_type::findKey(key);
+  }
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = typename H::is_transparent,
+            typename = typename E::is_transparent>
+  const_iterator find(const K& key) const {
+    return table_type::findKey(key);
+  }
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = typename H::is_transparent,
+            typename = typename E::is_transparent>
+  bool contains(const K& key) const {
+    return table_type::containsKey(key);
+  }
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+};
+}  // namespace s21
+
+#include "s21_unordered_set.tpp"
+
+#endif  // S21_UNORDERED_SET_H
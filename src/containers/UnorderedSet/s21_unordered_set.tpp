@@ -0,0 +1,88 @@
+#ifndef S21_UNORDERED_SET_TPP
+#define S21_UNORDERED_SET_TPP
+
+#include "s21_unordered_set.h"
+
+namespace s21 {
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+unordered_set<Key, Hash, KeyEqual, Allocator>::unordered_set(
+    std::initializer_list<value_type> const& items, const Allocator& alloc)
+    : table_type(alloc) {
+  this->reserve(items.size());
+  for (const auto& item : items) {
+    this->insert(item);
+  }
+}
+
+// Перегрузки оператора присвоения
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+unordered_set<Key, Hash, KeyEqual, Allocator>&
+unordered_set<Key, Hash, KeyEqual, Allocator>::operator=(
+    unordered_set&& s) noexcept(std::is_nothrow_move_assignable<
+                                table_type>::value) {
+  if (this != &s) {
+    table_type::operator=(s21::move(s));
+  }
+  return *this;
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+unordered_set<Key, Hash, KeyEqual, Allocator>&
+unordered_set<Key, Hash, KeyEqual, Allocator>::operator=(
+    const unordered_set& s) {
+  if (this != &s) {
+    table_type::operator=(s);
+  }
+  return *this;
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename... Args>
+std::pair<typename unordered_set<Key, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_set<Key, Hash, KeyEqual, Allocator>::emplace(Args&&... args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void unordered_set<Key, Hash, KeyEqual, Allocator>::erase(iterator pos) {
+  if (pos != this->end()) {
+    table_type::eraseAt(pos);
+  }
+}
+
+// Слияние, как у set: все ключи other вставляются, other очищается
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void unordered_set<Key, Hash, KeyEqual, Allocator>::merge(
+    unordered_set& other) {
+  if (this == &other) return;
+  this->reserve(this->size() + other.size());
+  for (auto it = other.begin(); it != other.end(); ++it) {
+    this->insert(std::move_if_noexcept(const_cast<Key&>(*it)));
+  }
+  other.clear();
+}
+
+// Итераторы ищутся заново, как в unordered_map::insert_many
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename... Args>
+std::vector<std::pair<
+    typename unordered_set<Key, Hash, KeyEqual, Allocator>::iterator, bool>>
+unordered_set<Key, Hash, KeyEqual, Allocator>::insert_many(Args&&... args) {
+  std::vector<std::pair<iterator, bool>> result;
+  std::vector<Key> keys;
+  result.reserve(sizeof...(Args));
+  keys.reserve(sizeof...(Args));
+  (..., [&](auto&& arg) {
+    auto [it, inserted] = this->insert(std::forward<decltype(arg)>(arg));
+    keys.push_back(*it);
+    result.emplace_back(it, inserted);
+  }(std::forward<Args>(args)));
+  for (size_t i = 0; i < keys.size(); ++i) {
+    result[i].first = find(keys[i]);
+  }
+  return result;
+}
+}  // namespace s21
+
+#endif  // S21_UNORDERED_SET_TPP
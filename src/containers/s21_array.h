@@ -27,18 +27,19 @@ class array {
 
   array& operator=(array&& other) noexcept;
 
-  reference at(size_type pos);
-  reference operator[](size_type pos);
-  const_reference front() const;
-  const_reference back() const;
-  iterator data();
+  constexpr reference at(size_type pos);
+  constexpr reference operator[](size_type pos);
+  constexpr const_reference front() const;
+  constexpr const_reference back() const;
+  constexpr iterator data();
+  constexpr const_iterator data() const;
 
-  iterator begin();
-  iterator end();
+  constexpr iterator begin();
+  constexpr iterator end();
 
-  bool empty() const;
-  size_type size() const;
-  size_type max_size() const;
+  constexpr bool empty() const;
+  constexpr size_type size() const;
+  constexpr size_type max_size() const;
 
   void swap(array& other);
   void fill(const_reference value);
@@ -79,53 +80,59 @@ inline array<T, N>& array<T, N>::operator=(array&& other) noexcept {
 }
 
 template <typename T, size_t N>
-inline typename array<T, N>::reference array<T, N>::at(size_type pos) {
+constexpr typename array<T, N>::reference array<T, N>::at(size_type pos) {
   if (pos >= N) throw std::out_of_range("index out of range");
   return data_[pos];
 }
 
 template <typename T, size_t N>
-inline typename array<T, N>::reference array<T, N>::operator[](size_type pos) {
+constexpr typename array<T, N>::reference array<T, N>::operator[](
+    size_type pos) {
   return data_[pos];
 }
 
 template <typename T, size_t N>
-inline typename array<T, N>::const_reference array<T, N>::front() const {
+constexpr typename array<T, N>::const_reference array<T, N>::front() const {
   return data_[0];
 }
 
 template <typename T, size_t N>
-inline typename array<T, N>::const_reference array<T, N>::back() const {
+constexpr typename array<T, N>::const_reference array<T, N>::back() const {
   return data_[N - 1];
 }
 
 template <typename T, size_t N>
-inline typename array<T, N>::iterator array<T, N>::data() {
+constexpr typename array<T, N>::iterator array<T, N>::data() {
   return data_;
 }
 
 template <typename T, size_t N>
-inline typename array<T, N>::iterator array<T, N>::begin() {
+constexpr typename array<T, N>::const_iterator array<T, N>::data() const {
   return data_;
 }
 
 template <typename T, size_t N>
-inline typename array<T, N>::iterator array<T, N>::end() {
+constexpr typename array<T, N>::iterator array<T, N>::begin() {
+  return data_;
+}
+
+template <typename T, size_t N>
+constexpr typename array<T, N>::iterator array<T, N>::end() {
   return data_ + N;
 }
 
 template <typename T, size_t N>
-inline bool array<T, N>::empty() const {
+constexpr bool array<T, N>::empty() const {
   return N == 0;
 }
 
 template <typename T, size_t N>
-inline typename array<T, N>::size_type array<T, N>::size() const {
+constexpr typename array<T, N>::size_type array<T, N>::size() const {
   return N;
 }
 
 template <typename T, size_t N>
-inline typename array<T, N>::size_type array<T, N>::max_size() const {
+constexpr typename array<T, N>::size_type array<T, N>::max_size() const {
   return N;
 }
 
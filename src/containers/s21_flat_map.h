@@ -0,0 +1,615 @@
+#ifndef S21_FLAT_MAP_H
+#define S21_FLAT_MAP_H
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Tree/s21_tree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Sorted-vector map for data that is built once and read many times. Keys
+// and values live in two separate s21::vectors, so a lookup binary-searches
+// a dense array of keys only and the map costs no more than its elements.
+// There is no std::pair<const Key, T> in memory: iterators yield a pair of
+// references to the key and the value. Inserting or erasing one element
+// shifts the tail: O(n). Build large maps in bulk with the range
+// constructor or insert(first, last), which sort and deduplicate in
+// O(n log n). Any modification invalidates iterators.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class flat_map {
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = std::pair<const Key &, T &>;
+  using const_reference = std::pair<const Key &, const T &>;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using key_container_type =
+      s21::vector<Key, typename alloc_traits::template rebind_alloc<Key>>;
+  using mapped_container_type =
+      s21::vector<T, typename alloc_traits::template rebind_alloc<T>>;
+
+  // Random-access iterator over the two arrays; IsConst selects the
+  // read-only flavour.
+  template <bool IsConst>
+  class FlatMapIterator {
+    friend class flat_map;
+    template <bool>
+    friend class FlatMapIterator;
+    using mapped_pointer = std::conditional_t<IsConst, const T *, T *>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using reference =
+        std::conditional_t<IsConst, const_reference, flat_map::reference>;
+    // it->second works through a temporary pair of references.
+    struct pointer {
+      reference ref;
+      const reference *operator->() const { return &ref; }
+    };
+
+    FlatMapIterator() : key_(nullptr), value_(nullptr) {}
+    FlatMapIterator(const Key *key, mapped_pointer value)
+        : key_(key), value_(value) {}
+    template <bool C = IsConst, typename = std::enable_if_t<C>>
+    FlatMapIterator(const FlatMapIterator<false> &other)
+        : key_(other.key_), value_(other.value_) {}
+
+    reference operator*() const { return reference(*key_, *value_); }
+    pointer operator->() const { return pointer{**this}; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+    FlatMapIterator &operator++() {
+      ++key_;
+      ++value_;
+      return *this;
+    }
+    FlatMapIterator operator++(int) {
+      FlatMapIterator temp = *this;
+      ++*this;
+      return temp;
+    }
+    FlatMapIterator &operator--() {
+      --key_;
+      --value_;
+      return *this;
+    }
+    FlatMapIterator operator--(int) {
+      FlatMapIterator temp = *this;
+      --*this;
+      return temp;
+    }
+    FlatMapIterator &operator+=(difference_type n) {
+      key_ += n;
+      value_ += n;
+      return *this;
+    }
+    FlatMapIterator &operator-=(difference_type n) { return *this += -n; }
+    friend FlatMapIterator operator+(FlatMapIterator it, difference_type n) {
+      return it += n;
+    }
+    friend FlatMapIterator operator-(FlatMapIterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const FlatMapIterator &left,
+                                     const FlatMapIterator &right) {
+      return left.key_ - right.key_;
+    }
+    friend bool operator==(const FlatMapIterator &left,
+                           const FlatMapIterator &right) {
+      return left.key_ == right.key_;
+    }
+    friend bool operator!=(const FlatMapIterator &left,
+                           const FlatMapIterator &right) {
+      return left.key_ != right.key_;
+    }
+    friend bool operator<(const FlatMapIterator &left,
+                          const FlatMapIterator &right) {
+      return left.key_ < right.key_;
+    }
+
+   private:
+    const Key *key_;
+    mapped_pointer value_;
+  };
+  using iterator = FlatMapIterator<false>;
+  using const_iterator = FlatMapIterator<true>;
+
+  flat_map() = default;
+  explicit flat_map(const allocator_type &alloc)
+      : keys_(key_allocator(alloc)), values_(mapped_allocator(alloc)) {}
+  explicit flat_map(const Compare &comp,
+                    const allocator_type &alloc = allocator_type())
+      : comp_(comp),
+        keys_(key_allocator(alloc)),
+        values_(mapped_allocator(alloc)) {}
+  flat_map(std::initializer_list<value_type> const &items,
+           const allocator_type &alloc = allocator_type())
+      : flat_map(alloc) {
+    insert(items.begin(), items.end());
+  }
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_map(InputIt first, InputIt last,
+           const allocator_type &alloc = allocator_type())
+      : flat_map(alloc) {
+    insert(first, last);
+  }
+  // Adopts a range of pairs already strictly increasing by key without
+  // sorting. With check_sorted the order is verified first and
+  // std::invalid_argument is thrown on a violation; without it the order
+  // is a precondition.
+  template <typename ForwardIt>
+  static flat_map from_sorted(ForwardIt first, ForwardIt last,
+                              bool check_sorted = false,
+                              const allocator_type &alloc = allocator_type());
+
+  allocator_type get_allocator() const {
+    return allocator_type(keys_.get_allocator());
+  }
+  key_compare key_comp() const { return comp_; }
+  // The sorted keys and the values in the same order.
+  const key_container_type &keys() const noexcept { return keys_; }
+  const mapped_container_type &values() const noexcept { return values_; }
+
+  iterator begin() { return iterator(keys_.data(), values_.data()); }
+  iterator end() { return begin() + size(); }
+  const_iterator begin() const {
+    return const_iterator(keys_.data(), values_.data());
+  }
+  const_iterator end() const { return begin() + size(); }
+
+  bool empty() const { return keys_.empty(); }
+  size_type size() const { return keys_.size(); }
+  size_type max_size() const { return std::numeric_limits<size_type>::max(); }
+  void reserve(size_type n);
+  void shrink_to_fit();
+  void clear() noexcept;
+
+  T &at(const Key &key);
+  const T &at(const Key &key) const;
+  T &operator[](const Key &key) { return values_[try_emplace_index(key)]; }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return try_emplace(value.first, value.second);
+  }
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return try_emplace(key, obj);
+  }
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj);
+  // The value is built from args only if the key is not there yet.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  // Bulk insert of pairs: appends the range, sorts only the new entries
+  // and merges them into place. Keys already present keep their values.
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void insert(InputIt first, InputIt last);
+  void erase(iterator pos);
+  size_type erase(const Key &key);
+  void swap(flat_map &other) noexcept;
+  // Same result as map::merge: keys missing here move over from other;
+  // shared keys take other's value and also stay in other. Both sides are
+  // sorted, so this is one linear pass.
+  void merge(flat_map &other);
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+
+  iterator find(const Key &key) { return at_index(find_index(key)); }
+  const_iterator find(const Key &key) const {
+    return at_index(find_index(key));
+  }
+  bool contains(const Key &key) const { return find_index(key) != size(); }
+  size_type count(const Key &key) const { return contains(key); }
+  iterator lower_bound(const Key &key) { return at_index(lower(key)); }
+  const_iterator lower_bound(const Key &key) const {
+    return at_index(lower(key));
+  }
+  iterator upper_bound(const Key &key) { return at_index(upper(key)); }
+  const_iterator upper_bound(const Key &key) const {
+    return at_index(upper(key));
+  }
+  // Lookup by a key of another type without building a Key (for example
+  // std::string_view with Compare = std::less<>).
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    return at_index(find_index(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) const {
+    return at_index(find_index(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return find_index(key) != size();
+  }
+
+ private:
+  Compare comp_;
+  key_container_type keys_;
+  mapped_container_type values_;
+
+  static typename key_container_type::allocator_type key_allocator(
+      const allocator_type &alloc) {
+    return typename key_container_type::allocator_type(alloc);
+  }
+  static typename mapped_container_type::allocator_type mapped_allocator(
+      const allocator_type &alloc) {
+    return typename mapped_container_type::allocator_type(alloc);
+  }
+  iterator at_index(size_type index) { return begin() + index; }
+  const_iterator at_index(size_type index) const { return begin() + index; }
+
+  // a < b through the comparator, which may be three-way.
+  template <typename A, typename B>
+  bool key_less(const A &a, const B &b) const {
+    if constexpr (is_three_way_compare<Compare>::value) {
+      return comp_(a, b) < 0;
+    } else {
+      return comp_(a, b);
+    }
+  }
+  template <typename K>
+  size_type lower(const K &key) const {
+    auto it = std::lower_bound(
+        keys_.begin(), keys_.end(), key,
+        [this](const Key &item, const K &k) { return key_less(item, k); });
+    return static_cast<size_type>(it - keys_.begin());
+  }
+  template <typename K>
+  size_type upper(const K &key) const {
+    auto it = std::upper_bound(
+        keys_.begin(), keys_.end(), key,
+        [this](const K &k, const Key &item) { return key_less(k, item); });
+    return static_cast<size_type>(it - keys_.begin());
+  }
+  // Index of key, or size() when it is absent.
+  template <typename K>
+  size_type find_index(const K &key) const {
+    size_type index = lower(key);
+    return index != size() && !key_less(key, keys_[index]) ? index : size();
+  }
+  template <typename K, typename... Args>
+  std::pair<size_type, bool> emplace_at_bound(K &&key, Args &&...args);
+  size_type try_emplace_index(const Key &key) {
+    return emplace_at_bound(key).first;
+  }
+  void truncate(size_type count) noexcept;
+  void merge_tail(size_type old_size);
+};
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline void flat_map<Key, T, Compare, Allocator>::reserve(size_type n) {
+  keys_.reserve(n);
+  values_.reserve(n);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline void flat_map<Key, T, Compare, Allocator>::shrink_to_fit() {
+  keys_.shrink_to_fit();
+  values_.shrink_to_fit();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline void flat_map<Key, T, Compare, Allocator>::clear() noexcept {
+  keys_.clear();
+  values_.clear();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline T &flat_map<Key, T, Compare, Allocator>::at(const Key &key) {
+  size_type index = find_index(key);
+  if (index == size()) {
+    throw std::out_of_range("Key not found in map");
+  }
+  return values_[index];
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline const T &flat_map<Key, T, Compare, Allocator>::at(
+    const Key &key) const {
+  size_type index = find_index(key);
+  if (index == size()) {
+    throw std::out_of_range("Key not found in map");
+  }
+  return values_[index];
+}
+
+// Finds the slot for key and, when the key is new, opens it in both arrays.
+// A throwing value constructor takes the key back out.
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename... Args>
+inline std::pair<typename flat_map<Key, T, Compare, Allocator>::size_type,
+                 bool>
+flat_map<Key, T, Compare, Allocator>::emplace_at_bound(K &&key,
+                                                       Args &&...args) {
+  size_type index = lower(key);
+  if (index != size() && !key_less(key, keys_[index])) return {index, false};
+  keys_.emplace(keys_.begin() + index, std::forward<K>(key));
+  try {
+    values_.emplace(values_.begin() + index, std::forward<Args>(args)...);
+  } catch (...) {
+    keys_.erase(keys_.begin() + index, keys_.begin() + index + 1);
+    throw;
+  }
+  return {index, true};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator,
+                 bool>
+flat_map<Key, T, Compare, Allocator>::insert_or_assign(const Key &key,
+                                                       const T &obj) {
+  auto [index, inserted] = emplace_at_bound(key, obj);
+  if (!inserted) {
+    values_[index] = obj;
+  }
+  return {at_index(index), inserted};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+inline std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator,
+                 bool>
+flat_map<Key, T, Compare, Allocator>::try_emplace(const Key &key,
+                                                  Args &&...args) {
+  auto [index, inserted] = emplace_at_bound(key, std::forward<Args>(args)...);
+  return {at_index(index), inserted};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+inline std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator,
+                 bool>
+flat_map<Key, T, Compare, Allocator>::try_emplace(Key &&key,
+                                                  Args &&...args) {
+  auto [index, inserted] =
+      emplace_at_bound(s21::move(key), std::forward<Args>(args)...);
+  return {at_index(index), inserted};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+inline std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator,
+                 bool>
+flat_map<Key, T, Compare, Allocator>::emplace(Args &&...args) {
+  std::pair<Key, T> value(std::forward<Args>(args)...);
+  return try_emplace(s21::move(value.first), s21::move(value.second));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+inline void flat_map<Key, T, Compare, Allocator>::insert(InputIt first,
+                                                         InputIt last) {
+  size_type old_size = size();
+  try {
+    for (; first != last; ++first) {
+      const auto &item = *first;
+      keys_.emplace_back(item.first);
+      values_.emplace_back(item.second);
+    }
+    merge_tail(old_size);
+  } catch (...) {
+    truncate(old_size);
+    throw;
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline void flat_map<Key, T, Compare, Allocator>::truncate(
+    size_type count) noexcept {
+  keys_.erase(keys_.begin() + count, keys_.end());
+  values_.erase(values_.begin() + std::min(count, values_.size()),
+                values_.end());
+}
+
+// Sorts the entries appended after old_size through a stable permutation
+// (the two arrays cannot be sorted together in place) and merges them with
+// the sorted prefix. Among equal keys the existing entry wins, then the
+// earliest new one. All comparisons run before any entry moves, so a throw
+// leaves the prefix untouched for the caller to cut the tail.
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline void flat_map<Key, T, Compare, Allocator>::merge_tail(
+    size_type old_size) {
+  size_type total = size();
+  if (total == old_size) return;
+  s21::vector<size_type> order;
+  order.reserve(total - old_size);
+  for (size_type i = old_size; i < total; ++i) order.push_back(i);
+  std::stable_sort(order.begin(), order.end(),
+                   [this](size_type a, size_type b) {
+                     return key_less(keys_[a], keys_[b]);
+                   });
+
+  s21::vector<size_type> picks;
+  picks.reserve(total);
+  auto emit = [&](size_type index) {
+    if (picks.empty() || key_less(keys_[picks.back()], keys_[index])) {
+      picks.push_back(index);
+    }
+  };
+  size_type old_index = 0;
+  size_type new_index = 0;
+  while (old_index < old_size || new_index < order.size()) {
+    if (new_index == order.size() ||
+        (old_index < old_size &&
+         !key_less(keys_[order[new_index]], keys_[old_index]))) {
+      emit(old_index++);
+    } else {
+      emit(order[new_index++]);
+    }
+  }
+
+  key_container_type keys(keys_.get_allocator());
+  mapped_container_type values(values_.get_allocator());
+  keys.reserve(picks.size());
+  values.reserve(picks.size());
+  for (size_type index : picks) {
+    keys.push_back(std::move_if_noexcept(keys_[index]));
+    values.push_back(std::move_if_noexcept(values_[index]));
+  }
+  keys_.swap(keys);
+  values_.swap(values);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename ForwardIt>
+inline flat_map<Key, T, Compare, Allocator>
+flat_map<Key, T, Compare, Allocator>::from_sorted(
+    ForwardIt first, ForwardIt last, bool check_sorted,
+    const allocator_type &alloc) {
+  flat_map result(alloc);
+  if (check_sorted && first != last) {
+    for (ForwardIt prev = first, it = std::next(first); it != last;
+         prev = it, ++it) {
+      if (!result.key_less(prev->first, it->first)) {
+        throw std::invalid_argument("from_sorted: range is not increasing");
+      }
+    }
+  }
+  size_type count = static_cast<size_type>(std::distance(first, last));
+  result.reserve(count);
+  for (; first != last; ++first) {
+    result.keys_.push_back(first->first);
+    result.values_.push_back(first->second);
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline void flat_map<Key, T, Compare, Allocator>::erase(iterator pos) {
+  if (pos != end()) {
+    size_type index = static_cast<size_type>(pos - begin());
+    keys_.erase(keys_.begin() + index, keys_.begin() + index + 1);
+    values_.erase(values_.begin() + index, values_.begin() + index + 1);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline typename flat_map<Key, T, Compare, Allocator>::size_type
+flat_map<Key, T, Compare, Allocator>::erase(const Key &key) {
+  size_type index = find_index(key);
+  if (index == size()) return 0;
+  erase(at_index(index));
+  return 1;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline void flat_map<Key, T, Compare, Allocator>::swap(
+    flat_map &other) noexcept {
+  std::swap(comp_, other.comp_);
+  keys_.swap(other.keys_);
+  values_.swap(other.values_);
+}
+
+// The first pass does every comparison and copies the shared values while
+// both maps are intact; it only records where each output entry comes
+// from. The second pass moves entries into storage reserved up front, and
+// element types without a nothrow move are copied there instead, so a
+// throw anywhere leaves both maps unchanged.
+template <typename Key, typename T, typename Compare, typename Allocator>
+inline void flat_map<Key, T, Compare, Allocator>::merge(flat_map &other) {
+  if (this == &other || other.empty()) return;
+  enum : unsigned char { from_mine, from_theirs, shared };
+  s21::vector<unsigned char> steps;
+  mapped_container_type shared_values(values_.get_allocator());
+  steps.reserve(size() + other.size());
+  size_type mine = 0;
+  size_type theirs = 0;
+  while (mine < size() || theirs < other.size()) {
+    if (mine == size() ||
+        (theirs < other.size() &&
+         key_less(other.keys_[theirs], keys_[mine]))) {
+      steps.push_back(from_theirs);
+      ++theirs;
+    } else if (theirs == other.size() ||
+               key_less(keys_[mine], other.keys_[theirs])) {
+      steps.push_back(from_mine);
+      ++mine;
+    } else {
+      steps.push_back(shared);
+      shared_values.push_back(other.values_[theirs]);
+      ++mine;
+      ++theirs;
+    }
+  }
+
+  key_container_type keys(keys_.get_allocator());
+  mapped_container_type values(values_.get_allocator());
+  key_container_type rest_keys(other.keys_.get_allocator());
+  mapped_container_type rest_values(other.values_.get_allocator());
+  keys.reserve(steps.size());
+  values.reserve(steps.size());
+  rest_keys.reserve(shared_values.size());
+  rest_values.reserve(shared_values.size());
+  mine = theirs = 0;
+  size_type copied = 0;
+  for (unsigned char step : steps) {
+    if (step == from_theirs) {
+      keys.push_back(std::move_if_noexcept(other.keys_[theirs]));
+      values.push_back(std::move_if_noexcept(other.values_[theirs++]));
+    } else if (step == from_mine) {
+      keys.push_back(std::move_if_noexcept(keys_[mine]));
+      values.push_back(std::move_if_noexcept(values_[mine++]));
+    } else {
+      keys.push_back(std::move_if_noexcept(keys_[mine++]));
+      values.push_back(std::move_if_noexcept(shared_values[copied++]));
+      rest_keys.push_back(std::move_if_noexcept(other.keys_[theirs]));
+      rest_values.push_back(std::move_if_noexcept(other.values_[theirs++]));
+    }
+  }
+  keys_.swap(keys);
+  values_.swap(values);
+  other.keys_.swap(rest_keys);
+  other.values_.swap(rest_values);
+}
+
+// Every insert may shift earlier entries, so the iterators are looked up
+// again once all entries are in.
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+inline std::vector<
+    std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator, bool>>
+flat_map<Key, T, Compare, Allocator>::insert_many(Args &&...args) {
+  std::vector<std::pair<iterator, bool>> results;
+  std::vector<Key> keys;
+  results.reserve(sizeof...(Args));
+  keys.reserve(sizeof...(Args));
+  (..., [&](auto &&arg) {
+    auto inserted = insert(std::forward<decltype(arg)>(arg));
+    keys.push_back(inserted.first->first);
+    results.push_back(inserted);
+  }(std::forward<Args>(args)));
+  for (size_type i = 0; i < keys.size(); ++i) {
+    results[i].first = find(keys[i]);
+  }
+  return results;
+}
+
+}  // namespace s21
+
+#endif  // S21_FLAT_MAP_H
@@ -0,0 +1,306 @@
+#ifndef S21_FLAT_SET_H
+#define S21_FLAT_SET_H
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Tree/s21_tree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Sorted-vector set for data that is built once and read many times. Keys
+// sit in one contiguous s21::vector, so a lookup is a binary search over
+// adjacent memory and the set costs no more than the keys themselves.
+// Inserting or erasing one key shifts the tail: O(n). Build large sets in
+// bulk with the range constructor or insert(first, last), which sort and
+// deduplicate in O(n log n). Iterators are plain pointers and are
+// invalidated by any modification.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class flat_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = const Key &;
+  using const_reference = const Key &;
+  using iterator = const Key *;
+  using const_iterator = const Key *;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using container_type = s21::vector<Key, Allocator>;
+
+  flat_set() = default;
+  explicit flat_set(const allocator_type &alloc) : keys_(alloc) {}
+  explicit flat_set(const Compare &comp,
+                    const allocator_type &alloc = allocator_type())
+      : comp_(comp), keys_(alloc) {}
+  flat_set(std::initializer_list<value_type> const &items,
+           const allocator_type &alloc = allocator_type())
+      : keys_(alloc) {
+    insert(items.begin(), items.end());
+  }
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_set(InputIt first, InputIt last,
+           const allocator_type &alloc = allocator_type())
+      : keys_(alloc) {
+    insert(first, last);
+  }
+  // Adopts an already strictly increasing range without sorting. With
+  // check_sorted the order is verified first and std::invalid_argument is
+  // thrown on a violation; without it the order is a precondition.
+  template <typename ForwardIt>
+  static flat_set from_sorted(ForwardIt first, ForwardIt last,
+                              bool check_sorted = false,
+                              const allocator_type &alloc = allocator_type());
+
+  allocator_type get_allocator() const { return keys_.get_allocator(); }
+  key_compare key_comp() const { return comp_; }
+  // The sorted keys themselves.
+  const container_type &keys() const noexcept { return keys_; }
+
+  iterator begin() const { return keys_.begin(); }
+  iterator end() const { return keys_.end(); }
+
+  bool empty() const { return keys_.empty(); }
+  size_type size() const { return keys_.size(); }
+  size_type max_size() const { return std::numeric_limits<size_type>::max(); }
+  void reserve(size_type n) { keys_.reserve(n); }
+  void shrink_to_fit() { keys_.shrink_to_fit(); }
+  void clear() noexcept { keys_.clear(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return emplace_key(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return emplace_key(s21::move(value));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return emplace_key(value_type(std::forward<Args>(args)...));
+  }
+  // Bulk insert: appends the range, sorts only the new keys and merges
+  // them into place. Keys already present win over equal new ones.
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void insert(InputIt first, InputIt last);
+  void erase(iterator pos);
+  size_type erase(const key_type &key);
+  void swap(flat_set &other) noexcept;
+  // Same result as set::merge: every key of other ends up here and other
+  // is cleared. Both sides are sorted, so this is one linear merge.
+  void merge(flat_set &other);
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+
+  iterator find(const key_type &key) const { return find_key(key); }
+  bool contains(const key_type &key) const { return find_key(key) != end(); }
+  size_type count(const key_type &key) const { return contains(key); }
+  iterator lower_bound(const key_type &key) const { return lower(key); }
+  iterator upper_bound(const key_type &key) const { return upper(key); }
+  // Lookup by a key of another type without building a Key; only with a
+  // transparent Compare such as std::less<>.
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) const {
+    return find_key(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return find_key(key) != end();
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) const {
+    return lower(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) const {
+    return upper(key);
+  }
+
+  friend bool operator==(const flat_set &left, const flat_set &right) {
+    return std::equal(left.begin(), left.end(), right.begin(), right.end());
+  }
+  friend bool operator!=(const flat_set &left, const flat_set &right) {
+    return !(left == right);
+  }
+
+ private:
+  Compare comp_;
+  container_type keys_;
+
+  // a < b through the comparator, which may be three-way.
+  template <typename A, typename B>
+  bool key_less(const A &a, const B &b) const {
+    if constexpr (is_three_way_compare<Compare>::value) {
+      return comp_(a, b) < 0;
+    } else {
+      return comp_(a, b);
+    }
+  }
+  template <typename K>
+  iterator lower(const K &key) const {
+    return std::lower_bound(
+        begin(), end(), key,
+        [this](const Key &item, const K &k) { return key_less(item, k); });
+  }
+  template <typename K>
+  iterator upper(const K &key) const {
+    return std::upper_bound(
+        begin(), end(), key,
+        [this](const K &k, const Key &item) { return key_less(k, item); });
+  }
+  template <typename K>
+  iterator find_key(const K &key) const {
+    iterator it = lower(key);
+    return it != end() && !key_less(key, *it) ? it : end();
+  }
+  template <typename K>
+  std::pair<iterator, bool> emplace_key(K &&key);
+  // Keeps the first of each run of equal keys in [first, last) and returns
+  // the new end.
+  Key *unique_keys(Key *first, Key *last);
+};
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K>
+inline std::pair<typename flat_set<Key, Compare, Allocator>::iterator, bool>
+flat_set<Key, Compare, Allocator>::emplace_key(K &&key) {
+  iterator it = lower(key);
+  if (it != end() && !key_less(key, *it)) return {it, false};
+  size_type index = static_cast<size_type>(it - begin());
+  keys_.emplace(it, std::forward<K>(key));
+  return {begin() + index, true};
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+inline void flat_set<Key, Compare, Allocator>::insert(InputIt first,
+                                                      InputIt last) {
+  size_type old_size = keys_.size();
+  try {
+    for (; first != last; ++first) keys_.emplace_back(*first);
+  } catch (...) {
+    keys_.erase(keys_.begin() + old_size, keys_.end());
+    throw;
+  }
+  auto less = [this](const Key &a, const Key &b) { return key_less(a, b); };
+  Key *data = keys_.data();
+  Key *middle = data + old_size;
+  Key *tail = data + keys_.size();
+  // Stable, so among equal keys the existing one and then the earliest new
+  // one come first and survive deduplication.
+  std::stable_sort(middle, tail, less);
+  std::inplace_merge(data, middle, tail, less);
+  keys_.erase(unique_keys(data, tail), tail);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+inline Key *flat_set<Key, Compare, Allocator>::unique_keys(Key *first,
+                                                           Key *last) {
+  return std::unique(first, last, [this](const Key &a, const Key &b) {
+    return !key_less(a, b);
+  });
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt>
+inline flat_set<Key, Compare, Allocator>
+flat_set<Key, Compare, Allocator>::from_sorted(ForwardIt first,
+                                               ForwardIt last,
+                                               bool check_sorted,
+                                               const allocator_type &alloc) {
+  flat_set result(alloc);
+  if (check_sorted && first != last) {
+    for (ForwardIt prev = first, it = std::next(first); it != last;
+         prev = it, ++it) {
+      if (!result.key_less(*prev, *it)) {
+        throw std::invalid_argument("from_sorted: range is not increasing");
+      }
+    }
+  }
+  result.keys_.assign(first, last);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+inline void flat_set<Key, Compare, Allocator>::erase(iterator pos) {
+  if (pos != end()) {
+    keys_.erase(pos, pos + 1);
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator>
+inline typename flat_set<Key, Compare, Allocator>::size_type
+flat_set<Key, Compare, Allocator>::erase(const key_type &key) {
+  iterator it = find_key(key);
+  if (it == end()) return 0;
+  keys_.erase(it, it + 1);
+  return 1;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+inline void flat_set<Key, Compare, Allocator>::swap(flat_set &other) noexcept {
+  std::swap(comp_, other.comp_);
+  keys_.swap(other.keys_);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+inline void flat_set<Key, Compare, Allocator>::merge(flat_set &other) {
+  if (this == &other || other.empty()) return;
+  container_type merged(keys_.get_allocator());
+  merged.reserve(keys_.size() + other.keys_.size());
+  Key *mine = keys_.data();
+  Key *mine_end = mine + keys_.size();
+  Key *theirs = other.keys_.data();
+  Key *theirs_end = theirs + other.keys_.size();
+  while (mine != mine_end && theirs != theirs_end) {
+    if (key_less(*theirs, *mine)) {
+      merged.push_back(s21::move(*theirs++));
+    } else {
+      if (!key_less(*mine, *theirs)) ++theirs;
+      merged.push_back(s21::move(*mine++));
+    }
+  }
+  for (; mine != mine_end; ++mine) merged.push_back(s21::move(*mine));
+  for (; theirs != theirs_end; ++theirs) merged.push_back(s21::move(*theirs));
+  keys_.swap(merged);
+  other.clear();
+}
+
+// Every insert may shift earlier keys, so the iterators are looked up again
+// once all keys are in.
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+inline std::vector<
+    std::pair<typename flat_set<Key, Compare, Allocator>::iterator, bool>>
+flat_set<Key, Compare, Allocator>::insert_many(Args &&...args) {
+  std::vector<std::pair<iterator, bool>> result;
+  std::vector<Key> keys;
+  result.reserve(sizeof...(Args));
+  keys.reserve(sizeof...(Args));
+  (..., [&](auto &&arg) {
+    auto inserted = insert(std::forward<decltype(arg)>(arg));
+    keys.push_back(*inserted.first);
+    result.push_back(inserted);
+  }(std::forward<Args>(args)));
+  for (size_type i = 0; i < keys.size(); ++i) {
+    result[i].first = find_key(keys[i]);
+  }
+  return result;
+}
+
+}  // namespace s21
+
+#endif  // S21_FLAT_SET_H
@@ -0,0 +1,330 @@
+#ifndef S21_INPLACE_VECTOR_H
+#define S21_INPLACE_VECTOR_H
+
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_array.h"
+
+namespace s21 {
+
+// Storage for inplace_vector: an s21::array of N slots plus the live count.
+// Trivial types are kept directly in array<T, N>, which keeps the whole
+// container a literal type usable in constant expressions. Other types get
+// raw, suitably aligned slots so no constructor runs for unused capacity;
+// only this specialization needs a destructor.
+template <typename T, size_t N, bool = std::is_trivial<T>::value>
+struct inplace_storage {
+  array<T, N> slots;
+  size_t size;
+
+  constexpr inplace_storage() noexcept : slots(), size(0) {}
+  constexpr T *ptr() noexcept { return slots.data(); }
+  constexpr const T *ptr() const noexcept { return slots.data(); }
+};
+
+template <typename T, size_t N>
+struct inplace_storage<T, N, false> {
+  struct slot {
+    alignas(T) unsigned char bytes[sizeof(T)];
+  };
+  array<slot, N> slots;
+  size_t size;
+
+  inplace_storage() noexcept : size(0) {}
+  inplace_storage(const inplace_storage &) = delete;
+  inplace_storage &operator=(const inplace_storage &) = delete;
+  ~inplace_storage() {
+    for (size_t i = 0; i < size; ++i) {
+      ptr()[i].~T();
+    }
+  }
+
+  T *ptr() noexcept { return reinterpret_cast<T *>(slots.data()); }
+  const T *ptr() const noexcept {
+    return reinterpret_cast<const T *>(slots.data());
+  }
+};
+
+// Vector with a fixed capacity N kept inside the object and a runtime size.
+// It never allocates: push_back past N throws, try_push_back returns nullptr.
+template <typename T, size_t N>
+class inplace_vector {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using size_type = size_t;
+
+  constexpr inplace_vector() noexcept = default;
+  constexpr explicit inplace_vector(size_type n);
+  constexpr inplace_vector(std::initializer_list<value_type> items);
+  constexpr inplace_vector(const inplace_vector &other);
+  constexpr inplace_vector(inplace_vector &&other) noexcept(
+      std::is_nothrow_move_constructible<T>::value);
+
+  constexpr inplace_vector &operator=(const inplace_vector &other);
+  constexpr inplace_vector &operator=(inplace_vector &&other) noexcept(
+      std::is_nothrow_move_constructible<T>::value);
+
+  constexpr reference at(size_type pos);
+  constexpr reference operator[](size_type pos);
+  constexpr const_reference operator[](size_type pos) const;
+  constexpr const_reference front() const;
+  constexpr const_reference back() const;
+  constexpr T *data() noexcept { return storage_.ptr(); }
+  constexpr const T *data() const noexcept { return storage_.ptr(); }
+
+  constexpr iterator begin() noexcept { return data(); }
+  constexpr iterator end() noexcept { return data() + storage_.size; }
+  constexpr const_iterator begin() const noexcept { return data(); }
+  constexpr const_iterator end() const noexcept {
+    return data() + storage_.size;
+  }
+
+  constexpr bool empty() const noexcept { return storage_.size == 0; }
+  constexpr size_type size() const noexcept { return storage_.size; }
+  static constexpr size_type max_size() noexcept { return N; }
+  static constexpr size_type capacity() noexcept { return N; }
+  constexpr bool full() const noexcept { return storage_.size == N; }
+
+  constexpr void clear() noexcept;
+  constexpr void push_back(const_reference value);
+  constexpr void push_back(value_type &&value);
+  template <typename... Args>
+  constexpr reference emplace_back(Args &&...args);
+  constexpr void pop_back();
+  constexpr iterator erase(const_iterator pos);
+  constexpr void swap(inplace_vector &other);
+
+  // Non-throwing variants: return nullptr instead of throwing when full.
+  constexpr T *try_push_back(const_reference value);
+  constexpr T *try_push_back(value_type &&value);
+  template <typename... Args>
+  constexpr T *try_emplace_back(Args &&...args);
+
+  // insert many back
+  template <typename... Args>
+  constexpr void insert_many_back(Args &&...args);
+
+ private:
+  inplace_storage<T, N> storage_;
+
+  static constexpr bool kTrivial = std::is_trivial<T>::value;
+
+  template <typename... Args>
+  constexpr T *construct_back(Args &&...args);
+  constexpr void destroy_back() noexcept;
+};
+
+template <typename T, size_t N>
+constexpr inplace_vector<T, N>::inplace_vector(size_type n) {
+  if (n > N) throw std::length_error("inplace_vector capacity exceeded");
+  for (size_type i = 0; i < n; ++i) {
+    construct_back();
+  }
+}
+
+template <typename T, size_t N>
+constexpr inplace_vector<T, N>::inplace_vector(
+    std::initializer_list<value_type> items) {
+  if (items.size() > N) {
+    throw std::length_error("inplace_vector capacity exceeded");
+  }
+  for (const value_type &item : items) {
+    construct_back(item);
+  }
+}
+
+template <typename T, size_t N>
+constexpr inplace_vector<T, N>::inplace_vector(const inplace_vector &other) {
+  for (const value_type &item : other) {
+    construct_back(item);
+  }
+}
+
+template <typename T, size_t N>
+constexpr inplace_vector<T, N>::inplace_vector(
+    inplace_vector &&other) noexcept(
+    std::is_nothrow_move_constructible<T>::value) {
+  for (value_type &item : other) {
+    construct_back(std::move(item));
+  }
+  other.clear();
+}
+
+template <typename T, size_t N>
+constexpr inplace_vector<T, N> &inplace_vector<T, N>::operator=(
+    const inplace_vector &other) {
+  if (this != &other) {
+    clear();
+    for (const value_type &item : other) {
+      construct_back(item);
+    }
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+constexpr inplace_vector<T, N> &inplace_vector<T, N>::operator=(
+    inplace_vector &&other) noexcept(
+    std::is_nothrow_move_constructible<T>::value) {
+  if (this != &other) {
+    clear();
+    for (value_type &item : other) {
+      construct_back(std::move(item));
+    }
+    other.clear();
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+constexpr typename inplace_vector<T, N>::reference inplace_vector<T, N>::at(
+    size_type pos) {
+  if (pos >= storage_.size) {
+    throw std::out_of_range("Index out of range in inplace_vector::at");
+  }
+  return data()[pos];
+}
+
+template <typename T, size_t N>
+constexpr typename inplace_vector<T, N>::reference
+inplace_vector<T, N>::operator[](size_type pos) {
+  return data()[pos];
+}
+
+template <typename T, size_t N>
+constexpr typename inplace_vector<T, N>::const_reference
+inplace_vector<T, N>::operator[](size_type pos) const {
+  return data()[pos];
+}
+
+template <typename T, size_t N>
+constexpr typename inplace_vector<T, N>::const_reference
+inplace_vector<T, N>::front() const {
+  if (empty()) {
+    throw std::logic_error("Vector is empty!");
+  }
+  return data()[0];
+}
+
+template <typename T, size_t N>
+constexpr typename inplace_vector<T, N>::const_reference
+inplace_vector<T, N>::back() const {
+  if (empty()) {
+    throw std::logic_error("Vector is empty!");
+  }
+  return data()[storage_.size - 1];
+}
+
+template <typename T, size_t N>
+constexpr void inplace_vector<T, N>::clear() noexcept {
+  while (storage_.size > 0) {
+    destroy_back();
+  }
+}
+
+template <typename T, size_t N>
+constexpr void inplace_vector<T, N>::push_back(const_reference value) {
+  emplace_back(value);
+}
+
+template <typename T, size_t N>
+constexpr void inplace_vector<T, N>::push_back(value_type &&value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+constexpr typename inplace_vector<T, N>::reference
+inplace_vector<T, N>::emplace_back(Args &&...args) {
+  if (full()) throw std::length_error("inplace_vector capacity exceeded");
+  return *construct_back(std::forward<Args>(args)...);
+}
+
+template <typename T, size_t N>
+constexpr void inplace_vector<T, N>::pop_back() {
+  if (empty()) {
+    throw std::out_of_range("Cannot pop from an empty vector");
+  }
+  destroy_back();
+}
+
+template <typename T, size_t N>
+constexpr typename inplace_vector<T, N>::iterator inplace_vector<T, N>::erase(
+    const_iterator pos) {
+  if (pos < begin() || pos >= end()) throw std::out_of_range("out of range!");
+  iterator hole = begin() + (pos - begin());
+  for (iterator i = hole; i + 1 != end(); ++i) {
+    *i = std::move(*(i + 1));
+  }
+  destroy_back();
+  return hole;
+}
+
+template <typename T, size_t N>
+constexpr void inplace_vector<T, N>::swap(inplace_vector &other) {
+  if (this != &other) {
+    inplace_vector temp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(temp);
+  }
+}
+
+template <typename T, size_t N>
+constexpr T *inplace_vector<T, N>::try_push_back(const_reference value) {
+  return try_emplace_back(value);
+}
+
+template <typename T, size_t N>
+constexpr T *inplace_vector<T, N>::try_push_back(value_type &&value) {
+  return try_emplace_back(std::move(value));
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+constexpr T *inplace_vector<T, N>::try_emplace_back(Args &&...args) {
+  if (full()) return nullptr;
+  return construct_back(std::forward<Args>(args)...);
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+constexpr void inplace_vector<T, N>::insert_many_back(Args &&...args) {
+  if (storage_.size + sizeof...(args) > N) {
+    throw std::length_error("inplace_vector capacity exceeded");
+  }
+  (construct_back(std::forward<Args>(args)), ...);
+}
+
+// Trivial types are assigned into their slot so the path stays usable in
+// constant expressions; the rest are placement-constructed in raw memory.
+template <typename T, size_t N>
+template <typename... Args>
+constexpr T *inplace_vector<T, N>::construct_back(Args &&...args) {
+  T *slot = data() + storage_.size;
+  if constexpr (kTrivial) {
+    *slot = T{std::forward<Args>(args)...};
+  } else {
+    ::new (static_cast<void *>(slot)) T(std::forward<Args>(args)...);
+  }
+  ++storage_.size;
+  return slot;
+}
+
+template <typename T, size_t N>
+constexpr void inplace_vector<T, N>::destroy_back() noexcept {
+  --storage_.size;
+  if constexpr (!kTrivial) {
+    data()[storage_.size].~T();
+  }
+}
+
+}  // namespace s21
+
+#endif
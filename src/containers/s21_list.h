@@ -3,6 +3,9 @@
 
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace s21 {
 
@@ -13,14 +16,15 @@ class Node {
   Node *pPrev_;
   T data_;
 
-  Node(T data = T(), Node *pNext = nullptr, Node *pPrev = nullptr) {
-    this->data_ = data;
-    this->pNext_ = pNext;
-    this->pPrev_ = pPrev;
-  }
+  Node() : pNext_(nullptr), pPrev_(nullptr), data_() {}
+
+  // Builds data_ in place from args.
+  template <typename... Args>
+  Node(Node *pNext, Node *pPrev, Args &&...args)
+      : pNext_(pNext), pPrev_(pPrev), data_(std::forward<Args>(args)...) {}
 };
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class List : public Node<T> {
  public:
   //  List Member type
@@ -28,15 +32,16 @@ class List : public Node<T> {
   using reference = T &;
   using const_reference = const T &;
   using size_type = size_t;
+  using allocator_type = Allocator;
 
   class ListIterator {
-    friend class List<T>;
+    friend class List<T, Allocator>;
 
    public:
     ListIterator();
-    ListIterator(typename List<T>::Node *node);
-    ListIterator(typename List<T>::Node *node,
-                 typename List<T>::Node *last_node);
+    ListIterator(typename List<T, Allocator>::Node *node);
+    ListIterator(typename List<T, Allocator>::Node *node,
+                 typename List<T, Allocator>::Node *last_node);
 
     reference operator*() const;
     ListIterator &operator++();
@@ -45,8 +50,8 @@ class List : public Node<T> {
     bool operator!=(const ListIterator &other) const;
 
    protected:
-    typename List<T>::Node *node_;
-    typename List<T>::Node *last_node_;
+    typename List<T, Allocator>::Node *node_;
+    typename List<T, Allocator>::Node *last_node_;
   };
 
   class ListConstIterator : public ListIterator {
@@ -61,14 +66,20 @@ class List : public Node<T> {
 
   // Constructors & destructor
   List();
-  List(size_type n);
-  List(std::initializer_list<value_type> const &items);
+  explicit List(const allocator_type &alloc);
+  List(size_type n, const allocator_type &alloc = allocator_type());
+  List(std::initializer_list<value_type> const &items,
+       const allocator_type &alloc = allocator_type());
   List(const List &other);
+  List(const List &other, const allocator_type &alloc);
   List(List &&other);
   ~List();
 
+  List &operator=(const List &other);
   List &operator=(List &&other);
 
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
   // Element access
   const_reference front();
   const_reference back();
@@ -85,10 +96,13 @@ class List : public Node<T> {
   // Modifiers
   void clear();
   iterator insert(iterator pos, const_reference value);
+  iterator insert(iterator pos, value_type &&value);
   void erase(iterator pos);
   void push_back(const_reference value);
+  void push_back(value_type &&value);
   void pop_back();
   void push_front(const_reference value);
+  void push_front(value_type &&value);
   void pop_front();
   void swap(List &other);
   void merge(List &other);
@@ -97,6 +111,16 @@ class List : public Node<T> {
   void unique();
   void sort();
 
+  // In-place construction
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args);
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args);
+
+  template <typename... Args>
+  reference emplace_front(Args &&...args);
+
   // Bonus part
 
   template <typename... Args>
@@ -109,39 +133,55 @@ class List : public Node<T> {
   void insert_many_front(Args &&...args);
 
  private:
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node<T>>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
   typename Node<T>::Node *head;
   typename Node<T>::Node *tail;
   size_type size_;
+  node_allocator alloc_;
+
+  template <typename... Args>
+  Node<T> *create_node(Args &&...args);
+  void destroy_node(Node<T> *node) noexcept;
+  template <typename Source>
+  void append_from(Source &&other);
 };
 
 // class ListIterator
 
-template <typename T>
-List<T>::ListIterator::ListIterator(){};
+template <typename T, typename Allocator>
+List<T, Allocator>::ListIterator::ListIterator(){};
 
-template <typename T>
-List<T>::ListIterator::ListIterator(typename List<T>::Node *node)
+template <typename T, typename Allocator>
+List<T, Allocator>::ListIterator::ListIterator(
+    typename List<T, Allocator>::Node *node)
     : node_(node) {}
 
-template <typename T>
-List<T>::ListIterator::ListIterator(typename List<T>::Node *node,
-                                    typename List<T>::Node *last_node)
+template <typename T, typename Allocator>
+List<T, Allocator>::ListIterator::ListIterator(
+    typename List<T, Allocator>::Node *node,
+    typename List<T, Allocator>::Node *last_node)
     : node_(node), last_node_(last_node) {}
 
-template <typename T>
-typename List<T>::reference List<T>::ListIterator::operator*() const {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::reference
+List<T, Allocator>::ListIterator::operator*() const {
   return node_->data_;
 }
 
-template <typename T>
-typename List<T>::ListIterator &List<T>::ListIterator::operator++() {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::ListIterator &
+List<T, Allocator>::ListIterator::operator++() {
   last_node_ = node_;
   node_ = node_->pNext_;
   return *this;
 }
 
-template <typename T>
-typename List<T>::ListIterator &List<T>::ListIterator::operator--() {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::ListIterator &
+List<T, Allocator>::ListIterator::operator--() {
   if (node_ == nullptr) {
     node_ = last_node_;
   } else {
@@ -150,160 +190,195 @@ typename List<T>::ListIterator &List<T>::ListIterator::operator--() {
   return *this;
 }
 
-template <typename T>
-bool List<T>::ListIterator::operator==(const ListIterator &other) const {
+template <typename T, typename Allocator>
+bool List<T, Allocator>::ListIterator::operator==(
+    const ListIterator &other) const {
   return node_ == other.node_;
 }
 
-template <typename T>
-bool List<T>::ListIterator::operator!=(const ListIterator &other) const {
+template <typename T, typename Allocator>
+bool List<T, Allocator>::ListIterator::operator!=(
+    const ListIterator &other) const {
   return node_ != other.node_;
 }
 
 // class ListConstIterator
 
-template <typename T>
-List<T>::ListConstIterator::ListConstIterator() : ListIterator() {}
+template <typename T, typename Allocator>
+List<T, Allocator>::ListConstIterator::ListConstIterator() : ListIterator() {}
 
-template <typename T>
-List<T>::ListConstIterator::ListConstIterator(const ListIterator &node_)
+template <typename T, typename Allocator>
+List<T, Allocator>::ListConstIterator::ListConstIterator(
+    const ListIterator &node_)
     : ListIterator(node_) {}
 
-template <typename T>
-typename List<T>::const_reference List<T>::ListConstIterator::operator*()
-    const {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::const_reference
+List<T, Allocator>::ListConstIterator::operator*() const {
   return ListIterator::operator*();
 }
 
 // Constructors & destructor
 
-template <typename T>
-List<T>::List() : head(nullptr), tail(nullptr), size_(0) {}
+template <typename T, typename Allocator>
+List<T, Allocator>::List()
+    : head(nullptr), tail(nullptr), size_(0), alloc_() {}
 
-template <typename T>
-List<T>::List(size_type n) : List() {
-  for (size_type i = 0; i < n; ++i) push_front(value_type());
+template <typename T, typename Allocator>
+List<T, Allocator>::List(const allocator_type &alloc)
+    : head(nullptr), tail(nullptr), size_(0), alloc_(alloc) {}
+
+template <typename T, typename Allocator>
+List<T, Allocator>::List(size_type n, const allocator_type &alloc)
+    : List(alloc) {
+  for (size_type i = 0; i < n; ++i) emplace_front();
 }
 
-template <typename T>
-List<T>::List(std::initializer_list<value_type> const &items) : List() {
+template <typename T, typename Allocator>
+List<T, Allocator>::List(std::initializer_list<value_type> const &items,
+                         const allocator_type &alloc)
+    : List(alloc) {
   for (auto i = items.begin(); i != items.end(); i++) push_back(*i);
 }
 
-template <typename T>
-inline List<T>::List(const List &other) : List<T>::List() {
-  typename Node<T>::Node *p = other.head;
-  while (p != nullptr) {
-    this->push_back(p->data_);
-    p = p->pNext_;
-  }
+template <typename T, typename Allocator>
+inline List<T, Allocator>::List(const List &other)
+    : List(std::allocator_traits<allocator_type>::
+               select_on_container_copy_construction(other.get_allocator())) {
+  append_from(other);
 }
 
-template <typename T>
-inline List<T>::List(List &&other)
-    : head(other.head), tail(other.tail), size_(other.size_) {
+template <typename T, typename Allocator>
+inline List<T, Allocator>::List(const List &other,
+                                const allocator_type &alloc)
+    : List(alloc) {
+  append_from(other);
+}
+
+template <typename T, typename Allocator>
+inline List<T, Allocator>::List(List &&other)
+    : head(other.head),
+      tail(other.tail),
+      size_(other.size_),
+      alloc_(std::move(other.alloc_)) {
   other.head = nullptr;
   other.tail = nullptr;
   other.size_ = 0;
 }
 
-template <typename T>
-List<T>::~List() {
+template <typename T, typename Allocator>
+List<T, Allocator>::~List() {
   clear();
 }
 
-template <typename T>
-typename List<T>::List &List<T>::operator=(List &&other) {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::List &List<T, Allocator>::operator=(
+    const List &other) {
   if (this != &other) {
     clear();
-    this->head = other.head;
-    this->tail = other.tail;
-    size_ = other.size_;
-    other.head = nullptr;
-    other.tail = nullptr;
-    other.size_ = 0;
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+      alloc_ = other.alloc_;
+    }
+    append_from(other);
+  }
+  return *this;
+}
+
+// Same allocator rules as vector::operator=(vector &&).
+template <typename T, typename Allocator>
+typename List<T, Allocator>::List &List<T, Allocator>::operator=(
+    List &&other) {
+  if (this != &other) {
+    clear();
+    if (node_traits::propagate_on_container_move_assignment::value ||
+        alloc_ == other.alloc_) {
+      if constexpr (node_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = std::move(other.alloc_);
+      }
+      this->head = other.head;
+      this->tail = other.tail;
+      size_ = other.size_;
+      other.head = nullptr;
+      other.tail = nullptr;
+      other.size_ = 0;
+    } else {
+      append_from(s21::move(other));
+      other.clear();
+    }
   }
   return *this;
 }
 
 // Element access
 
-template <typename T>
-typename List<T>::const_reference List<T>::front() {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::const_reference List<T, Allocator>::front() {
   return this->head->data_;
 }
 
-template <typename T>
-typename List<T>::const_reference List<T>::back() {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::const_reference List<T, Allocator>::back() {
   return this->tail->data_;
 }
 
 // Iterators
 
-template <typename T>
-typename List<T>::iterator List<T>::begin() {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::iterator List<T, Allocator>::begin() {
   return iterator(this->head);
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::end() {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::iterator List<T, Allocator>::end() {
   return this->head ? iterator(this->tail->pNext_, this->tail) : begin();
 }
 
 // Capacity
 
-template <typename T>
-bool List<T>::empty() {
+template <typename T, typename Allocator>
+bool List<T, Allocator>::empty() {
   return size_ == 0;
 }
 
-template <typename T>
-typename List<T>::size_type List<T>::size() {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::size_type List<T, Allocator>::size() {
   return size_;
 }
 
-template <typename T>
-typename List<T>::size_type List<T>::max_size() {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::size_type List<T, Allocator>::max_size() {
   return std::numeric_limits<size_type>::max() /
-         sizeof(typename List<T>::Node) / 2;
+         sizeof(typename List<T, Allocator>::Node) / 2;
 }
 
 // Modifiers
 
-template <typename T>
-void List<T>::clear() {
+template <typename T, typename Allocator>
+void List<T, Allocator>::clear() {
   while (head) {
     Node<T> *temp = head;
     head = head->pNext_;
-    delete temp;
+    destroy_node(temp);
   }
   tail = nullptr;
   size_ = 0;
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::insert(iterator pos,
+template <typename T, typename Allocator>
+typename List<T, Allocator>::iterator List<T, Allocator>::insert(iterator pos,
                                            const_reference value) {
-  if (pos == this->begin()) {
-    push_front(value);
-    pos = this->head;
-  } else if (pos == this->end()) {
-    push_back(value);
-    pos = this->tail;
-  } else {
-    typename Node<T>::Node *current = pos.node_;
-    typename Node<T>::Node *blank =
-        new typename Node<T>::Node(value, current, current->pPrev_);
-    current->pPrev_->pNext_ = blank;
-    current->pPrev_ = blank;
-    this->size_++;
-    pos = iterator(blank);
-  }
-  return pos;
+  return emplace(pos, value);
 }
 
-template <typename T>
-void List<T>::erase(iterator pos) {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::iterator List<T, Allocator>::insert(
+    iterator pos, value_type &&value) {
+  return emplace(pos, s21::move(value));
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::erase(iterator pos) {
   Node<T> *current = pos.node_;
 
   if (current) {
@@ -319,25 +394,23 @@ void List<T>::erase(iterator pos) {
       tail = current->pPrev_;
     }
 
-    delete current;
+    destroy_node(current);
     --size_;
   }
 }
 
-template <typename T>
-void List<T>::push_back(const_reference value) {
-  Node<T> *new_node = new Node<T>(value, nullptr, tail);
-  if (tail) {
-    tail->pNext_ = new_node;
-  } else {
-    head = new_node;
-  }
-  tail = new_node;
-  ++size_;
+template <typename T, typename Allocator>
+void List<T, Allocator>::push_back(const_reference value) {
+  emplace_back(value);
 }
 
-template <typename T>
-void List<T>::pop_back() {
+template <typename T, typename Allocator>
+void List<T, Allocator>::push_back(value_type &&value) {
+  emplace_back(s21::move(value));
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::pop_back() {
   if (tail) {
     Node<T> *old_tail = tail;
     tail = tail->pPrev_;
@@ -346,25 +419,23 @@ void List<T>::pop_back() {
     } else {
       head = nullptr;
     }
-    delete old_tail;
+    destroy_node(old_tail);
     --size_;
   }
 }
 
-template <typename T>
-void List<T>::push_front(const_reference value) {
-  Node<T> *new_node = new Node<T>(value, head, nullptr);
-  if (head) {
-    head->pPrev_ = new_node;
-  } else {
-    tail = new_node;
-  }
-  head = new_node;
-  ++size_;
+template <typename T, typename Allocator>
+void List<T, Allocator>::push_front(const_reference value) {
+  emplace_front(value);
 }
 
-template <typename T>
-void List<T>::pop_front() {
+template <typename T, typename Allocator>
+void List<T, Allocator>::push_front(value_type &&value) {
+  emplace_front(s21::move(value));
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::pop_front() {
   if (head) {
     Node<T> *old_head = head;
     head = head->pNext_;
@@ -373,20 +444,24 @@ void List<T>::pop_front() {
     } else {
       tail = nullptr;
     }
-    delete old_head;
+    destroy_node(old_head);
     --size_;
   }
 }
 
-template <typename T>
-void List<T>::swap(List &other) {
+// Same allocator rules as vector::swap().
+template <typename T, typename Allocator>
+void List<T, Allocator>::swap(List &other) {
+  if constexpr (node_traits::propagate_on_container_swap::value) {
+    std::swap(alloc_, other.alloc_);
+  }
   std::swap(head, other.head);
   std::swap(tail, other.tail);
   std::swap(size_, other.size_);
 }
 
-template <typename T>
-void List<T>::merge(List &other) {
+template <typename T, typename Allocator>
+void List<T, Allocator>::merge(List &other) {
   if (this != &other) {
     typename Node<T>::Node *p = other.head;
     while (p != nullptr) {
@@ -397,8 +472,9 @@ void List<T>::merge(List &other) {
   }
 }
 
-template <typename T>
-void List<T>::splice(List<T>::const_iterator pos, List &other) {
+template <typename T, typename Allocator>
+void List<T, Allocator>::splice(List<T, Allocator>::const_iterator pos,
+                                List &other) {
   if (!other.empty()) {
     for (iterator it_other = other.begin(); it_other != other.end();
          ++it_other) {
@@ -407,8 +483,8 @@ void List<T>::splice(List<T>::const_iterator pos, List &other) {
   }
 }
 
-template <typename T>
-void List<T>::reverse() {
+template <typename T, typename Allocator>
+void List<T, Allocator>::reverse() {
   Node<T> *current = head;
   Node<T> *temp = nullptr;
 
@@ -427,8 +503,8 @@ void List<T>::reverse() {
   std::swap(head, tail);
 }
 
-template <typename T>
-void List<T>::unique() {
+template <typename T, typename Allocator>
+void List<T, Allocator>::unique() {
   if (head == nullptr) return;
 
   Node<T> *current = head;
@@ -441,7 +517,7 @@ void List<T>::unique() {
       } else {
         tail = current;
       }
-      delete temp;
+      destroy_node(temp);
       --size_;
     } else {
       current = current->pNext_;
@@ -449,8 +525,8 @@ void List<T>::unique() {
   }
 }
 
-template <typename T>
-void List<T>::sort() {
+template <typename T, typename Allocator>
+void List<T, Allocator>::sort() {
   if (size_ < 2) return;
 
   bool swapped;
@@ -468,33 +544,111 @@ void List<T>::sort() {
   } while (swapped);
 }
 
-// Bonus part
+// In-place construction
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename... Args>
-typename List<T>::iterator List<T>::insert_many(List<T>::const_iterator pos,
-                                                Args &&...args) {
-  for (const auto &arg : {args...}) {
-    insert(pos, arg);
+typename List<T, Allocator>::iterator List<T, Allocator>::emplace(
+    List<T, Allocator>::const_iterator pos, Args &&...args) {
+  Node<T> *current = pos.node_;
+  if (current == nullptr) {
+    emplace_back(std::forward<Args>(args)...);
+    return iterator(tail);
   }
-  return pos;
+  if (current == head) {
+    emplace_front(std::forward<Args>(args)...);
+    return iterator(head);
+  }
+  Node<T> *new_node =
+      create_node(current, current->pPrev_, std::forward<Args>(args)...);
+  current->pPrev_->pNext_ = new_node;
+  current->pPrev_ = new_node;
+  ++size_;
+  return iterator(new_node);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
+template <typename... Args>
+typename List<T, Allocator>::reference List<T, Allocator>::emplace_back(
+    Args &&...args) {
+  Node<T> *new_node = create_node(nullptr, tail, std::forward<Args>(args)...);
+  if (tail) {
+    tail->pNext_ = new_node;
+  } else {
+    head = new_node;
+  }
+  tail = new_node;
+  ++size_;
+  return new_node->data_;
+}
+
+template <typename T, typename Allocator>
 template <typename... Args>
-inline void List<T>::insert_many_back(Args &&...args) {
-  const_iterator pos = this->end();
-  for (const auto &arg : {args...}) {
-    insert(pos, arg);
+typename List<T, Allocator>::reference List<T, Allocator>::emplace_front(
+    Args &&...args) {
+  Node<T> *new_node = create_node(head, nullptr, std::forward<Args>(args)...);
+  if (head) {
+    head->pPrev_ = new_node;
+  } else {
+    tail = new_node;
   }
+  head = new_node;
+  ++size_;
+  return new_node->data_;
 }
 
-template <typename T>
+// Bonus part
+
+template <typename T, typename Allocator>
 template <typename... Args>
-void List<T>::insert_many_front(Args &&...args) {
-  for (const auto &arg : {args...}) {
-    const_iterator pos = this->begin();
-    insert(pos, arg);
+typename List<T, Allocator>::iterator List<T, Allocator>::insert_many(
+    List<T, Allocator>::const_iterator pos, Args &&...args) {
+  (emplace(pos, std::forward<Args>(args)), ...);
+  return pos;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+inline void List<T, Allocator>::insert_many_back(Args &&...args) {
+  (emplace_back(std::forward<Args>(args)), ...);
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+void List<T, Allocator>::insert_many_front(Args &&...args) {
+  (emplace_front(std::forward<Args>(args)), ...);
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+Node<T> *List<T, Allocator>::create_node(Args &&...args) {
+  Node<T> *node = node_traits::allocate(alloc_, 1);
+  try {
+    node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::destroy_node(Node<T> *node) noexcept {
+  node_traits::destroy(alloc_, node);
+  node_traits::deallocate(alloc_, node, 1);
+}
+
+// Copies other's elements to our back, or moves them when other is an
+// rvalue.
+template <typename T, typename Allocator>
+template <typename Source>
+void List<T, Allocator>::append_from(Source &&other) {
+  for (Node<T> *p = other.head; p != nullptr; p = p->pNext_) {
+    if constexpr (std::is_lvalue_reference<Source>::value) {
+      emplace_back(p->data_);
+    } else {
+      emplace_back(s21::move(p->data_));
+    }
   }
 }
 
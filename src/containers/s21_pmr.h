@@ -0,0 +1,207 @@
+#ifndef S21_PMR_H
+#define S21_PMR_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+#include "BTreeMap/s21_btree_map.h"
+#include "BTreeSet/s21_btree_set.h"
+#include "Map/s21_map.h"
+#include "Multiset/s21_multiset.h"
+#include "Set/s21_set.h"
+#include "UnorderedMap/s21_unordered_map.h"
+#include "UnorderedSet/s21_unordered_set.h"
+#include "s21_flat_map.h"
+#include "s21_flat_set.h"
+#include "s21_list.h"
+#include "s21_queue.h"
+#include "s21_small_vector.h"
+#include "s21_stack.h"
+#include "s21_vector.h"
+
+namespace s21 {
+namespace pmr {
+
+// Containers whose storage comes from a std::pmr::memory_resource chosen at
+// run time. array and inplace_vector never allocate, so they have no alias.
+template <typename T, typename Growth = growth_x2>
+using vector = s21::vector<T, std::pmr::polymorphic_allocator<T>, Growth>;
+
+template <typename T, size_t N, typename Growth = growth_x2>
+using small_vector =
+    s21::small_vector<T, N, std::pmr::polymorphic_allocator<T>, Growth>;
+
+template <typename T>
+using List = s21::List<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T>
+using stack = s21::stack<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T>
+using queue = s21::queue<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using map = s21::map<Key, T, Compare,
+                     std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <typename Key, typename Compare = std::less<Key>>
+using set = s21::set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+
+template <typename Key, typename Compare = std::less<Key>>
+using multiset =
+    s21::multiset<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using btree_map =
+    s21::btree_map<Key, T, Compare,
+                   std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <typename Key, typename Compare = std::less<Key>>
+using btree_set =
+    s21::btree_set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using flat_map =
+    s21::flat_map<Key, T, Compare,
+                  std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <typename Key, typename Compare = std::less<Key>>
+using flat_set =
+    s21::flat_set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+using unordered_map = s21::unordered_map<
+    Key, T, Hash, KeyEqual,
+    std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+using unordered_set = s21::unordered_set<Key, Hash, KeyEqual,
+                                         std::pmr::polymorphic_allocator<Key>>;
+
+// Monotonic bump-pointer arena. Individual deallocations are ignored; all
+// memory handed out comes back at once through reset() or release().
+// reset() keeps the newest (largest) block, so an arena reused for one
+// request after another settles on a single upstream allocation.
+class arena_resource : public std::pmr::memory_resource {
+ public:
+  explicit arena_resource(
+      size_t initial_size = 4096,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+      : upstream_(upstream),
+        next_size_(initial_size ? initial_size : 1),
+        head_(nullptr),
+        cursor_(nullptr),
+        end_(nullptr),
+        used_(0) {}
+  arena_resource(const arena_resource &) = delete;
+  arena_resource &operator=(const arena_resource &) = delete;
+  ~arena_resource() override { release(); }
+
+  // Rewinds to the start of the newest block and frees the older ones.
+  // Every object allocated from the arena must already be destroyed.
+  void reset() noexcept;
+  // Returns every block to the upstream resource.
+  void release() noexcept;
+
+  std::pmr::memory_resource *upstream_resource() const noexcept {
+    return upstream_;
+  }
+  // Bytes handed out since the last reset() or release().
+  size_t bytes_used() const noexcept { return used_; }
+
+ protected:
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *, size_t, size_t) override {}
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+ private:
+  // Header at the front of every upstream block.
+  struct block {
+    block *prev;
+    size_t size;
+  };
+
+  static constexpr size_t header_size =
+      (sizeof(block) + alignof(std::max_align_t) - 1) /
+      alignof(std::max_align_t) * alignof(std::max_align_t);
+
+  void add_block(size_t min_bytes);
+  void free_blocks(block *first) noexcept;
+  void rewind() noexcept;
+
+  std::pmr::memory_resource *upstream_;
+  size_t next_size_;
+  block *head_;
+  char *cursor_;
+  char *end_;
+  size_t used_;
+};
+
+inline void arena_resource::reset() noexcept {
+  if (head_) {
+    free_blocks(head_->prev);
+    head_->prev = nullptr;
+  }
+  rewind();
+}
+
+inline void arena_resource::release() noexcept {
+  free_blocks(head_);
+  head_ = nullptr;
+  rewind();
+}
+
+inline void *arena_resource::do_allocate(size_t bytes, size_t alignment) {
+  size_t space = static_cast<size_t>(end_ - cursor_);
+  void *ptr = cursor_;
+  if (!head_ || !std::align(alignment, bytes, ptr, space)) {
+    add_block(bytes + alignment);
+    space = static_cast<size_t>(end_ - cursor_);
+    ptr = cursor_;
+    std::align(alignment, bytes, ptr, space);
+  }
+  cursor_ = static_cast<char *>(ptr) + bytes;
+  used_ += bytes;
+  return ptr;
+}
+
+// Blocks grow geometrically so a long request needs only a logarithmic
+// number of upstream allocations.
+inline void arena_resource::add_block(size_t min_bytes) {
+  size_t size = next_size_;
+  while (size < min_bytes) size *= 2;
+  void *memory =
+      upstream_->allocate(header_size + size, alignof(std::max_align_t));
+  head_ = ::new (memory) block{head_, size};
+  cursor_ = static_cast<char *>(memory) + header_size;
+  end_ = cursor_ + size;
+  next_size_ = size * 2;
+}
+
+inline void arena_resource::free_blocks(block *first) noexcept {
+  while (first) {
+    block *prev = first->prev;
+    upstream_->deallocate(first, header_size + first->size,
+                          alignof(std::max_align_t));
+    first = prev;
+  }
+}
+
+inline void arena_resource::rewind() noexcept {
+  cursor_ = head_ ? reinterpret_cast<char *>(head_) + header_size : nullptr;
+  end_ = head_ ? cursor_ + head_->size : nullptr;
+  used_ = 0;
+}
+
+}  // namespace pmr
+}  // namespace s21
+
+#endif
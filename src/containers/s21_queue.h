@@ -2,9 +2,12 @@
 #define S21_QUEUE_H
 
 #include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class queue {
  private:
   class Node_ {
@@ -12,35 +15,53 @@ class queue {
     T data_;
     Node_ *next_;
 
-    Node_(const T &value = T(), Node_ *next = nullptr)
-        : data_(value), next_(next) {}
+    template <typename... Args>
+    explicit Node_(Node_ *next, Args &&...args)
+        : data_(std::forward<Args>(args)...), next_(next) {}
   };
 
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node_>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
   Node_ *head_;
   Node_ *tail_;
   size_t size_;
+  node_allocator alloc_;
 
  public:
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
   using size_type = size_t;
+  using allocator_type = Allocator;
 
   // constructors & destructor
-  queue() : head_(nullptr), tail_(nullptr), size_(0) {}
-  queue(const std::initializer_list<value_type> &items);
+  queue() : head_(nullptr), tail_(nullptr), size_(0), alloc_() {}
+  explicit queue(const allocator_type &alloc) noexcept
+      : head_(nullptr), tail_(nullptr), size_(0), alloc_(alloc) {}
+  queue(const std::initializer_list<value_type> &items,
+        const allocator_type &alloc = allocator_type());
   queue(const queue &other);
+  queue(const queue &other, const allocator_type &alloc);
   queue(queue &&other) noexcept;
   ~queue();
 
-  queue &operator=(const queue &other) noexcept;
-  queue &operator=(queue &&other) noexcept;
+  queue &operator=(const queue &other);
+  queue &operator=(queue &&other) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value);
+
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
 
   const_reference front() const;
   const_reference back() const;
   bool empty() const;
   size_type size() const;
   void push(const_reference value);
+  void push(value_type &&value);
+  template <typename... Args>
+  reference emplace(Args &&...args);
   void pop();
   void swap(queue &other);
 
@@ -52,97 +73,137 @@ class queue {
   // get_head() function can be used to loop through the queue items from
   // outside the library
   Node_ *get_head() const;
+
+ private:
+  template <typename... Args>
+  Node_ *create_node(Args &&...args);
+  void destroy_node(Node_ *node) noexcept;
+  template <typename Source>
+  void append_from(Source &&other);
 };
 
-template <typename T>
-inline queue<T>::queue(const std::initializer_list<value_type> &items)
-    : head_(nullptr), tail_(nullptr), size_(0) {
-  for (const value_type i : items) {
+template <typename T, typename Allocator>
+inline queue<T, Allocator>::queue(
+    const std::initializer_list<value_type> &items,
+    const allocator_type &alloc)
+    : queue(alloc) {
+  for (const value_type &i : items) {
     push(i);
   }
 }
 
-template <typename T>
-inline queue<T>::queue(const queue<T> &other)
-    : head_(nullptr), tail_(nullptr), size_(0) {
-  Node_ *temp = other.head_;
-  while (temp != nullptr) {
-    push(temp->data_);
-    temp = temp->next_;
-  }
+template <typename T, typename Allocator>
+inline queue<T, Allocator>::queue(const queue &other)
+    : queue(std::allocator_traits<allocator_type>::
+                select_on_container_copy_construction(
+                    other.get_allocator())) {
+  append_from(other);
 }
 
-template <typename T>
-inline queue<T>::queue(queue<T> &&other) noexcept
-    : head_(nullptr), tail_(nullptr), size_(0) {
-  *this = s21::move(other);
+template <typename T, typename Allocator>
+inline queue<T, Allocator>::queue(const queue &other,
+                                  const allocator_type &alloc)
+    : queue(alloc) {
+  append_from(other);
 }
 
-template <typename T>
-inline queue<T>::~queue() {
+template <typename T, typename Allocator>
+inline queue<T, Allocator>::queue(queue &&other) noexcept
+    : head_(other.head_),
+      tail_(other.tail_),
+      size_(other.size_),
+      alloc_(std::move(other.alloc_)) {
+  other.head_ = nullptr;
+  other.tail_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename T, typename Allocator>
+inline queue<T, Allocator>::~queue() {
   clear();
 }
 
-template <typename T>
-inline queue<T> &queue<T>::operator=(const queue<T> &other) noexcept {
+template <typename T, typename Allocator>
+inline queue<T, Allocator> &queue<T, Allocator>::operator=(
+    const queue &other) {
   if (this != &other) {
     clear();
-    queue<T> temp_queue;
-    auto temp_head = other.get_head();
-    while (temp_head != nullptr) {
-      temp_queue.push(temp_head->data_);
-      temp_head = temp_head->next_;
-    }
-
-    temp_head = temp_queue.get_head();
-    while (temp_head != nullptr) {
-      push(temp_head->data_);
-      temp_head = temp_head->next_;
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+      alloc_ = other.alloc_;
     }
-    temp_queue.clear();
+    append_from(other);
   }
   return *this;
 }
 
-template <typename T>
-inline queue<T> &queue<T>::operator=(queue<T> &&other) noexcept {
+// Same allocator rules as vector::operator=(vector &&).
+template <typename T, typename Allocator>
+inline queue<T, Allocator> &queue<T, Allocator>::operator=(
+    queue &&other) noexcept(
+    node_traits::propagate_on_container_move_assignment::value ||
+    node_traits::is_always_equal::value) {
   if (this != &other) {
     clear();
-    head_ = other.head_;
-    tail_ = other.tail_;
-    size_ = other.size_;
-    other.head_ = nullptr;
-    other.tail_ = nullptr;
-    other.size_ = 0;
+    if (node_traits::propagate_on_container_move_assignment::value ||
+        alloc_ == other.alloc_) {
+      if constexpr (node_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = std::move(other.alloc_);
+      }
+      head_ = other.head_;
+      tail_ = other.tail_;
+      size_ = other.size_;
+      other.head_ = nullptr;
+      other.tail_ = nullptr;
+      other.size_ = 0;
+    } else {
+      append_from(s21::move(other));
+      other.clear();
+    }
   }
   return *this;
 }
 
-template <typename T>
-inline typename queue<T>::const_reference queue<T>::front() const {
+template <typename T, typename Allocator>
+inline typename queue<T, Allocator>::const_reference
+queue<T, Allocator>::front() const {
   if (!head_) throw std::logic_error("queue is empty!");
   return head_->data_;
 }
 
-template <typename T>
-inline typename queue<T>::const_reference queue<T>::back() const {
+template <typename T, typename Allocator>
+inline typename queue<T, Allocator>::const_reference
+queue<T, Allocator>::back() const {
   if (!head_) throw std::logic_error("queue is empty!");
   return tail_->data_;
 }
 
-template <typename T>
-inline bool queue<T>::empty() const {
+template <typename T, typename Allocator>
+inline bool queue<T, Allocator>::empty() const {
   return size_ == 0;
 }
 
-template <typename T>
-inline typename queue<T>::size_type queue<T>::size() const {
+template <typename T, typename Allocator>
+inline typename queue<T, Allocator>::size_type queue<T, Allocator>::size()
+    const {
   return size_;
 }
 
-template <typename T>
-inline void queue<T>::push(const_reference value) {
-  Node_ *new_node = new Node_(value);
+template <typename T, typename Allocator>
+inline void queue<T, Allocator>::push(const_reference value) {
+  emplace(value);
+}
+
+template <typename T, typename Allocator>
+inline void queue<T, Allocator>::push(value_type &&value) {
+  emplace(s21::move(value));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+inline typename queue<T, Allocator>::reference queue<T, Allocator>::emplace(
+    Args &&...args) {
+  Node_ *new_node = create_node(nullptr, std::forward<Args>(args)...);
   if (tail_) {
     tail_->next_ = new_node;
   } else {
@@ -150,49 +211,81 @@ inline void queue<T>::push(const_reference value) {
   }
   tail_ = new_node;
   ++size_;
+  return new_node->data_;
 }
 
-template <typename T>
-inline void queue<T>::pop() {
+template <typename T, typename Allocator>
+inline void queue<T, Allocator>::pop() {
   if (!head_) throw std::logic_error("queue is empty!");
   Node_ *old_head = head_;
   head_ = head_->next_;
-  delete old_head;
+  destroy_node(old_head);
   --size_;
   if (!head_) tail_ = nullptr;
 }
 
-template <typename T>
-inline void queue<T>::swap(queue<T> &other) {
+// Same allocator rules as vector::swap().
+template <typename T, typename Allocator>
+inline void queue<T, Allocator>::swap(queue &other) {
   if (this != &other) {
-    Node_ *temp_head = head_;
-    head_ = other.head_;
-    other.head_ = temp_head;
-
-    Node_ *temp_tail = tail_;
-    tail_ = other.tail_;
-    other.tail_ = temp_tail;
-
-    size_t temp_size = size_;
-    size_ = other.size_;
-    other.size_ = temp_size;
+    if constexpr (node_traits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(size_, other.size_);
   }
 }
 
-template <typename T>
-inline void queue<T>::clear() {
+template <typename T, typename Allocator>
+inline void queue<T, Allocator>::clear() {
   while (head_) pop();
 }
 
-template <typename T>
-inline typename queue<T>::Node_ *queue<T>::get_head() const {
+template <typename T, typename Allocator>
+inline typename queue<T, Allocator>::Node_ *queue<T, Allocator>::get_head()
+    const {
   return head_;
 }
 
-template <typename T>
+template <typename T, typename Allocator>
+template <typename... Args>
+inline void queue<T, Allocator>::insert_many_back(Args &&...args) {
+  (emplace(std::forward<Args>(args)), ...);
+}
+
+template <typename T, typename Allocator>
 template <typename... Args>
-inline void queue<T>::insert_many_back(Args &&...args) {
-  (push(std::forward<Args>(args)), ...);
+inline typename queue<T, Allocator>::Node_ *queue<T, Allocator>::create_node(
+    Args &&...args) {
+  Node_ *node = node_traits::allocate(alloc_, 1);
+  try {
+    node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename T, typename Allocator>
+inline void queue<T, Allocator>::destroy_node(Node_ *node) noexcept {
+  node_traits::destroy(alloc_, node);
+  node_traits::deallocate(alloc_, node, 1);
+}
+
+// Copies other's elements to our back, or moves them when other is an
+// rvalue.
+template <typename T, typename Allocator>
+template <typename Source>
+inline void queue<T, Allocator>::append_from(Source &&other) {
+  for (Node_ *node = other.head_; node != nullptr; node = node->next_) {
+    if constexpr (std::is_lvalue_reference<Source>::value) {
+      emplace(node->data_);
+    } else {
+      emplace(s21::move(node->data_));
+    }
+  }
 }
 
 }  // namespace s21
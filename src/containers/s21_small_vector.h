@@ -0,0 +1,568 @@
+#ifndef S21_SMALL_VECTOR_H
+#define S21_SMALL_VECTOR_H
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Vector with room for N elements inside the object itself. It only goes to
+// the heap once it holds more than N elements, so short-lived small vectors
+// never allocate.
+template <typename T, size_t N, typename Allocator = std::allocator<T>,
+          typename Growth = growth_x2>
+class small_vector {
+  static_assert(N > 0, "small_vector needs a non-empty inline buffer");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using growth_policy = Growth;
+
+ private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+ public:
+  small_vector() noexcept;
+  explicit small_vector(const allocator_type &alloc) noexcept;
+  small_vector(size_type n, const allocator_type &alloc = allocator_type());
+  small_vector(const std::initializer_list<value_type> &items,
+               const allocator_type &alloc = allocator_type());
+  small_vector(const small_vector &other);
+  small_vector(const small_vector &other, const allocator_type &alloc);
+  small_vector(small_vector &&other) noexcept(
+      std::is_nothrow_move_constructible<T>::value);
+  ~small_vector();
+  small_vector &operator=(const small_vector &other);
+  small_vector &operator=(small_vector &&other) noexcept(
+      std::is_nothrow_move_constructible<T>::value &&
+      (alloc_traits::propagate_on_container_move_assignment::value ||
+       alloc_traits::is_always_equal::value));
+
+  allocator_type get_allocator() const { return alloc_; }
+
+  reference at(size_type pos);
+  reference operator[](size_type pos);
+  const_reference operator[](size_type pos) const;
+  const_reference front() const;
+  const_reference back() const;
+  T *data() noexcept { return data_; }
+  const T *data() const noexcept { return data_; }
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  bool empty() const;
+  size_type size() const;
+  size_type max_size();
+  void reserve(size_type size);
+  size_type capacity();
+  void shrink_to_fit();
+  bool is_inline() const noexcept { return data_ == inline_data(); }
+
+  void clear() noexcept;
+  iterator insert(iterator pos, const_reference value);
+  iterator insert(iterator pos, value_type &&value);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  iterator insert(const_iterator pos, InputIt first, InputIt last);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void assign(InputIt first, InputIt last);
+  void assign(std::initializer_list<value_type> items);
+  template <typename Range>
+  void append_range(Range &&range);
+  void erase(iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  void push_back(const_reference value);
+  void push_back(value_type &&value);
+  void pop_back();
+  void swap(small_vector &other);
+
+  // in-place construction
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args);
+  template <typename... Args>
+  reference emplace_back(Args &&...args);
+
+  // insert many
+  template <typename... Args>
+  iterator insert_many(const_iterator pos, Args &&...args);
+  template <typename... Args>
+  void insert_many_back(Args &&...args);
+
+ private:
+  size_type size_;
+  size_type capacity_;
+  T *data_;
+  allocator_type alloc_;
+  alignas(T) unsigned char buffer_[N * sizeof(T)];
+
+  T *inline_data() noexcept { return reinterpret_cast<T *>(buffer_); }
+  const T *inline_data() const noexcept {
+    return reinterpret_cast<const T *>(buffer_);
+  }
+  void release() noexcept;
+  void steal(small_vector &other);
+  void reallocate(size_type new_capacity);
+  void grow_for(size_type required);
+};
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline small_vector<T, N, Allocator, Growth>::small_vector() noexcept
+    : size_(0), capacity_(N), data_(inline_data()), alloc_() {}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline small_vector<T, N, Allocator, Growth>::small_vector(
+    const allocator_type &alloc) noexcept
+    : size_(0), capacity_(N), data_(inline_data()), alloc_(alloc) {}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline small_vector<T, N, Allocator, Growth>::small_vector(
+    size_type n, const allocator_type &alloc)
+    : small_vector(alloc) {
+  reserve(n);
+  for (; size_ < n; ++size_) {
+    alloc_traits::construct(alloc_, data_ + size_);
+  }
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline small_vector<T, N, Allocator, Growth>::small_vector(
+    const std::initializer_list<value_type> &items,
+    const allocator_type &alloc)
+    : small_vector(alloc) {
+  assign(items.begin(), items.end());
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline small_vector<T, N, Allocator, Growth>::small_vector(
+    const small_vector &other)
+    : small_vector(other, alloc_traits::select_on_container_copy_construction(
+                              other.alloc_)) {}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline small_vector<T, N, Allocator, Growth>::small_vector(
+    const small_vector &other, const allocator_type &alloc)
+    : small_vector(alloc) {
+  assign(other.data_, other.data_ + other.size_);
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline small_vector<T, N, Allocator, Growth>::small_vector(
+    small_vector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    : small_vector(other.alloc_) {
+  steal(other);
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline small_vector<T, N, Allocator, Growth>::~small_vector() {
+  release();
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline small_vector<T, N, Allocator, Growth> &
+small_vector<T, N, Allocator, Growth>::operator=(const small_vector &other) {
+  if (this != &other) {
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (alloc_ != other.alloc_) clear();
+      alloc_ = other.alloc_;
+    }
+    assign(other.data_, other.data_ + other.size_);
+  }
+  return *this;
+}
+
+// Same allocator rules as vector::operator=(vector &&).
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline small_vector<T, N, Allocator, Growth> &
+small_vector<T, N, Allocator, Growth>::operator=(small_vector &&other) noexcept(
+    std::is_nothrow_move_constructible<T>::value &&
+    (alloc_traits::propagate_on_container_move_assignment::value ||
+     alloc_traits::is_always_equal::value)) {
+  if (this != &other) {
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_ == other.alloc_) {
+      clear();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = std::move(other.alloc_);
+      }
+      steal(other);
+    } else {
+      assign(std::make_move_iterator(other.begin()),
+             std::make_move_iterator(other.end()));
+      other.clear();
+    }
+  }
+  return *this;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::reference
+small_vector<T, N, Allocator, Growth>::at(size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("Index out of range in small_vector::at");
+  }
+  return data_[pos];
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::reference
+small_vector<T, N, Allocator, Growth>::operator[](size_type pos) {
+  return data_[pos];
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::const_reference
+small_vector<T, N, Allocator, Growth>::operator[](size_type pos) const {
+  return data_[pos];
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::const_reference
+small_vector<T, N, Allocator, Growth>::front() const {
+  if (empty()) {
+    throw std::logic_error("Vector is empty!");
+  }
+  return data_[0];
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::const_reference
+small_vector<T, N, Allocator, Growth>::back() const {
+  if (empty()) {
+    throw std::logic_error("Vector is empty!");
+  }
+  return data_[size_ - 1];
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::iterator
+small_vector<T, N, Allocator, Growth>::begin() {
+  return data_;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::iterator
+small_vector<T, N, Allocator, Growth>::end() {
+  return data_ + size_;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::const_iterator
+small_vector<T, N, Allocator, Growth>::begin() const {
+  return data_;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::const_iterator
+small_vector<T, N, Allocator, Growth>::end() const {
+  return data_ + size_;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline bool small_vector<T, N, Allocator, Growth>::empty() const {
+  return size_ == 0;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::size_type
+small_vector<T, N, Allocator, Growth>::size() const {
+  return size_;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::size_type
+small_vector<T, N, Allocator, Growth>::max_size() {
+  return std::numeric_limits<size_type>::max() / sizeof(T) / 2;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::reserve(size_type size) {
+  if (size > max_size()) {
+    throw std::length_error("small_vector::reserve exceeds max_size");
+  }
+  if (size > capacity_) {
+    reallocate(size);
+  }
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::size_type
+small_vector<T, N, Allocator, Growth>::capacity() {
+  return capacity_;
+}
+
+// Moves the elements back inline when they fit there again.
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::shrink_to_fit() {
+  if (!is_inline() && capacity_ > size_) {
+    reallocate(size_);
+  }
+}
+
+// Keeps a heap block once it has one, so clearing and refilling past N
+// does not allocate again; shrink_to_fit() moves back inline.
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::clear() noexcept {
+  destroy_range(data_, data_ + size_);
+  size_ = 0;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::iterator
+small_vector<T, N, Allocator, Growth>::insert(iterator pos,
+                                              const_reference value) {
+  return emplace(pos, value);
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::iterator
+small_vector<T, N, Allocator, Growth>::insert(iterator pos,
+                                              value_type &&value) {
+  return emplace(pos, s21::move(value));
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <typename InputIt, typename>
+inline typename small_vector<T, N, Allocator, Growth>::iterator
+small_vector<T, N, Allocator, Growth>::insert(const_iterator pos, InputIt first,
+                                   InputIt last) {
+  size_type index = pos - data_;
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (!std::is_base_of<std::forward_iterator_tag, category>::value) {
+    small_vector buffer;
+    for (; first != last; ++first) {
+      buffer.emplace_back(*first);
+    }
+    return insert(begin() + index, std::make_move_iterator(buffer.begin()),
+                  std::make_move_iterator(buffer.end()));
+  } else {
+    size_type count = std::distance(first, last);
+    grow_for(size_ + count);
+    build_and_rotate(data_, size_, index, count, [&](T *dest) {
+      std::uninitialized_copy(first, last, dest);
+    });
+    return begin() + index;
+  }
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <typename InputIt, typename>
+inline void small_vector<T, N, Allocator, Growth>::assign(InputIt first,
+                                                   InputIt last) {
+  erase(begin(), end());
+  insert(begin(), first, last);
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::assign(
+    std::initializer_list<value_type> items) {
+  assign(items.begin(), items.end());
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <typename Range>
+inline void small_vector<T, N, Allocator, Growth>::append_range(Range &&range) {
+  insert(end(), std::begin(range), std::end(range));
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::erase(iterator pos) {
+  if (pos > end() || pos < begin()) throw std::out_of_range("out of range!");
+  if (pos == end()) {
+    pop_back();
+  } else {
+    erase(pos, pos + 1);
+  }
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline typename small_vector<T, N, Allocator, Growth>::iterator
+small_vector<T, N, Allocator, Growth>::erase(const_iterator first,
+                                             const_iterator last) {
+  if (first < data_ || first > last || last > data_ + size_) {
+    throw std::out_of_range("out of range!");
+  }
+  size_type index = first - data_;
+  size_type count = last - first;
+  if (count > 0) {
+    T *hole = data_ + index;
+    T *tail = hole + count;
+    if constexpr (is_trivially_relocatable<T>::value) {
+      destroy_range(hole, tail);
+      std::memmove(static_cast<void *>(hole), static_cast<const void *>(tail),
+                   (data_ + size_ - tail) * sizeof(T));
+    } else {
+      destroy_range(std::move(tail, data_ + size_, hole), data_ + size_);
+    }
+    size_ -= count;
+  }
+  return begin() + index;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::push_back(
+    const_reference value) {
+  emplace_back(value);
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::push_back(
+    value_type &&value) {
+  emplace_back(s21::move(value));
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::pop_back() {
+  if (size() == 0) {
+    throw std::out_of_range("Cannot pop from an empty vector");
+  }
+  --size_;
+  data_[size_].~value_type();
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::swap(small_vector &other) {
+  if (this != &other) {
+    small_vector temp(s21::move(other));
+    other = s21::move(*this);
+    *this = s21::move(temp);
+  }
+}
+
+// The element is built before any storage changes, so args may refer to
+// elements of this vector.
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <typename... Args>
+inline typename small_vector<T, N, Allocator, Growth>::iterator
+small_vector<T, N, Allocator, Growth>::emplace(const_iterator pos,
+                                               Args &&...args) {
+  size_type index = pos - data_;
+  if (index == size_) {
+    emplace_back(std::forward<Args>(args)...);
+  } else {
+    value_type item(std::forward<Args>(args)...);
+    grow_for(size_ + 1);
+    open_gap_range(data_ + index, data_ + size_, 1);
+    alloc_traits::construct(alloc_, data_ + index, s21::move(item));
+    ++size_;
+  }
+  return begin() + index;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <typename... Args>
+inline typename small_vector<T, N, Allocator, Growth>::reference
+small_vector<T, N, Allocator, Growth>::emplace_back(Args &&...args) {
+  if (size_ == capacity_) {
+    value_type item(std::forward<Args>(args)...);
+    grow_for(size_ + 1);
+    alloc_traits::construct(alloc_, data_ + size_, s21::move(item));
+  } else {
+    alloc_traits::construct(alloc_, data_ + size_,
+                            std::forward<Args>(args)...);
+  }
+  ++size_;
+  return data_[size_ - 1];
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <typename... Args>
+inline typename small_vector<T, N, Allocator, Growth>::iterator
+small_vector<T, N, Allocator, Growth>::insert_many(const_iterator pos,
+                                                   Args &&...args) {
+  size_type index = pos - data_;
+  size_type num_new_elements = sizeof...(args);
+
+  if (size_ + num_new_elements > capacity_) {
+    // args may refer to elements that growing is about to move, so they
+    // are built into a buffer of their own first.
+    small_vector items(alloc_);
+    items.reserve(num_new_elements);
+    construct_each(alloc_, items.data_, std::forward<Args>(args)...);
+    items.size_ = num_new_elements;
+    return insert(begin() + index, std::make_move_iterator(items.begin()),
+                  std::make_move_iterator(items.end()));
+  }
+  build_and_rotate(data_, size_, index, num_new_elements, [&](T *dest) {
+    construct_each(alloc_, dest, std::forward<Args>(args)...);
+  });
+  return begin() + index;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <typename... Args>
+inline void small_vector<T, N, Allocator, Growth>::insert_many_back(
+    Args &&...args) {
+  insert_many(end(), std::forward<Args>(args)...);
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::release() noexcept {
+  destroy_range(data_, data_ + size_);
+  if (!is_inline()) {
+    alloc_traits::deallocate(alloc_, data_, capacity_);
+  }
+}
+
+// Takes other's heap block as is, or relocates its inline elements into
+// this (empty, inline) buffer. Leaves other empty and inline.
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::steal(small_vector &other) {
+  if (other.is_inline()) {
+    data_ = inline_data();
+    capacity_ = N;
+    relocate_range(other.data_, other.data_ + other.size_, data_);
+  } else {
+    data_ = other.data_;
+    capacity_ = other.capacity_;
+  }
+  size_ = other.size_;
+  other.data_ = other.inline_data();
+  other.size_ = 0;
+  other.capacity_ = N;
+}
+
+// Capacities up to N live in the inline buffer, larger ones on the heap.
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::reallocate(
+    size_type new_capacity) {
+  T *new_data = inline_data();
+  if (new_capacity > N) {
+    new_data = alloc_traits::allocate(alloc_, new_capacity);
+  } else {
+    new_capacity = N;
+  }
+  if (new_data == data_) return;
+  try {
+    relocate_range(data_, data_ + size_, new_data);
+  } catch (...) {
+    if (new_data != inline_data()) {
+      alloc_traits::deallocate(alloc_, new_data, new_capacity);
+    }
+    throw;
+  }
+  if (!is_inline()) alloc_traits::deallocate(alloc_, data_, capacity_);
+  data_ = new_data;
+  capacity_ = new_capacity;
+}
+
+template <typename T, size_t N, typename Allocator, typename Growth>
+inline void small_vector<T, N, Allocator, Growth>::grow_for(
+    size_type required) {
+  if (required > capacity_) {
+    reallocate(Growth::next_capacity(capacity_, required));
+  }
+}
+
+}  // namespace s21
+
+#endif
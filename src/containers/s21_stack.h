@@ -2,9 +2,12 @@
 #define S21_STACK_H
 
 #include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class stack {
  private:
   class Node_ {
@@ -12,33 +15,50 @@ class stack {
     T data_;
     Node_ *next_;
 
-    Node_(const T &value = T(), Node_ *next = nullptr)
-        : data_(value), next_(next) {}
+    template <typename... Args>
+    explicit Node_(Node_ *next, Args &&...args)
+        : data_(std::forward<Args>(args)...), next_(next) {}
   };
 
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node_>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
   Node_ *head_;
   size_t size_;
+  node_allocator alloc_;
 
  public:
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
   using size_type = size_t;
+  using allocator_type = Allocator;
 
   // constructors & destructor
   stack() noexcept;
-  stack(const std::initializer_list<value_type> &items) noexcept;
+  explicit stack(const allocator_type &alloc) noexcept;
+  stack(const std::initializer_list<value_type> &items,
+        const allocator_type &alloc = allocator_type());
   stack(const stack &other);
+  stack(const stack &other, const allocator_type &alloc);
   stack(stack &&other) noexcept;
   ~stack();
 
-  stack &operator=(const stack &other) noexcept;
-  stack &operator=(stack &&other) noexcept;
+  stack &operator=(const stack &other);
+  stack &operator=(stack &&other) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value);
+
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
 
   const_reference top() const;
   bool empty() const;
   size_type size() const;
   void push(const_reference value);
+  void push(value_type &&value);
+  template <typename... Args>
+  reference emplace(Args &&...args);
   void pop();
   void swap(stack &other);
 
@@ -51,130 +71,210 @@ class stack {
   // get_head() function can be used to loop through the stack items from
   // outside the library
   Node_ *get_head() const;
+
+ private:
+  template <typename... Args>
+  Node_ *create_node(Args &&...args);
+  void destroy_node(Node_ *node) noexcept;
+  template <typename Source>
+  void append_from(Source &&other);
 };
 
-template <typename T>
-inline stack<T>::stack() noexcept : head_(nullptr), size_(0) {}
+template <typename T, typename Allocator>
+inline stack<T, Allocator>::stack() noexcept
+    : head_(nullptr), size_(0), alloc_() {}
 
-template <typename T>
-inline stack<T>::stack(const std::initializer_list<value_type> &items) noexcept
-    : head_(nullptr), size_(0) {
-  for (value_type i : items) {
+template <typename T, typename Allocator>
+inline stack<T, Allocator>::stack(const allocator_type &alloc) noexcept
+    : head_(nullptr), size_(0), alloc_(alloc) {}
+
+template <typename T, typename Allocator>
+inline stack<T, Allocator>::stack(
+    const std::initializer_list<value_type> &items,
+    const allocator_type &alloc)
+    : stack(alloc) {
+  for (const value_type &i : items) {
     push(i);
   }
 }
 
-template <typename T>
-inline stack<T>::stack(const stack<T> &other) : head_(nullptr), size_(0) {
-  *this = other;
+template <typename T, typename Allocator>
+inline stack<T, Allocator>::stack(const stack &other)
+    : stack(std::allocator_traits<allocator_type>::
+                select_on_container_copy_construction(
+                    other.get_allocator())) {
+  append_from(other);
 }
 
-template <typename T>
-inline stack<T>::stack(stack<T> &&other) noexcept : head_(nullptr), size_(0) {
-  *this = s21::move(other);
+template <typename T, typename Allocator>
+inline stack<T, Allocator>::stack(const stack &other,
+                                  const allocator_type &alloc)
+    : stack(alloc) {
+  append_from(other);
 }
 
-template <typename T>
-inline stack<T>::~stack() {
+template <typename T, typename Allocator>
+inline stack<T, Allocator>::stack(stack &&other) noexcept
+    : head_(other.head_), size_(other.size_), alloc_(std::move(other.alloc_)) {
+  other.head_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename T, typename Allocator>
+inline stack<T, Allocator>::~stack() {
   clear();
 }
 
-template <typename T>
-inline stack<T> &stack<T>::operator=(const stack<T> &other) noexcept {
+template <typename T, typename Allocator>
+inline stack<T, Allocator> &stack<T, Allocator>::operator=(
+    const stack &other) {
   if (this != &other) {
     clear();
-    stack<T> temp_stack;
-    auto temp_head = other.get_head();
-    while (temp_head != nullptr) {
-      temp_stack.push(temp_head->data_);
-      temp_head = temp_head->next_;
-    }
-    temp_head = temp_stack.get_head();
-    while (temp_head != nullptr) {
-      push(temp_head->data_);
-      temp_head = temp_head->next_;
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+      alloc_ = other.alloc_;
     }
-    temp_stack.clear();
+    append_from(other);
   }
   return *this;
 }
 
-template <typename T>
-inline stack<T> &stack<T>::operator=(stack<T> &&other) noexcept {
+// Same allocator rules as vector::operator=(vector &&).
+template <typename T, typename Allocator>
+inline stack<T, Allocator> &stack<T, Allocator>::operator=(
+    stack &&other) noexcept(
+    node_traits::propagate_on_container_move_assignment::value ||
+    node_traits::is_always_equal::value) {
   if (this != &other) {
     clear();
-    head_ = other.head_;
-    size_ = other.size_;
-    other.head_ = nullptr;
-    other.size_ = 0;
+    if (node_traits::propagate_on_container_move_assignment::value ||
+        alloc_ == other.alloc_) {
+      if constexpr (node_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = std::move(other.alloc_);
+      }
+      head_ = other.head_;
+      size_ = other.size_;
+      other.head_ = nullptr;
+      other.size_ = 0;
+    } else {
+      append_from(s21::move(other));
+      other.clear();
+    }
   }
   return *this;
 }
 
-template <typename T>
-inline typename stack<T>::const_reference stack<T>::top() const {
+template <typename T, typename Allocator>
+inline typename stack<T, Allocator>::const_reference stack<T, Allocator>::top()
+    const {
   if (!head_) throw std::logic_error("stack is empty!");
   return head_->data_;
 }
 
-template <typename T>
-inline bool stack<T>::empty() const {
+template <typename T, typename Allocator>
+inline bool stack<T, Allocator>::empty() const {
   return size_ == 0;
 }
 
-template <typename T>
-inline typename stack<T>::size_type stack<T>::size() const {
+template <typename T, typename Allocator>
+inline typename stack<T, Allocator>::size_type stack<T, Allocator>::size()
+    const {
   return size_;
 }
 
-template <typename T>
-inline void stack<T>::push(const_reference value) {
-  Node_ *new_node = new Node_(value);
-  if (!head_) {
-    head_ = new_node;
-  } else {
-    new_node->next_ = head_;
-    head_ = new_node;
-  }
+template <typename T, typename Allocator>
+inline void stack<T, Allocator>::push(const_reference value) {
+  emplace(value);
+}
+
+template <typename T, typename Allocator>
+inline void stack<T, Allocator>::push(value_type &&value) {
+  emplace(s21::move(value));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+inline typename stack<T, Allocator>::reference stack<T, Allocator>::emplace(
+    Args &&...args) {
+  head_ = create_node(head_, std::forward<Args>(args)...);
   ++size_;
+  return head_->data_;
 }
 
-template <typename T>
-inline void stack<T>::pop() {
+template <typename T, typename Allocator>
+inline void stack<T, Allocator>::pop() {
   if (!head_) throw std::logic_error("stack is empty!");
   Node_ *old_head = head_;
   head_ = head_->next_;
-  delete old_head;
+  destroy_node(old_head);
   --size_;
 }
 
-template <typename T>
-inline void stack<T>::swap(stack<T> &other) {
+// Same allocator rules as vector::swap().
+template <typename T, typename Allocator>
+inline void stack<T, Allocator>::swap(stack &other) {
   if (this != &other) {
-    Node_ *temp = head_;
-    head_ = other.head_;
-    other.head_ = temp;
-
-    size_type temp_size = size_;
-    size_ = other.size_;
-    other.size_ = temp_size;
+    if constexpr (node_traits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
   }
 }
 
-template <typename T>
-inline void stack<T>::clear() {
+template <typename T, typename Allocator>
+inline void stack<T, Allocator>::clear() {
   while (head_) pop();
 }
 
-template <typename T>
-inline typename stack<T>::Node_ *stack<T>::get_head() const {
+template <typename T, typename Allocator>
+inline typename stack<T, Allocator>::Node_ *stack<T, Allocator>::get_head()
+    const {
   return head_;
 }
 
-template <typename T>
+template <typename T, typename Allocator>
+template <typename... Args>
+inline void stack<T, Allocator>::insert_many_back(Args &&...args) {
+  (emplace(std::forward<Args>(args)), ...);
+}
+
+template <typename T, typename Allocator>
 template <typename... Args>
-inline void stack<T>::insert_many_back(Args &&...args) {
-  (push(std::forward<Args>(args)), ...);
+inline typename stack<T, Allocator>::Node_ *stack<T, Allocator>::create_node(
+    Args &&...args) {
+  Node_ *node = node_traits::allocate(alloc_, 1);
+  try {
+    node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename T, typename Allocator>
+inline void stack<T, Allocator>::destroy_node(Node_ *node) noexcept {
+  node_traits::destroy(alloc_, node);
+  node_traits::deallocate(alloc_, node, 1);
+}
+
+// Appends other's elements below our bottom, keeping their order, so an
+// empty stack ends up as a copy of other.
+template <typename T, typename Allocator>
+template <typename Source>
+inline void stack<T, Allocator>::append_from(Source &&other) {
+  Node_ **link = &head_;
+  while (*link) link = &(*link)->next_;
+  for (Node_ *node = other.head_; node != nullptr; node = node->next_) {
+    if constexpr (std::is_lvalue_reference<Source>::value) {
+      *link = create_node(nullptr, node->data_);
+    } else {
+      *link = create_node(nullptr, s21::move(node->data_));
+    }
+    link = &(*link)->next_;
+    ++size_;
+  }
 }
 
 }  // namespace s21
@@ -1,12 +1,130 @@
 #ifndef S21_VECTOR_H
 #define S21_VECTOR_H
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace s21 {
+
+// Growth policies pick the next capacity once the vector runs out of room.
+// A geometric factor keeps repeated push_back amortized O(1): the total
+// number of element relocations stays proportional to the final size.
+template <size_t Num, size_t Den>
+struct geometric_growth {
+  static_assert(Den > 0 && Num > Den, "growth factor must be greater than 1");
+
+  static constexpr size_t next_capacity(size_t capacity,
+                                        size_t required) noexcept {
+    size_t grown = capacity + capacity / Den * (Num - Den) +
+                   capacity % Den * (Num - Den) / Den;
+    if (grown <= capacity) grown = capacity + 1;
+    return grown < required ? required : grown;
+  }
+};
+
+using growth_x2 = geometric_growth<2, 1>;
+using growth_x1_5 = geometric_growth<3, 2>;
+
+// A type is trivially relocatable when moving it to a new address and
+// dropping the old bytes is the same as a plain memcpy. Trivially copyable
+// types always are; specialize this for others known to be safe (e.g. types
+// that own a heap pointer but hold no pointer into themselves).
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline void destroy_range(T *first, T *last) noexcept {
+  for (; first != last; ++first) {
+    first->~T();
+  }
+}
+
+// Builds [first, last) at dest, which must not overlap the source, and
+// destroys the source objects. Trivially relocatable types are copied as
+// bytes; others are moved when the move cannot throw and copied otherwise,
+// so a throwing element leaves the source untouched.
 template <typename T>
+inline void relocate_range(T *first, T *last, T *dest) {
+  if constexpr (is_trivially_relocatable<T>::value) {
+    if (first != last) {
+      std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first),
+                  (last - first) * sizeof(T));
+    }
+  } else {
+    T *out = dest;
+    try {
+      for (T *i = first; i != last; ++i, ++out) {
+        ::new (static_cast<void *>(out)) T(std::move_if_noexcept(*i));
+      }
+    } catch (...) {
+      destroy_range(dest, out);
+      throw;
+    }
+    destroy_range(first, last);
+  }
+}
+
+// Moves [first, last) count slots to the right, into raw memory past last,
+// and leaves [first, first + count) unconstructed.
+template <typename T>
+inline void open_gap_range(T *first, T *last, size_t count) {
+  if (count == 0) return;
+  if constexpr (is_trivially_relocatable<T>::value) {
+    std::memmove(static_cast<void *>(first + count),
+                 static_cast<const void *>(first),
+                 (last - first) * sizeof(T));
+  } else {
+    while (last != first) {
+      --last;
+      ::new (static_cast<void *>(last + count)) T(std::move(*last));
+      last->~T();
+    }
+  }
+}
+
+// Constructs dest[0], dest[1], ... from args in order through the
+// allocator. If one throws, the elements already built are destroyed.
+template <typename Allocator, typename T, typename... Args>
+inline void construct_each(Allocator &alloc, T *dest, Args &&...args) {
+  T *out = dest;
+  try {
+    ((std::allocator_traits<Allocator>::construct(alloc, out,
+                                                  std::forward<Args>(args)),
+      ++out),
+     ...);
+  } catch (...) {
+    destroy_range(dest, out);
+    throw;
+  }
+}
+
+// Inserts count elements at data + index into a buffer of size live objects
+// with room for count more. build(dest) constructs the new elements at
+// [dest, dest + count) past the end, or throws with nothing left behind.
+// Nothing has moved yet at that point, so build may read the existing
+// elements and a throw leaves the buffer as it was. The new elements are
+// then rotated into place; size is bumped first, so a move that throws
+// mid-rotate still leaves every counted slot live.
+template <typename T, typename Build>
+inline void build_and_rotate(T *data, size_t &size, size_t index,
+                             size_t count, Build &&build) {
+  build(data + size);
+  size += count;
+  std::rotate(data + index, data + size - count, data + size);
+}
+
+template <typename T, typename Allocator = std::allocator<T>,
+          typename Growth = growth_x2>
 class vector {
+  using alloc_traits = std::allocator_traits<Allocator>;
+
  public:
   using value_type = T;
   using reference = T &;
@@ -14,23 +132,37 @@ class vector {
   using iterator = T *;
   using const_iterator = const T *;
   using size_type = size_t;
+  using allocator_type = Allocator;
+  using growth_policy = Growth;
 
   vector() noexcept;
-  vector(size_type n);
-  vector(const std::initializer_list<value_type> &items);
+  explicit vector(const allocator_type &alloc) noexcept;
+  vector(size_type n, const allocator_type &alloc = allocator_type());
+  vector(const std::initializer_list<value_type> &items,
+         const allocator_type &alloc = allocator_type());
   vector(const vector &other);
+  vector(const vector &other, const allocator_type &alloc);
   vector(vector &&other) noexcept;
   ~vector();
-  vector &operator=(vector &&other) noexcept;
+  vector &operator=(const vector &other);
+  vector &operator=(vector &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value);
+
+  allocator_type get_allocator() const { return alloc_; }
 
   reference at(size_type pos);
   reference operator[](size_type pos);
+  const_reference operator[](size_type pos) const;
   const_reference front() const;
   const_reference back() const;
   T *data() noexcept { return data_; }
+  const T *data() const noexcept { return data_; }
 
   iterator begin();
   iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
 
   bool empty() const;
   size_type size() const;
@@ -41,11 +173,29 @@ class vector {
 
   void clear() noexcept;
   iterator insert(iterator pos, const_reference value);
+  iterator insert(iterator pos, value_type &&value);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  iterator insert(const_iterator pos, InputIt first, InputIt last);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void assign(InputIt first, InputIt last);
+  void assign(std::initializer_list<value_type> items);
+  template <typename Range>
+  void append_range(Range &&range);
   void erase(iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
   void push_back(const_reference value);
+  void push_back(value_type &&value);
   void pop_back();
   void swap(vector &other);
 
+  // in-place construction
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args);
+  template <typename... Args>
+  reference emplace_back(Args &&...args);
+
   // insert many
   template <typename... Args>
   iterator insert_many(const_iterator pos, Args &&...args);
@@ -56,201 +206,393 @@ class vector {
   size_type size_;
   size_type capacity_;
   T *data_;
+  allocator_type alloc_;
+
+  // Storage is raw memory: only [data_, data_ + size_) holds live objects,
+  // the rest of the capacity is never constructed.
+  T *allocate(size_type n);
+  void deallocate(T *ptr, size_type n) noexcept;
+  void release() noexcept;
+  void reallocate(size_type new_capacity);
+  void open_gap(size_type index, size_type count);
+  template <typename... Args>
+  void construct_at(T *ptr, Args &&...args);
+  template <typename... Args>
+  void realloc_insert(size_type index, Args &&...args);
+  template <typename Build>
+  void realloc_build(size_type index, size_type count, Build &&build);
 };
 
-template <typename T>
-inline vector<T>::vector() noexcept : size_(0), capacity_(0), data_(nullptr) {}
-
-template <typename T>
-inline vector<T>::vector(size_type n) : size_(n), capacity_(n), data_(nullptr) {
-  if (size_ > 0) {
-    data_ = new value_type[size_];
+template <typename T, typename Allocator, typename Growth>
+inline vector<T, Allocator, Growth>::vector() noexcept
+    : size_(0), capacity_(0), data_(nullptr), alloc_() {}
+
+template <typename T, typename Allocator, typename Growth>
+inline vector<T, Allocator, Growth>::vector(
+    const allocator_type &alloc) noexcept
+    : size_(0), capacity_(0), data_(nullptr), alloc_(alloc) {}
+
+template <typename T, typename Allocator, typename Growth>
+inline vector<T, Allocator, Growth>::vector(size_type n,
+                                            const allocator_type &alloc)
+    : vector(alloc) {
+  reserve(n);
+  for (; size_ < n; ++size_) {
+    construct_at(data_ + size_);
   }
 }
 
-template <typename T>
-inline vector<T>::vector(const std::initializer_list<value_type> &items)
-    : size_(0), capacity_(0), data_(nullptr) {
+template <typename T, typename Allocator, typename Growth>
+inline vector<T, Allocator, Growth>::vector(
+    const std::initializer_list<value_type> &items,
+    const allocator_type &alloc)
+    : vector(alloc) {
+  reserve(items.size());
   for (const value_type &i : items) {
     push_back(i);
   }
 }
 
-template <typename T>
-inline vector<T>::vector(const vector &other)
-    : size_(other.size_), capacity_(other.capacity_) {
-  data_ = new value_type[capacity_];
-  for (size_t i = 0; i < size_; i++) {
-    data_[i] = other.data_[i];
+template <typename T, typename Allocator, typename Growth>
+inline vector<T, Allocator, Growth>::vector(const vector &other)
+    : vector(other, alloc_traits::select_on_container_copy_construction(
+                        other.alloc_)) {}
+
+template <typename T, typename Allocator, typename Growth>
+inline vector<T, Allocator, Growth>::vector(const vector &other,
+                                            const allocator_type &alloc)
+    : vector(alloc) {
+  data_ = allocate(other.capacity_);
+  capacity_ = other.capacity_;
+  for (; size_ < other.size_; ++size_) {
+    construct_at(data_ + size_, other.data_[size_]);
   }
 }
 
-template <typename T>
-inline vector<T>::vector(vector &&other) noexcept
-    : size_(0), capacity_(0), data_(nullptr) {
-  *this = s21::move(other);
+template <typename T, typename Allocator, typename Growth>
+inline vector<T, Allocator, Growth>::vector(vector &&other) noexcept
+    : size_(other.size_),
+      capacity_(other.capacity_),
+      data_(other.data_),
+      alloc_(std::move(other.alloc_)) {
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.capacity_ = 0;
 }
 
-template <typename T>
-inline vector<T>::~vector() {
-  delete[] data_;
+template <typename T, typename Allocator, typename Growth>
+inline vector<T, Allocator, Growth>::~vector() {
+  release();
 }
 
-template <typename T>
-inline vector<T> &vector<T>::operator=(vector &&other) noexcept {
+// A propagating allocator that differs from ours cannot free our block,
+// so the old storage goes back to the old allocator first.
+template <typename T, typename Allocator, typename Growth>
+inline vector<T, Allocator, Growth> &vector<T, Allocator, Growth>::operator=(
+    const vector &other) {
   if (this != &other) {
-    delete[] data_;
-    data_ = other.data_;
-    size_ = other.size_;
-    capacity_ = other.capacity_;
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (alloc_ != other.alloc_) clear();
+      alloc_ = other.alloc_;
+    }
+    assign(other.data_, other.data_ + other.size_);
+  }
+  return *this;
+}
 
-    other.data_ = nullptr;
-    other.size_ = 0;
-    other.capacity_ = 0;
+// The block changes hands only when this vector may free it afterwards:
+// either the allocator travels with it or both allocators are equal.
+// Otherwise the elements are moved one by one into storage of our own.
+// The other containers move their storage and swap by the same rules.
+template <typename T, typename Allocator, typename Growth>
+inline vector<T, Allocator, Growth> &vector<T, Allocator, Growth>::operator=(
+    vector &&other) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value ||
+    alloc_traits::is_always_equal::value) {
+  if (this != &other) {
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_ == other.alloc_) {
+      release();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = std::move(other.alloc_);
+      }
+      data_ = other.data_;
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+
+      other.data_ = nullptr;
+      other.size_ = 0;
+      other.capacity_ = 0;
+    } else {
+      assign(std::make_move_iterator(other.begin()),
+             std::make_move_iterator(other.end()));
+      other.clear();
+    }
   }
   return *this;
 }
 
-template <typename T>
-inline typename vector<T>::reference vector<T>::at(size_type pos) {
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::reference
+vector<T, Allocator, Growth>::at(size_type pos) {
   if (pos >= size_) {
     throw std::out_of_range("Index out of range in vector::at");
   }
   return data_[pos];
 }
 
-template <typename T>
-inline typename vector<T>::reference vector<T>::operator[](size_type pos) {
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::reference
+vector<T, Allocator, Growth>::operator[](size_type pos) {
   return data_[pos];
 }
 
-template <typename T>
-inline typename vector<T>::const_reference vector<T>::front() const {
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::const_reference
+vector<T, Allocator, Growth>::operator[](size_type pos) const {
+  return data_[pos];
+}
+
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::const_reference
+vector<T, Allocator, Growth>::front() const {
   if (empty()) {
     throw std::logic_error("Vector is empty!");
   }
   return data_[0];
 }
 
-template <typename T>
-inline typename vector<T>::const_reference vector<T>::back() const {
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::const_reference
+vector<T, Allocator, Growth>::back() const {
   if (empty()) {
     throw std::logic_error("Vector is empty!");
   }
   return data_[size_ - 1];
 }
 
-template <typename T>
-inline typename vector<T>::iterator vector<T>::begin() {
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::iterator
+vector<T, Allocator, Growth>::begin() {
   return data_;
 }
 
-template <typename T>
-inline typename vector<T>::iterator vector<T>::end() {
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::iterator
+vector<T, Allocator, Growth>::end() {
   return data_ + size_;
 }
 
-template <typename T>
-inline bool vector<T>::empty() const {
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::const_iterator
+vector<T, Allocator, Growth>::begin() const {
+  return data_;
+}
+
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::const_iterator
+vector<T, Allocator, Growth>::end() const {
+  return data_ + size_;
+}
+
+template <typename T, typename Allocator, typename Growth>
+inline bool vector<T, Allocator, Growth>::empty() const {
   return size_ == 0;
 }
 
-template <typename T>
-inline typename vector<T>::size_type vector<T>::size() const {
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::size_type
+vector<T, Allocator, Growth>::size() const {
   return size_;
 }
 
-template <typename T>
-inline typename vector<T>::size_type vector<T>::max_size() {
-  return std::numeric_limits<size_type>::max() / sizeof(T) / 2;
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::size_type
+vector<T, Allocator, Growth>::max_size() {
+  return std::min<size_type>(
+      std::numeric_limits<size_type>::max() / sizeof(T) / 2,
+      alloc_traits::max_size(alloc_));
 }
 
-template <typename T>
-inline void vector<T>::reserve(size_type size) {
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::reserve(size_type size) {
+  if (size > max_size()) {
+    throw std::length_error("vector::reserve exceeds max_size");
+  }
   if (size > capacity_) {
-    value_type *new_data = new value_type[size];
-    for (size_type i = 0; i < size_; i++) {
-      new_data[i] = data_[i];
-    }
-    data_ = nullptr;
-    data_ = new_data;
-    capacity_ = size;
+    reallocate(size);
   }
 }
 
-template <typename T>
-inline typename vector<T>::size_type vector<T>::capacity() {
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::size_type
+vector<T, Allocator, Growth>::capacity() {
   return capacity_;
 }
 
-template <typename T>
-inline void vector<T>::shrink_to_fit() {
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::shrink_to_fit() {
   if (capacity_ > size_) {
-    value_type *new_data = new value_type[size_];
-    for (size_type i = 0; i < size_; i++) {
-      new_data[i] = data_[i];
-    }
-    delete[] data_;
-    data_ = new_data;
-    capacity_ = size_;
+    reallocate(size_);
   }
 }
 
-template <typename T>
-inline void vector<T>::clear() noexcept {
-  if (capacity_ > 0) {
-    delete[] data_;
-    data_ = nullptr;
-  }
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::clear() noexcept {
+  release();
+  data_ = nullptr;
   size_ = 0;
   capacity_ = 0;
 }
 
-template <typename T>
-inline typename vector<T>::iterator vector<T>::insert(iterator pos,
-                                                      const_reference value) {
-  size_type index = pos - begin();
-  if (size_ == capacity_)
-    reserve(capacity_ + (index > capacity_ ? (index - capacity_) : 1));
-  for (size_type i = size_; i > index; --i) {
-    data_[i] = data_[i - 1];
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::iterator
+vector<T, Allocator, Growth>::insert(iterator pos, const_reference value) {
+  return emplace(pos, value);
+}
+
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::iterator
+vector<T, Allocator, Growth>::insert(iterator pos, value_type &&value) {
+  return emplace(pos, s21::move(value));
+}
+
+// Range insertion reallocates at most once, whatever the length of
+// [first, last). The new elements are built before any existing one moves,
+// so a throwing copy leaves the vector as it was.
+template <typename T, typename Allocator, typename Growth>
+template <typename InputIt, typename>
+inline typename vector<T, Allocator, Growth>::iterator
+vector<T, Allocator, Growth>::insert(const_iterator pos, InputIt first,
+                                     InputIt last) {
+  size_type index = pos - data_;
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (!std::is_base_of<std::forward_iterator_tag, category>::value) {
+    // Single-pass input: the length is unknown until it is consumed.
+    vector buffer(alloc_);
+    for (; first != last; ++first) {
+      buffer.emplace_back(*first);
+    }
+    return insert(pos, std::make_move_iterator(buffer.begin()),
+                  std::make_move_iterator(buffer.end()));
+  } else {
+    size_type count = std::distance(first, last);
+    if (count == 0) return begin() + index;
+    auto build = [&](T *dest) { std::uninitialized_copy(first, last, dest); };
+    if (size_ + count > capacity_) {
+      realloc_build(index, count, build);
+    } else {
+      build_and_rotate(data_, size_, index, count, build);
+    }
+    return begin() + index;
   }
-  data_[index] = value;
-  ++size_;
-  return begin() + index;
 }
 
-template <typename T>
-inline void vector<T>::erase(iterator pos) {
-  if (pos > end() || pos < begin()) throw std::out_of_range("out of range!");
-  if (pos >= begin() && pos < end()) {
-    for (auto i = pos; i != end() - 1; ++i) {
-      *i = *(i + 1);
+template <typename T, typename Allocator, typename Growth>
+template <typename InputIt, typename>
+inline void vector<T, Allocator, Growth>::assign(InputIt first, InputIt last) {
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (!std::is_base_of<std::forward_iterator_tag, category>::value) {
+    erase(begin(), end());
+    insert(begin(), first, last);
+  } else {
+    size_type count = std::distance(first, last);
+    if (count > capacity_) {
+      T *new_data = allocate(count);
+      try {
+        std::uninitialized_copy(first, last, new_data);
+      } catch (...) {
+        deallocate(new_data, count);
+        throw;
+      }
+      release();
+      data_ = new_data;
+      capacity_ = count;
+    } else if (count > size_) {
+      InputIt mid = std::next(first, size_);
+      std::copy(first, mid, data_);
+      std::uninitialized_copy(mid, last, data_ + size_);
+    } else {
+      destroy_range(std::copy(first, last, data_), data_ + size_);
     }
+    size_ = count;
   }
-  --size_;
 }
 
-template <typename T>
-inline void vector<T>::push_back(const_reference value) {
-  if (size_ == capacity_) {
-    reserve(capacity_ + 1);
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::assign(
+    std::initializer_list<value_type> items) {
+  assign(items.begin(), items.end());
+}
+
+template <typename T, typename Allocator, typename Growth>
+template <typename Range>
+inline void vector<T, Allocator, Growth>::append_range(Range &&range) {
+  insert(end(), std::begin(range), std::end(range));
+}
+
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::erase(iterator pos) {
+  if (pos > end() || pos < begin()) throw std::out_of_range("out of range!");
+  if (pos == end()) {
+    pop_back();
+  } else {
+    erase(pos, pos + 1);
   }
-  data_[size_] = value;
-  ++size_;
 }
 
-template <typename T>
-inline void vector<T>::pop_back() {
+template <typename T, typename Allocator, typename Growth>
+inline typename vector<T, Allocator, Growth>::iterator
+vector<T, Allocator, Growth>::erase(const_iterator first,
+                                    const_iterator last) {
+  if (first < data_ || first > last || last > data_ + size_) {
+    throw std::out_of_range("out of range!");
+  }
+  size_type index = first - data_;
+  size_type count = last - first;
+  if (count > 0) {
+    T *hole = data_ + index;
+    T *tail = hole + count;
+    if constexpr (is_trivially_relocatable<T>::value) {
+      destroy_range(hole, tail);
+      std::memmove(static_cast<void *>(hole), static_cast<const void *>(tail),
+                   (data_ + size_ - tail) * sizeof(T));
+    } else {
+      destroy_range(std::move(tail, data_ + size_, hole), data_ + size_);
+    }
+    size_ -= count;
+  }
+  return begin() + index;
+}
+
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::push_back(const_reference value) {
+  emplace_back(value);
+}
+
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::push_back(value_type &&value) {
+  emplace_back(s21::move(value));
+}
+
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::pop_back() {
   if (size() == 0) {
     throw std::out_of_range("Cannot pop from an empty vector");
   }
   --size_;
+  data_[size_].~value_type();
 }
 
-template <typename T>
-inline void vector<T>::swap(vector &other) {
+// Allocators are exchanged only when they propagate on swap; otherwise
+// they must compare equal, as for the standard containers.
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::swap(vector &other) {
   if (this != &other) {
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
     value_type *temp_data = data_;
     size_type temp_size = size_;
     size_type temp_capacity = capacity_;
@@ -265,39 +607,146 @@ inline void vector<T>::swap(vector &other) {
   }
 }
 
-template <typename T>
+// The element is built from args before the tail is shifted, so args may
+// refer to elements of this vector.
+template <typename T, typename Allocator, typename Growth>
+template <typename... Args>
+inline typename vector<T, Allocator, Growth>::iterator
+vector<T, Allocator, Growth>::emplace(const_iterator pos, Args &&...args) {
+  size_type index = pos - data_;
+  if (size_ == capacity_) {
+    realloc_insert(index, std::forward<Args>(args)...);
+  } else if (index == size_) {
+    construct_at(data_ + size_, std::forward<Args>(args)...);
+    ++size_;
+  } else {
+    value_type item(std::forward<Args>(args)...);
+    open_gap(index, 1);
+    construct_at(data_ + index, s21::move(item));
+    ++size_;
+  }
+  return begin() + index;
+}
+
+template <typename T, typename Allocator, typename Growth>
+template <typename... Args>
+inline typename vector<T, Allocator, Growth>::reference
+vector<T, Allocator, Growth>::emplace_back(Args &&...args) {
+  if (size_ == capacity_) {
+    realloc_insert(size_, std::forward<Args>(args)...);
+  } else {
+    construct_at(data_ + size_, std::forward<Args>(args)...);
+    ++size_;
+  }
+  return data_[size_ - 1];
+}
+
+template <typename T, typename Allocator, typename Growth>
 template <typename... Args>
-inline typename vector<T>::iterator vector<T>::insert_many(const_iterator pos,
-                                                           Args &&...args) {
+inline typename vector<T, Allocator, Growth>::iterator
+vector<T, Allocator, Growth>::insert_many(const_iterator pos, Args &&...args) {
   size_type index = pos - begin();
   size_type num_new_elements = sizeof...(args);
-
+  auto build = [&](T *dest) {
+    construct_each(alloc_, dest, std::forward<Args>(args)...);
+  };
   if (size_ + num_new_elements > capacity_) {
-    reserve(capacity_ + (index > capacity_ ? (index - capacity_) : 0) +
-            num_new_elements);
+    realloc_build(index, num_new_elements, build);
+  } else {
+    build_and_rotate(data_, size_, index, num_new_elements, build);
   }
+  return begin() + index;
+}
 
-  for (size_type i = size_; i > index; --i) {
-    data_[i + num_new_elements - 1] = s21::move(data_[i - 1]);
+template <typename T, typename Allocator, typename Growth>
+template <typename... Args>
+inline void vector<T, Allocator, Growth>::insert_many_back(Args &&...args) {
+  insert_many(end(), std::forward<Args>(args)...);
+}
+
+template <typename T, typename Allocator, typename Growth>
+inline T *vector<T, Allocator, Growth>::allocate(size_type n) {
+  if (n == 0) return nullptr;
+  return alloc_traits::allocate(alloc_, n);
+}
+
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::deallocate(T *ptr,
+                                                     size_type n) noexcept {
+  if (ptr != nullptr) alloc_traits::deallocate(alloc_, ptr, n);
+}
+
+// Destroys the elements and hands the block back to the allocator; the
+// caller resets the pointers.
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::release() noexcept {
+  destroy_range(data_, data_ + size_);
+  deallocate(data_, capacity_);
+}
+
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::reallocate(size_type new_capacity) {
+  T *new_data = allocate(new_capacity);
+  try {
+    relocate_range(data_, data_ + size_, new_data);
+  } catch (...) {
+    deallocate(new_data, new_capacity);
+    throw;
   }
+  deallocate(data_, capacity_);
+  data_ = new_data;
+  capacity_ = new_capacity;
+}
 
-  size_type offset = 0;
-  ((data_[index + offset++] = std::forward<Args>(args)), ...);
+// Shifts [index, size_) right by count inside the current capacity and
+// leaves [index, index + count) as raw memory for the caller to construct.
+template <typename T, typename Allocator, typename Growth>
+inline void vector<T, Allocator, Growth>::open_gap(size_type index,
+                                                   size_type count) {
+  open_gap_range(data_ + index, data_ + size_, count);
+}
 
-  size_ += num_new_elements;
-  return begin() + index;
+// New elements are built through the allocator so it can pass itself on
+// to allocator-aware element types.
+template <typename T, typename Allocator, typename Growth>
+template <typename... Args>
+inline void vector<T, Allocator, Growth>::construct_at(T *ptr,
+                                                       Args &&...args) {
+  alloc_traits::construct(alloc_, ptr, std::forward<Args>(args)...);
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Growth>
 template <typename... Args>
-inline void vector<T>::insert_many_back(Args &&...args) {
-  size_type num_new_elements = sizeof...(args);
+inline void vector<T, Allocator, Growth>::realloc_insert(size_type index,
+                                                         Args &&...args) {
+  realloc_build(index, 1, [&](T *dest) {
+    construct_at(dest, std::forward<Args>(args)...);
+  });
+}
 
-  if (size_ + num_new_elements > capacity_) {
-    reserve(size_ + num_new_elements);
+// Slow path of every insert: the capacity grows by the growth policy and
+// build(dest) constructs the count new elements in the new block before
+// the old one is released, so they may be built from this vector's own
+// elements.
+template <typename T, typename Allocator, typename Growth>
+template <typename Build>
+inline void vector<T, Allocator, Growth>::realloc_build(size_type index,
+                                                        size_type count,
+                                                        Build &&build) {
+  size_type new_capacity = Growth::next_capacity(capacity_, size_ + count);
+  T *new_data = allocate(new_capacity);
+  try {
+    build(new_data + index);
+  } catch (...) {
+    deallocate(new_data, new_capacity);
+    throw;
   }
-
-  ((data_[size_++] = std::forward<Args>(args)), ...);
+  relocate_range(data_, data_ + index, new_data);
+  relocate_range(data_ + index, data_ + size_, new_data + index + count);
+  deallocate(data_, capacity_);
+  data_ = new_data;
+  capacity_ = new_capacity;
+  size_ += count;
 }
 
 }  // namespace s21
@@ -9,13 +9,24 @@ constexpr T &&move(T &obj) noexcept {
 
 }  // namespace s21
 
+#include "containers/BTree/s21_btree.h"
+#include "containers/BTreeMap/s21_btree_map.h"
+#include "containers/BTreeSet/s21_btree_set.h"
+#include "containers/HashTable/s21_hash_table.h"
 #include "containers/Map/s21_map.h"
 #include "containers/Multiset/s21_multiset.h"
 #include "containers/Set/s21_set.h"
 #include "containers/Tree/s21_tree.h"
+#include "containers/UnorderedMap/s21_unordered_map.h"
+#include "containers/UnorderedSet/s21_unordered_set.h"
 #include "containers/s21_array.h"
+#include "containers/s21_flat_map.h"
+#include "containers/s21_flat_set.h"
+#include "containers/s21_inplace_vector.h"
 #include "containers/s21_list.h"
+#include "containers/s21_pmr.h"
 #include "containers/s21_queue.h"
+#include "containers/s21_small_vector.h"
 #include "containers/s21_stack.h"
 #include "containers/s21_vector.h"
 
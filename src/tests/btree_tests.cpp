@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "map_api_tests.h"
+#include "throwing_value.h"
+#include "tracking_allocator.h"
+
+// __________BTREE_SET__________ //
+
+TEST(BTreeSetTest, InsertFindErase) {
+  s21::btree_set<int> my_set = {5, 1, 3};
+  EXPECT_EQ(my_set.size(), 3u);
+  EXPECT_FALSE(my_set.insert(3).second);
+  EXPECT_TRUE(my_set.insert(4).second);
+  EXPECT_TRUE(my_set.contains(4));
+  EXPECT_EQ(*my_set.find(5), 5);
+  EXPECT_EQ(my_set.find(2), my_set.end());
+  my_set.erase(my_set.find(1));
+  EXPECT_EQ(my_set.erase(3), 1u);
+  EXPECT_EQ(my_set.erase(3), 0u);
+  std::vector<int> keys(my_set.begin(), my_set.end());
+  EXPECT_EQ(keys, (std::vector<int>{4, 5}));
+}
+
+// Случайные вставки и удаления с проверкой по std::set; ключей достаточно
+// для нескольких уровней, так что проверяются деления, заимствования у
+// соседей и слияния узлов
+TEST(BTreeSetTest, MatchesStdSetUnderRandomOps) {
+  s21::btree_set<int> my_set;
+  std::set<int> std_set;
+  std::mt19937 rng(42);
+  for (int round = 0; round < 100000; ++round) {
+    int key = static_cast<int>(rng() % 20000);
+    if (rng() % 3) {
+      EXPECT_EQ(my_set.insert(key).second, std_set.insert(key).second);
+    } else {
+      EXPECT_EQ(my_set.erase(key), std_set.erase(key));
+    }
+  }
+  ASSERT_EQ(my_set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(my_set.begin(), my_set.end(), std_set.begin()));
+  EXPECT_GT(my_set.height(), 2u);
+  // Обход в обратную сторону от end()
+  auto it = my_set.end();
+  for (auto rit = std_set.rbegin(); rit != std_set.rend(); ++rit) {
+    EXPECT_EQ(*--it, *rit);
+  }
+  EXPECT_EQ(it, my_set.begin());
+  for (int key : std_set) my_set.erase(key);
+  EXPECT_TRUE(my_set.empty());
+  EXPECT_EQ(my_set.begin(), my_set.end());
+  EXPECT_EQ(my_set.height(), 0u);
+}
+
+TEST(BTreeSetTest, BoundsAndTransparentLookup) {
+  s21::btree_set<std::string, std::less<>> names;
+  for (int i = 0; i < 1000; i += 2) {
+    names.insert(std::to_string(100000 + i));
+  }
+  EXPECT_TRUE(names.contains(std::string_view("100500")));
+  EXPECT_FALSE(names.contains(std::string_view("100501")));
+  EXPECT_EQ(*names.lower_bound("100501"), "100502");
+  EXPECT_EQ(*names.upper_bound("100502"), "100504");
+  EXPECT_EQ(names.lower_bound("200000"), names.end());
+  EXPECT_EQ(names.count("100000"), 1u);
+}
+
+TEST(BTreeSetTest, CopyMoveSwapMerge) {
+  s21::btree_set<int> first;
+  for (int i = 0; i < 5000; ++i) first.insert(i * 2);
+  s21::btree_set<int> copy(first);
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), first.begin()));
+  s21::btree_set<int> moved(std::move(copy));
+  EXPECT_EQ(moved.size(), 5000u);
+  EXPECT_TRUE(copy.empty());
+
+  s21::btree_set<int> odd = {1, 3, 4};
+  odd.swap(moved);
+  EXPECT_EQ(odd.size(), 5000u);
+  EXPECT_EQ(moved.size(), 3u);
+  first.merge(moved);
+  EXPECT_EQ(first.size(), 5002u);
+  EXPECT_TRUE(moved.empty());
+
+  auto results = first.insert_many(7, 8, 9);
+  EXPECT_EQ(*results[0].first, 7);
+  EXPECT_TRUE(results[0].second);
+  EXPECT_FALSE(results[1].second);
+  EXPECT_EQ(*results[2].first, 9);
+}
+
+TEST(BTreeSetTest, PmrAliasDrawsFromResource) {
+  s21::pmr::arena_resource arena;
+  s21::pmr::btree_set<int> my_set(&arena);
+  for (int i = 0; i < 1000; ++i) my_set.insert(i);
+  EXPECT_TRUE(my_set.contains(999));
+  EXPECT_GT(arena.bytes_used(), 0u);
+}
+
+// __________BTREE_MAP__________ //
+
+struct btree_map_family {
+  template <typename K, typename T,
+            typename A = std::allocator<std::pair<const K, T>>>
+  using map = s21::btree_map<K, T, std::less<K>, A>;
+  template <typename K, typename T>
+  using pmr_map = s21::pmr::btree_map<K, T>;
+};
+INSTANTIATE_TYPED_TEST_SUITE_P(BTree, MapApiTest, btree_map_family);
+
+TEST(BTreeMapTest, BoundsAndEnd) {
+  s21::btree_map<int, std::string> my_map = {{1, "one"}, {2, "two"}, {3, ""}};
+  EXPECT_THROW(*my_map.end(), std::out_of_range);
+  const auto& view = my_map;
+  EXPECT_EQ(view.lower_bound(5), view.end());
+  EXPECT_EQ((*view.upper_bound(2)).first, 3);
+  EXPECT_EQ(view.lower_bound(2)->second, "two");
+}
+
+// Узел занимает несколько кеш-линий целиком и выделяется одним вызовом
+// аллокатора
+TEST(BTreeMapTest, NodesComeFromAllocator) {
+  allocation_stats stats;
+  {
+    using alloc = tracking_allocator<std::pair<const int, int>>;
+    s21::btree_map<int, int, std::less<int>, alloc> my_map{alloc(&stats)};
+    for (int i = 0; i < 10000; ++i) my_map.insert(i, i);
+    EXPECT_LT(stats.allocations, 10000u / 16);
+  }
+  EXPECT_EQ(stats.live(), 0u);
+}
+
+// Исключение при построении значения в пустом дереве не оставляет
+// пустой корневой лист
+TEST(BTreeMapTest, ThrowingValueLeavesEmptyMap) {
+  s21::btree_map<int, throwing_value> my_map;
+  EXPECT_THROW(my_map.try_emplace(1, -1), std::runtime_error);
+  EXPECT_EQ(my_map.size(), 0u);
+  EXPECT_EQ(my_map.begin(), my_map.end());
+  EXPECT_TRUE(my_map.try_emplace(1, 5).second);
+  EXPECT_EQ(my_map.at(1).value(), 5);
+  EXPECT_EQ(++my_map.begin(), my_map.end());
+}
+
+// Вставки сдвигают элементы листа, так что итераторы ищутся заново
+TEST(BTreeMapTest, InsertManyReturnsLiveIterators) {
+  s21::btree_map<int, int> my_map;
+  for (int i = 0; i < 200; ++i) my_map.insert(i * 10, i);
+  auto results = my_map.insert_many(std::make_pair(5, 1), std::make_pair(6, 2),
+                                    std::make_pair(10, 3));
+  EXPECT_EQ(results[0].first->first, 5);
+  EXPECT_EQ(results[1].first->second, 2);
+  EXPECT_FALSE(results[2].second);
+  EXPECT_EQ(results[2].first->second, 1);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "map_api_tests.h"
+#include "throwing_value.h"
+#include "tracking_allocator.h"
+
+// __________FLAT_SET__________ //
+
+TEST(FlatSetTest, InsertFindErase) {
+  s21::flat_set<int> my_set = {5, 1, 3, 1};
+  EXPECT_EQ(my_set.size(), 3u);
+  EXPECT_FALSE(my_set.insert(3).second);
+  EXPECT_TRUE(my_set.insert(4).second);
+  EXPECT_TRUE(my_set.contains(4));
+  EXPECT_EQ(*my_set.find(5), 5);
+  EXPECT_EQ(my_set.find(2), my_set.end());
+  EXPECT_EQ(*my_set.lower_bound(2), 3);
+  EXPECT_EQ(*my_set.upper_bound(4), 5);
+  my_set.erase(my_set.find(1));
+  EXPECT_EQ(my_set.erase(3), 1u);
+  EXPECT_EQ(my_set.erase(3), 0u);
+  std::vector<int> keys(my_set.begin(), my_set.end());
+  EXPECT_EQ(keys, (std::vector<int>{4, 5}));
+}
+
+// Bulk inserts into a non-empty set: the new keys are sorted, merged and
+// deduplicated against the old ones.
+TEST(FlatSetTest, BulkInsertMatchesStdSet) {
+  s21::flat_set<int> my_set;
+  std::set<int> std_set;
+  std::mt19937 rng(3);
+  for (int round = 0; round < 20; ++round) {
+    std::vector<int> batch(1000);
+    for (int &key : batch) key = static_cast<int>(rng() % 5000);
+    my_set.insert(batch.begin(), batch.end());
+    std_set.insert(batch.begin(), batch.end());
+  }
+  ASSERT_EQ(my_set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(my_set.begin(), my_set.end(), std_set.begin()));
+}
+
+TEST(FlatSetTest, FromSortedAndTransparentLookup) {
+  std::vector<std::string> sorted = {"apple", "kiwi", "pear"};
+  auto fruits =
+      s21::flat_set<std::string, std::less<>>::from_sorted(sorted.begin(),
+                                                           sorted.end(), true);
+  EXPECT_TRUE(fruits.contains(std::string_view("kiwi")));
+  EXPECT_FALSE(fruits.contains(std::string_view("plum")));
+  EXPECT_EQ(*fruits.lower_bound("b"), "kiwi");
+  std::vector<std::string> unsorted = {"pear", "apple"};
+  EXPECT_THROW((s21::flat_set<std::string, std::less<>>::from_sorted(
+                   unsorted.begin(), unsorted.end(), true)),
+               std::invalid_argument);
+}
+
+TEST(FlatSetTest, SwapMergeInsertMany) {
+  s21::flat_set<int> first = {1, 3, 5};
+  s21::flat_set<int> second = {2, 3, 4};
+  first.merge(second);
+  EXPECT_EQ(first, (s21::flat_set<int>{1, 2, 3, 4, 5}));
+  EXPECT_TRUE(second.empty());
+  second.swap(first);
+  EXPECT_EQ(second.size(), 5u);
+  EXPECT_TRUE(first.empty());
+
+  auto results = second.insert_many(0, 3, 9);
+  EXPECT_EQ(*results[0].first, 0);
+  EXPECT_TRUE(results[0].second);
+  EXPECT_FALSE(results[1].second);
+  EXPECT_EQ(*results[1].first, 3);
+  EXPECT_EQ(*results[2].first, 9);
+}
+
+// __________FLAT_MAP__________ //
+
+struct flat_map_family {
+  template <typename K, typename T,
+            typename A = std::allocator<std::pair<const K, T>>>
+  using map = s21::flat_map<K, T, std::less<K>, A>;
+  template <typename K, typename T>
+  using pmr_map = s21::pmr::flat_map<K, T>;
+};
+INSTANTIATE_TYPED_TEST_SUITE_P(Flat, MapApiTest, flat_map_family);
+
+// Keys and values sit in two sorted arrays that stay in step.
+TEST(FlatMapTest, KeysAndValuesArrays) {
+  s21::flat_map<int, std::string> my_map = {{2, "two"}, {1, "one"}};
+  my_map[4] = "four";
+  my_map.emplace(3, "three");
+  EXPECT_EQ(my_map.keys()[3], 4);
+  EXPECT_EQ(my_map.values()[3], "four");
+  EXPECT_EQ(my_map.values()[2], "three");
+
+  const auto &view = my_map;
+  EXPECT_EQ(view.lower_bound(5), view.end());
+  EXPECT_EQ((*view.upper_bound(2)).first, 3);
+  EXPECT_EQ(view.end() - view.begin(), 4);
+}
+
+// Existing keys keep their values; among new duplicates the first wins.
+TEST(FlatMapTest, BulkInsertKeepsFirstValue) {
+  s21::flat_map<int, int> my_map = {{5, 50}, {1, 10}};
+  std::vector<std::pair<int, int>> batch = {
+      {3, 30}, {5, 0}, {2, 20}, {3, 0}, {0, 1}};
+  my_map.insert(batch.begin(), batch.end());
+  std::vector<int> keys(my_map.keys().begin(), my_map.keys().end());
+  std::vector<int> values(my_map.values().begin(), my_map.values().end());
+  EXPECT_EQ(keys, (std::vector<int>{0, 1, 2, 3, 5}));
+  EXPECT_EQ(values, (std::vector<int>{1, 10, 20, 30, 50}));
+}
+
+// Keys and values each take one allocation, whatever the number of
+// elements.
+TEST(FlatMapTest, TwoArraysFromAllocator) {
+  allocation_stats stats;
+  {
+    using alloc = tracking_allocator<std::pair<const int, int>>;
+    std::vector<std::pair<int, int>> items;
+    for (int i = 0; i < 10000; ++i) items.emplace_back(i, i);
+    auto my_map = s21::flat_map<int, int, std::less<int>, alloc>::from_sorted(
+        items.begin(), items.end(), false, alloc(&stats));
+    EXPECT_EQ(stats.allocations, 2u);
+    EXPECT_EQ(my_map.at(9999), 9999);
+  }
+  EXPECT_EQ(stats.live(), 0u);
+
+  s21::pmr::arena_resource arena;
+  s21::pmr::flat_set<int> pmr_set(&arena);
+  pmr_set.insert(1);
+  EXPECT_TRUE(pmr_set.contains(1));
+  EXPECT_GT(arena.bytes_used(), 0u);
+}
+
+// Comparator that throws once its shared budget of calls runs out (a
+// negative budget never does).
+struct budget_less {
+  static int &calls_left() {
+    static int left = -1;
+    return left;
+  }
+  bool operator()(int a, int b) const {
+    if (calls_left() == 0) throw std::runtime_error("budget_less");
+    if (calls_left() > 0) --calls_left();
+    return a < b;
+  }
+};
+
+// A throwing value copy or comparison leaves both maps as they were.
+TEST(FlatMapTest, ThrowingMergeKeepsBothMaps) {
+  s21::flat_map<int, throwing_value> target;
+  s21::flat_map<int, throwing_value> source;
+  for (int i = 0; i < 6; ++i) {
+    target.try_emplace(2 * i, i);
+    source.try_emplace(3 * i, 10 + i);
+  }
+  throwing_value::copies_left() = 1;
+  EXPECT_THROW(target.merge(source), std::runtime_error);
+  throwing_value::copies_left() = -1;
+  ASSERT_EQ(target.size(), 6u);
+  ASSERT_EQ(source.size(), 6u);
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(target.at(2 * i).value(), i);
+    EXPECT_EQ(source.at(3 * i).value(), 10 + i);
+  }
+  target.merge(source);
+  EXPECT_EQ(target.size(), 10u);
+  EXPECT_EQ(target.at(6).value(), 12);
+  EXPECT_EQ(target.at(9).value(), 13);
+  EXPECT_EQ(source.size(), 2u);
+  EXPECT_EQ(source.at(0).value(), 10);
+
+  s21::flat_map<int, int, budget_less> left = {{1, 1}, {3, 3}, {5, 5}};
+  s21::flat_map<int, int, budget_less> right = {{2, 2}, {3, 30}, {4, 4}};
+  std::vector<std::pair<int, int>> batch = {{9, 9}, {0, 0}, {4, 4}};
+  for (int budget : {0, 2, 4}) {
+    budget_less::calls_left() = budget;
+    EXPECT_THROW(left.merge(right), std::runtime_error);
+    budget_less::calls_left() = budget;
+    EXPECT_THROW(left.insert(batch.begin(), batch.end()),
+                 std::runtime_error);
+    budget_less::calls_left() = -1;
+    EXPECT_EQ(std::vector<int>(left.keys().begin(), left.keys().end()),
+              (std::vector<int>{1, 3, 5}));
+    EXPECT_EQ(std::vector<int>(right.keys().begin(), right.keys().end()),
+              (std::vector<int>{2, 3, 4}));
+    EXPECT_EQ(left.at(3), 3);
+  }
+  left.merge(right);
+  EXPECT_EQ(left.at(3), 30);
+  EXPECT_EQ(right.size(), 1u);
+}
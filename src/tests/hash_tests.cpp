@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "map_api_tests.h"
+#include "tracking_allocator.h"
+
+// Прозрачный хеш: поиск по std::string_view без построения std::string
+struct string_hash {
+  using is_transparent = void;
+  size_t operator()(std::string_view text) const {
+    return std::hash<std::string_view>()(text);
+  }
+};
+
+// Плохой хеш: все ключи попадают в одну группу, и поиск идет по длинной
+// цепочке групп
+struct constant_hash {
+  size_t operator()(int) const { return 42; }
+};
+
+// __________UNORDERED_SET__________ //
+
+TEST(UnorderedSetTest, InsertFindErase) {
+  s21::unordered_set<int> my_set = {5, 1, 3};
+  EXPECT_EQ(my_set.size(), 3u);
+  EXPECT_FALSE(my_set.insert(3).second);
+  EXPECT_TRUE(my_set.insert(4).second);
+  EXPECT_TRUE(my_set.contains(4));
+  EXPECT_EQ(*my_set.find(5), 5);
+  EXPECT_EQ(my_set.find(2), my_set.end());
+  my_set.erase(my_set.find(1));
+  EXPECT_EQ(my_set.erase(3), 1u);
+  EXPECT_EQ(my_set.erase(3), 0u);
+  std::vector<int> keys(my_set.begin(), my_set.end());
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(keys, (std::vector<int>{4, 5}));
+  s21::unordered_set<int> empty;
+  EXPECT_EQ(empty.begin(), empty.end());
+  EXPECT_FALSE(empty.contains(0));
+  EXPECT_EQ(empty.bucket_count(), 0u);
+}
+
+// Много удалений вперемешку со вставками: удаленные ячейки должны и
+// переиспользоваться, и не обрывать поиск
+TEST(UnorderedSetTest, MatchesStdSetUnderRandomOps) {
+  s21::unordered_set<int> my_set;
+  std::unordered_set<int> std_set;
+  std::mt19937 rng(42);
+  for (int round = 0; round < 200000; ++round) {
+    int key = static_cast<int>(rng() % 20000);
+    if (rng() % 2) {
+      EXPECT_EQ(my_set.insert(key).second, std_set.insert(key).second);
+    } else {
+      EXPECT_EQ(my_set.erase(key), std_set.erase(key));
+    }
+  }
+  ASSERT_EQ(my_set.size(), std_set.size());
+  size_t visited = 0;
+  for (int key : my_set) {
+    EXPECT_EQ(std_set.count(key), 1u);
+    ++visited;
+  }
+  EXPECT_EQ(visited, std_set.size());
+  EXPECT_LE(my_set.load_factor(), my_set.max_load_factor());
+}
+
+TEST(UnorderedSetTest, SurvivesConstantHash) {
+  s21::unordered_set<int, constant_hash> my_set;
+  for (int i = 0; i < 500; ++i) my_set.insert(i);
+  for (int i = 0; i < 500; i += 2) my_set.erase(i);
+  EXPECT_EQ(my_set.size(), 250u);
+  for (int i = 0; i < 500; ++i) {
+    EXPECT_EQ(my_set.contains(i), i % 2 == 1);
+  }
+}
+
+TEST(UnorderedSetTest, TransparentLookupAndMerge) {
+  s21::unordered_set<std::string, string_hash, std::equal_to<>> names = {
+      "alpha", "beta"};
+  EXPECT_TRUE(names.contains(std::string_view("beta")));
+  EXPECT_FALSE(names.contains(std::string_view("gamma")));
+  s21::unordered_set<std::string, string_hash, std::equal_to<>> more = {
+      "beta", "gamma"};
+  names.merge(more);
+  EXPECT_EQ(names.size(), 3u);
+  EXPECT_TRUE(more.empty());
+
+  auto results = names.insert_many("delta", "alpha");
+  EXPECT_TRUE(results[0].second);
+  EXPECT_EQ(*results[0].first, "delta");
+  EXPECT_FALSE(results[1].second);
+  EXPECT_EQ(*results[1].first, "alpha");
+}
+
+// __________UNORDERED_MAP__________ //
+
+struct unordered_map_family {
+  template <typename K, typename T,
+            typename A = std::allocator<std::pair<const K, T>>>
+  using map = s21::unordered_map<K, T, std::hash<K>, std::equal_to<K>, A>;
+  template <typename K, typename T>
+  using pmr_map = s21::pmr::unordered_map<K, T>;
+};
+INSTANTIATE_TYPED_TEST_SUITE_P(Hash, MapApiTest, unordered_map_family);
+
+// Итератор отдает пару ссылок, а не ссылку на пару в ячейке
+TEST(UnorderedMapTest, IteratorYieldsReferencePair) {
+  s21::unordered_map<int, std::string> my_map = {{1, "one"}};
+  EXPECT_THROW(*my_map.end(), std::out_of_range);
+  auto it = my_map.find(1);
+  (*it).second = "uno";
+  EXPECT_EQ(it->second, "uno");
+  EXPECT_EQ(my_map.at(1), "uno");
+}
+
+// Таблица растет при заданной доле заполнения, а reserve заранее готовит
+// место, так что последующие вставки не перестраивают таблицу
+TEST(UnorderedMapTest, LoadFactorAndReserve) {
+  s21::unordered_map<int, int> my_map;
+  my_map.max_load_factor(0.5f);
+  EXPECT_FLOAT_EQ(my_map.max_load_factor(), 0.5f);
+  for (int i = 0; i < 1000; ++i) my_map[i] = i;
+  EXPECT_LE(my_map.load_factor(), 0.5f);
+  my_map.max_load_factor(2.0f);
+  EXPECT_FLOAT_EQ(my_map.max_load_factor(), 0.9375f);
+
+  s21::unordered_map<int, int> sized(100);
+  EXPECT_GE(sized.bucket_count(), 100u);
+}
+
+// Ячейки и управляющие байты - два массива на всю таблицу, так что после
+// reserve вставки не обращаются к аллокатору
+TEST(UnorderedMapTest, ReservedTableDoesNotAllocate) {
+  allocation_stats stats;
+  {
+    using alloc = tracking_allocator<std::pair<const int, std::string>>;
+    s21::unordered_map<int, std::string, std::hash<int>, std::equal_to<int>,
+                       alloc>
+        my_map{alloc(&stats)};
+    my_map.reserve(10000);
+    size_t allocations = stats.allocations;
+    size_t buckets = my_map.bucket_count();
+    for (int i = 0; i < 10000; ++i) my_map[i] = std::to_string(i);
+    EXPECT_EQ(stats.allocations, allocations);
+    EXPECT_EQ(my_map.bucket_count(), buckets);
+  }
+  EXPECT_EQ(stats.live(), 0u);
+
+  s21::pmr::arena_resource arena;
+  s21::pmr::unordered_set<int> pmr_set(&arena);
+  pmr_set.insert(1);
+  EXPECT_TRUE(pmr_set.contains(1));
+  EXPECT_GT(arena.bytes_used(), 0u);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "../s21_containers.h"
+
+namespace {
+
+constexpr int constexpr_sum() {
+  s21::inplace_vector<int, 4> vec;
+  vec.push_back(1);
+  vec.emplace_back(2);
+  vec.try_push_back(3);
+  vec.insert_many_back(4);
+  bool rejected = vec.try_push_back(5) == nullptr;
+  vec.pop_back();
+  int sum = 0;
+  for (int value : vec) {
+    sum += value;
+  }
+  return rejected ? sum : -1;
+}
+
+static_assert(constexpr_sum() == 6, "inplace_vector must work in constexpr");
+static_assert(s21::inplace_vector<int, 16>::capacity() == 16, "capacity");
+
+struct Counted {
+  static int alive;
+  int value;
+  explicit Counted(int v) : value(v) { ++alive; }
+  Counted(const Counted &other) : value(other.value) { ++alive; }
+  Counted &operator=(const Counted &) = default;
+  ~Counted() { --alive; }
+};
+
+int Counted::alive = 0;
+
+}  // namespace
+
+TEST(inplace_vector_constructor, case1) {
+  s21::inplace_vector<int, 4> s21_vec_int;
+  s21::inplace_vector<std::string, 4> s21_vec_string(3);
+
+  EXPECT_TRUE(s21_vec_int.empty());
+  EXPECT_EQ(s21_vec_int.capacity(), 4U);
+  EXPECT_EQ(s21_vec_string.size(), 3U);
+  EXPECT_EQ(s21_vec_string[2], "");
+  EXPECT_THROW((s21::inplace_vector<int, 2>(3)), std::length_error);
+}
+
+TEST(inplace_vector_constructor, case2) {
+  s21::inplace_vector<std::string, 4> s21_vec_ref{"Hello", ",", "world"};
+  s21::inplace_vector<std::string, 4> s21_vec_copy(s21_vec_ref);
+  s21::inplace_vector<std::string, 4> s21_vec_moved(std::move(s21_vec_ref));
+
+  EXPECT_EQ(s21_vec_copy.size(), 3U);
+  EXPECT_EQ(s21_vec_copy.back(), "world");
+  EXPECT_EQ(s21_vec_moved.front(), "Hello");
+  EXPECT_TRUE(s21_vec_ref.empty());
+}
+
+TEST(inplace_vector_push_back, full) {
+  s21::inplace_vector<std::string, 2> s21_vec;
+  s21_vec.push_back("a");
+  std::string b = "b";
+  s21_vec.push_back(std::move(b));
+
+  EXPECT_TRUE(s21_vec.full());
+  EXPECT_THROW(s21_vec.push_back("c"), std::length_error);
+  EXPECT_THROW(s21_vec.emplace_back(1, 'c'), std::length_error);
+  EXPECT_EQ(s21_vec.try_push_back("c"), nullptr);
+  EXPECT_EQ(s21_vec.try_emplace_back(1, 'c'), nullptr);
+  EXPECT_EQ(s21_vec.size(), 2U);
+
+  s21_vec.pop_back();
+  std::string *slot = s21_vec.try_emplace_back(3, 'z');
+  ASSERT_NE(slot, nullptr);
+  EXPECT_EQ(*slot, "zzz");
+  EXPECT_EQ(slot, &s21_vec[1]);
+}
+
+TEST(inplace_vector_modifiers, erase_swap) {
+  s21::inplace_vector<int, 8> s21_vec{1, 2, 3, 4};
+  s21::inplace_vector<int, 8> s21_other{9};
+
+  auto it = s21_vec.erase(s21_vec.begin() + 1);
+  EXPECT_EQ(*it, 3);
+  EXPECT_EQ(s21_vec.size(), 3U);
+  EXPECT_THROW(s21_vec.erase(s21_vec.end()), std::out_of_range);
+
+  s21_vec.swap(s21_other);
+  EXPECT_EQ(s21_vec.size(), 1U);
+  EXPECT_EQ(s21_other.at(2), 4);
+  EXPECT_THROW(s21_other.at(3), std::out_of_range);
+
+  s21_vec.clear();
+  EXPECT_THROW(s21_vec.pop_back(), std::out_of_range);
+  EXPECT_THROW(s21_vec.front(), std::logic_error);
+}
+
+TEST(inplace_vector_storage, no_spare_construction) {
+  Counted::alive = 0;
+  {
+    s21::inplace_vector<Counted, 16> s21_vec;
+    EXPECT_EQ(Counted::alive, 0);
+    s21_vec.emplace_back(1);
+    s21_vec.emplace_back(2);
+    s21_vec.emplace_back(3);
+    EXPECT_EQ(Counted::alive, 3);
+    s21_vec.erase(s21_vec.begin());
+    EXPECT_EQ(Counted::alive, 2);
+    EXPECT_EQ(s21_vec[0].value, 2);
+    s21::inplace_vector<Counted, 16> s21_copy(s21_vec);
+    EXPECT_EQ(Counted::alive, 4);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(inplace_vector_storage, in_object) {
+  s21::inplace_vector<std::unique_ptr<int>, 4> s21_vec;
+  s21_vec.push_back(std::make_unique<int>(7));
+  auto *begin = reinterpret_cast<const char *>(&s21_vec);
+  auto *data = reinterpret_cast<const char *>(s21_vec.data());
+
+  EXPECT_GE(data, begin);
+  EXPECT_LT(data, begin + sizeof(s21_vec));
+  EXPECT_EQ(*s21_vec[0], 7);
+}
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <list>
 
 #include "../s21_containers.h"
+#include "tracking_allocator.h"
 
 TEST(List, Constructor_Default) {
   s21::List<int> our_list;
@@ -356,3 +358,62 @@ TEST(List, Insert_Many_Front) {
   ++our_it;
   EXPECT_EQ(*our_it, 2);
 }
+
+TEST(List, Emplace) {
+  s21::List<std::unique_ptr<int>> our_list;
+  our_list.push_back(std::make_unique<int>(2));
+  our_list.emplace_back(new int(4));
+  our_list.emplace_front(new int(1));
+  auto our_it = our_list.begin();
+  ++our_it;
+  ++our_it;
+  our_list.emplace(our_it, new int(3));
+  our_list.push_front(std::make_unique<int>(0));
+
+  EXPECT_EQ(our_list.size(), 5U);
+  int expected = 0;
+  for (auto it = our_list.begin(); it != our_list.end(); ++it) {
+    EXPECT_EQ(**it, expected++);
+  }
+}
+
+TEST(List, Emplace_Return) {
+  s21::List<std::pair<int, std::string>> our_list;
+  auto &back = our_list.emplace_back(2, "two");
+  auto &front = our_list.emplace_front(1, "one");
+  EXPECT_EQ(back.second, "two");
+  EXPECT_EQ(front.first, 1);
+  auto it = our_list.emplace(our_list.end(), 3, "three");
+  EXPECT_EQ((*it).second, "three");
+  EXPECT_EQ(our_list.back().first, 3);
+}
+
+TEST(ListAllocator, Propagation) {
+  allocation_stats left_stats;
+  allocation_stats right_stats;
+  using alloc = tracking_allocator<std::string, false>;
+  {
+    s21::List<std::string, alloc> left({"a", "b"}, alloc(&left_stats));
+    s21::List<std::string, alloc> right({"c", "d", "e"}, alloc(&right_stats));
+    EXPECT_EQ(left_stats.live(), 2U);
+    EXPECT_EQ(right_stats.live(), 3U);
+
+    left = std::move(right);
+    EXPECT_EQ(left.size(), 3U);
+    EXPECT_EQ(left.front(), "c");
+    EXPECT_EQ(left_stats.live(), 3U);
+    EXPECT_EQ(right_stats.live(), 0U);
+
+    s21::List<std::string, alloc> copy(left);
+    EXPECT_EQ(copy.get_allocator().stats(), &left_stats);
+    EXPECT_EQ(copy.back(), "e");
+  }
+  EXPECT_EQ(left_stats.live(), 0U);
+
+  using prop_alloc = tracking_allocator<int, true>;
+  s21::List<int, prop_alloc> first({1}, prop_alloc(&left_stats));
+  s21::List<int, prop_alloc> second({2, 3}, prop_alloc(&right_stats));
+  first.swap(second);
+  EXPECT_EQ(first.get_allocator().stats(), &right_stats);
+  EXPECT_EQ(first.size(), 2U);
+}
@@ -0,0 +1,157 @@
+#ifndef S21_TESTS_MAP_API_TESTS_H
+#define S21_TESTS_MAP_API_TESTS_H
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "../s21_containers.h"
+#include "tracking_allocator.h"
+
+// Checks shared by every map-like container. A test file instantiates the
+// suite with a family that names its container for any key, mapped type
+// and allocator, plus the matching s21::pmr alias:
+//
+//   struct btree_map_family {
+//     template <typename K, typename T,
+//               typename A = std::allocator<std::pair<const K, T>>>
+//     using map = s21::btree_map<K, T, std::less<K>, A>;
+//     template <typename K, typename T>
+//     using pmr_map = s21::pmr::btree_map<K, T>;
+//   };
+//   INSTANTIATE_TYPED_TEST_SUITE_P(BTree, MapApiTest, btree_map_family);
+//
+// Behaviour that only one container has stays in that container's file.
+template <typename Family>
+class MapApiTest : public testing::Test {};
+
+TYPED_TEST_SUITE_P(MapApiTest);
+
+TYPED_TEST_P(MapApiTest, AccessAndInsert) {
+  typename TypeParam::template map<int, std::string> my_map = {{2, "two"},
+                                                               {1, "one"}};
+  EXPECT_EQ(my_map.at(1), "one");
+  EXPECT_THROW(my_map.at(3), std::out_of_range);
+  my_map[3] = "three";
+  EXPECT_EQ(my_map.size(), 3u);
+  EXPECT_FALSE(my_map.insert(1, "uno").second);
+  EXPECT_EQ(my_map.at(1), "one");
+  EXPECT_FALSE(my_map.insert_or_assign(1, "uno").second);
+  EXPECT_EQ(my_map.at(1), "uno");
+  auto [it, inserted] = my_map.emplace(4, "four");
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(it->second, "four");
+  it->second = "FOUR";
+  EXPECT_EQ(my_map[4], "FOUR");
+  my_map.erase(my_map.find(4));
+  EXPECT_FALSE(my_map.contains(4));
+
+  const auto &view = my_map;
+  EXPECT_EQ(view.find(2)->second, "two");
+  EXPECT_EQ(view.find(7), view.end());
+  EXPECT_EQ(view.count(3), 1u);
+}
+
+TYPED_TEST_P(MapApiTest, MatchesStdMapUnderRandomOps) {
+  typename TypeParam::template map<long, long> my_map;
+  std::map<long, long> std_map;
+  std::mt19937 rng(7);
+  for (long round = 0; round < 20000; ++round) {
+    long key = static_cast<long>(rng() % 3000);
+    if (rng() % 4) {
+      my_map[key] = round;
+      std_map[key] = round;
+    } else {
+      EXPECT_EQ(my_map.erase(key), std_map.erase(key));
+    }
+  }
+  ASSERT_EQ(my_map.size(), std_map.size());
+  for (const auto &[key, value] : std_map) {
+    EXPECT_EQ(my_map.at(key), value);
+  }
+  size_t visited = 0;
+  for (auto it = my_map.begin(); it != my_map.end(); ++it) {
+    EXPECT_EQ(std_map.at(it->first), it->second);
+    ++visited;
+  }
+  EXPECT_EQ(visited, std_map.size());
+
+  auto copy = my_map;
+  while (!my_map.empty()) my_map.erase(my_map.begin());
+  EXPECT_EQ(my_map.begin(), my_map.end());
+  EXPECT_EQ(copy.size(), std_map.size());
+  EXPECT_EQ(copy.at(std_map.begin()->first), std_map.begin()->second);
+}
+
+// New keys move over; shared keys take the value from other and stay there.
+TYPED_TEST_P(MapApiTest, MergeKeepsMapSemantics) {
+  using int_map = typename TypeParam::template map<int, int>;
+  int_map target = {{1, 10}, {2, 20}};
+  int_map source = {{0, 0}, {2, 200}, {3, 300}};
+  target.merge(source);
+  EXPECT_EQ(target.size(), 4u);
+  EXPECT_EQ(target.at(0), 0);
+  EXPECT_EQ(target.at(2), 200);
+  EXPECT_EQ(target.at(3), 300);
+  EXPECT_EQ(source.size(), 1u);
+  EXPECT_EQ(source.at(2), 200);
+
+  auto results = target.insert_many(std::make_pair(5, 1), std::make_pair(6, 2),
+                                    std::make_pair(1, 3));
+  EXPECT_EQ(results[0].first->first, 5);
+  EXPECT_EQ(results[1].first->second, 2);
+  EXPECT_FALSE(results[2].second);
+  EXPECT_EQ(results[2].first->second, 10);
+}
+
+// The value is read from the container itself, while the insert grows or
+// reshuffles the storage it lives in.
+TYPED_TEST_P(MapApiTest, InsertCopiesOwnValue) {
+  typename TypeParam::template map<int, std::string> my_map;
+  my_map.insert(10000, std::string(40, 'v'));
+  for (int i = 0; i < 2000; ++i) {
+    EXPECT_TRUE(my_map.insert(i, my_map.at(10000)).second);
+  }
+  for (int i = 0; i < 2000; ++i) {
+    ASSERT_EQ(my_map.at(i), std::string(40, 'v'));
+  }
+  typename TypeParam::template map<std::string, std::string> names;
+  for (int i = 0; i < 500; ++i) names[std::to_string(i)] = std::to_string(-i);
+  names.insert(names.at("42"), "from value");
+  EXPECT_EQ(names.at("-42"), "from value");
+  EXPECT_EQ(names.at("42"), "-42");
+}
+
+TYPED_TEST_P(MapApiTest, ReturnsAllMemory) {
+  allocation_stats stats;
+  {
+    using alloc = tracking_allocator<std::pair<const int, std::string>>;
+    using tracked_map =
+        typename TypeParam::template map<int, std::string, alloc>;
+    tracked_map my_map{alloc(&stats)};
+    for (int i = 0; i < 1000; ++i) my_map[i] = std::to_string(i);
+    EXPECT_GT(stats.allocations, 0u);
+    tracked_map copy(my_map);
+    tracked_map moved(std::move(copy));
+    EXPECT_EQ(moved.at(999), "999");
+    EXPECT_EQ(moved.get_allocator().stats(), &stats);
+  }
+  EXPECT_EQ(stats.live(), 0u);
+
+  s21::pmr::arena_resource arena;
+  typename TypeParam::template pmr_map<int, int> pmr_map(&arena);
+  for (int i = 0; i < 100; ++i) pmr_map[i] = i * i;
+  EXPECT_EQ(pmr_map.at(30), 900);
+  EXPECT_GT(arena.bytes_used(), 0u);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(MapApiTest, AccessAndInsert,
+                            MatchesStdMapUnderRandomOps,
+                            MergeKeepsMapSemantics, InsertCopiesOwnValue,
+                            ReturnsAllMemory);
+
+#endif
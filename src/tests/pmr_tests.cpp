@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string>
+
+#include "../s21_containers.h"
+
+namespace {
+
+// Upstream resource that counts the blocks an arena asks it for.
+class counting_resource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+  size_t deallocations = 0;
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+  }
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
+TEST(pmr_aliases, use_arena) {
+  counting_resource upstream;
+  s21::pmr::arena_resource arena(256, &upstream);
+  {
+    s21::pmr::vector<int> vec(&arena);
+    s21::pmr::small_vector<int, 2> small(&arena);
+    s21::pmr::List<std::string> list(&arena);
+    s21::pmr::stack<int> stack(&arena);
+    s21::pmr::queue<int> queue(&arena);
+    s21::pmr::map<int, std::string> map(&arena);
+    s21::pmr::set<int> set(&arena);
+    s21::pmr::multiset<int> multiset(&arena);
+    for (int i = 0; i < 100; ++i) {
+      vec.push_back(i);
+      small.push_back(i);
+      list.push_back(std::to_string(i));
+      stack.push(i);
+      queue.push(i);
+      map.insert(i, std::to_string(i));
+      set.insert(i);
+      multiset.insert(i % 10);
+    }
+
+    EXPECT_EQ(vec.get_allocator().resource(), &arena);
+    EXPECT_EQ(map.get_allocator().resource(), &arena);
+    EXPECT_EQ(map.at(42), "42");
+    EXPECT_EQ(set.size(), 100U);
+    EXPECT_EQ(multiset.count(3), 10U);
+    EXPECT_EQ(list.back(), "99");
+    EXPECT_EQ(stack.top(), 99);
+    EXPECT_EQ(queue.front(), 0);
+    EXPECT_EQ(small[99], 99);
+  }
+  EXPECT_GT(arena.bytes_used(), 0U);
+  EXPECT_GT(upstream.allocations, 1U);
+  EXPECT_EQ(upstream.deallocations, 0U);
+}
+
+TEST(pmr_arena, reset_reuses_newest_block) {
+  counting_resource upstream;
+  s21::pmr::arena_resource arena(64, &upstream);
+  auto fill = [&arena] {
+    s21::pmr::map<int, int> map(&arena);
+    for (int i = 0; i < 1000; ++i) map.insert(i, i);
+    return map.size();
+  };
+
+  EXPECT_EQ(fill(), 1000U);
+  size_t blocks = upstream.allocations;
+  arena.reset();
+  EXPECT_EQ(arena.bytes_used(), 0U);
+  EXPECT_EQ(upstream.deallocations, blocks - 1);
+
+  // The largest block survives the reset; the next request needs at most
+  // one more block from upstream.
+  EXPECT_EQ(fill(), 1000U);
+  EXPECT_LE(upstream.allocations, blocks + 1);
+
+  arena.release();
+  EXPECT_EQ(upstream.allocations, upstream.deallocations);
+}
+
+TEST(pmr_arena, alignment) {
+  s21::pmr::arena_resource arena(16);
+  void *first = arena.allocate(1, 1);
+  void *second = arena.allocate(sizeof(double), alignof(double));
+  void *big = arena.allocate(1000, 64);
+
+  EXPECT_NE(first, second);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % alignof(double), 0U);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(big) % 64, 0U);
+  EXPECT_TRUE(arena.is_equal(arena));
+  EXPECT_FALSE(arena.is_equal(*std::pmr::new_delete_resource()));
+}
+
+TEST(pmr_aliases, move_between_resources) {
+  s21::pmr::arena_resource left_arena;
+  s21::pmr::arena_resource right_arena;
+  s21::pmr::List<int> left({1, 2, 3}, &left_arena);
+  s21::pmr::List<int> right(&right_arena);
+
+  right = std::move(left);
+  EXPECT_EQ(right.get_allocator().resource(), &right_arena);
+  EXPECT_EQ(right.size(), 3U);
+  EXPECT_EQ(right.front(), 1);
+  EXPECT_TRUE(left.empty());
+}
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <queue>
 
 #include "../s21_containers.h"
+#include "tracking_allocator.h"
 
 template <typename value_type>
 bool check_eq(s21::queue<value_type> m_queue,
@@ -170,3 +172,48 @@ TEST(Queue_test, insert_many_back) {
 
   EXPECT_TRUE(check_eq(lol_my, lol_orig));
 }
+
+TEST(Queue_test, emplace_and_move_push) {
+  s21::queue<std::unique_ptr<int>> our_queue;
+  our_queue.push(std::make_unique<int>(1));
+  our_queue.emplace(new int(2));
+  auto &ref = our_queue.emplace(new int(3));
+
+  EXPECT_EQ(*ref, 3);
+  EXPECT_EQ(our_queue.size(), 3U);
+  EXPECT_EQ(*our_queue.front(), 1);
+  EXPECT_EQ(*our_queue.back(), 3);
+
+  s21::queue<std::pair<int, std::string>> pair_queue;
+  pair_queue.emplace(1, "one");
+  pair_queue.insert_many_back(std::make_pair(2, "two"));
+  EXPECT_EQ(pair_queue.front().second, "one");
+  EXPECT_EQ(pair_queue.back().first, 2);
+}
+
+TEST(queue_allocator, propagation) {
+  allocation_stats left_stats;
+  allocation_stats right_stats;
+  using alloc = tracking_allocator<int, false>;
+  {
+    s21::queue<int, alloc> left({1, 2}, alloc(&left_stats));
+    s21::queue<int, alloc> right({3, 4, 5}, alloc(&right_stats));
+
+    left = std::move(right);
+    EXPECT_EQ(left.size(), 3U);
+    EXPECT_EQ(left.front(), 3);
+    EXPECT_EQ(left.back(), 5);
+    EXPECT_EQ(left_stats.live(), 3U);
+    EXPECT_EQ(right_stats.live(), 0U);
+  }
+  EXPECT_EQ(left_stats.live(), 0U);
+
+  using prop_alloc = tracking_allocator<int, true>;
+  s21::queue<int, prop_alloc> first({1}, prop_alloc(&left_stats));
+  s21::queue<int, prop_alloc> second({2, 3}, prop_alloc(&right_stats));
+  first = second;
+  EXPECT_EQ(first.get_allocator().stats(), &right_stats);
+  EXPECT_EQ(first.back(), 3);
+  first.swap(second);
+  EXPECT_EQ(second.size(), 2U);
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "throwing_value.h"
+#include "tracking_allocator.h"
+
+TEST(small_vector_constructor, case1) {
+  s21::small_vector<int, 4> s21_vec_int;
+  s21::small_vector<std::string, 4> s21_vec_string(3);
+
+  EXPECT_EQ(s21_vec_int.size(), 0U);
+  EXPECT_EQ(s21_vec_int.capacity(), 4U);
+  EXPECT_TRUE(s21_vec_int.is_inline());
+
+  EXPECT_EQ(s21_vec_string.size(), 3U);
+  EXPECT_EQ(s21_vec_string.capacity(), 4U);
+  EXPECT_EQ(s21_vec_string[2], "");
+}
+
+TEST(small_vector_constructor, case2) {
+  s21::small_vector<std::string, 2> s21_vec_ref{"Hello", ",", "world"};
+  s21::small_vector<std::string, 2> s21_vec_copy(s21_vec_ref);
+  s21::small_vector<std::string, 2> s21_vec_moved(std::move(s21_vec_ref));
+
+  EXPECT_FALSE(s21_vec_copy.is_inline());
+  EXPECT_EQ(s21_vec_copy.size(), 3U);
+  EXPECT_EQ(s21_vec_copy[2], "world");
+  EXPECT_EQ(s21_vec_moved[0], "Hello");
+  EXPECT_EQ(s21_vec_ref.size(), 0U);
+  EXPECT_TRUE(s21_vec_ref.is_inline());
+}
+
+TEST(small_vector_constructor, case3) {
+  s21::small_vector<std::string, 4> s21_vec_ref{"a", "b"};
+  s21::small_vector<std::string, 4> s21_vec_res(std::move(s21_vec_ref));
+
+  EXPECT_TRUE(s21_vec_res.is_inline());
+  EXPECT_EQ(s21_vec_res.size(), 2U);
+  EXPECT_EQ(s21_vec_res[1], "b");
+  EXPECT_EQ(s21_vec_ref.size(), 0U);
+}
+
+TEST(small_vector_spill, case1) {
+  s21::small_vector<int, 4> s21_vec;
+  for (int i = 0; i < 4; ++i) {
+    s21_vec.push_back(i);
+  }
+  EXPECT_TRUE(s21_vec.is_inline());
+
+  s21_vec.push_back(4);
+  EXPECT_FALSE(s21_vec.is_inline());
+  EXPECT_EQ(s21_vec.capacity(), 8U);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(s21_vec[i], i);
+  }
+
+  s21_vec.pop_back();
+  s21_vec.shrink_to_fit();
+  EXPECT_TRUE(s21_vec.is_inline());
+  EXPECT_EQ(s21_vec.capacity(), 4U);
+  EXPECT_EQ(s21_vec.back(), 3);
+
+  s21_vec.push_back(4);
+  s21_vec.clear();
+  EXPECT_FALSE(s21_vec.is_inline());
+  EXPECT_EQ(s21_vec.capacity(), 8U);
+  EXPECT_TRUE(s21_vec.empty());
+  s21_vec.shrink_to_fit();
+  EXPECT_TRUE(s21_vec.is_inline());
+}
+
+TEST(small_vector_spill, const_access) {
+  s21::small_vector<int, 2> s21_vec{1, 2};
+  const s21::small_vector<int, 2> &view = s21_vec;
+  EXPECT_EQ(view[1], 2);
+  EXPECT_EQ(view.data(), &s21_vec[0]);
+  s21_vec.push_back(3);
+  EXPECT_EQ(std::vector<int>(view.begin(), view.end()),
+            (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(view.data()[2], 3);
+}
+
+TEST(small_vector_modifiers, insert_erase) {
+  s21::small_vector<std::string, 3> s21_vec{"a", "d"};
+  s21_vec.insert(s21_vec.begin() + 1, "b");
+  std::vector<std::string> source{"c", "e", "f"};
+  s21_vec.insert(s21_vec.begin() + 2, source.begin(), source.begin() + 1);
+  s21_vec.append_range(source);
+  s21_vec.erase(s21_vec.begin() + 4);
+
+  std::vector<std::string> expected{"a", "b", "c", "d", "e", "f"};
+  ASSERT_EQ(s21_vec.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(s21_vec[i], expected[i]);
+  }
+
+  auto it = s21_vec.erase(s21_vec.begin(), s21_vec.begin() + 2);
+  EXPECT_EQ(*it, "c");
+  EXPECT_EQ(s21_vec.size(), 4U);
+  EXPECT_THROW(s21_vec.at(4), std::out_of_range);
+}
+
+TEST(small_vector_modifiers, emplace_and_insert_many) {
+  s21::small_vector<std::unique_ptr<int>, 2> s21_vec;
+  s21_vec.emplace_back(new int(1));
+  s21_vec.emplace(s21_vec.begin(), new int(0));
+  s21_vec.push_back(std::make_unique<int>(3));
+  s21_vec.insert(s21_vec.begin() + 2, std::make_unique<int>(2));
+
+  ASSERT_EQ(s21_vec.size(), 4U);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(*s21_vec[i], i);
+  }
+
+  s21::small_vector<int, 8> s21_vec_int{1, 5};
+  s21_vec_int.insert_many(s21_vec_int.begin() + 1, 2, 3, 4);
+  s21_vec_int.insert_many_back(6, 7);
+  EXPECT_TRUE(s21_vec_int.is_inline());
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_EQ(s21_vec_int[i], i + 1);
+  }
+}
+
+// A copy that throws halfway leaves the vector as it was; ASan catches
+// slots that are destroyed twice.
+TEST(small_vector_modifiers, insert_throwing_copy) {
+  s21::small_vector<throwing_value, 16> s21_vec;
+  for (int i = 0; i < 4; ++i) s21_vec.emplace_back(i);
+  std::vector<throwing_value> source;
+  for (int i = 10; i < 13; ++i) source.emplace_back(i);
+
+  throwing_value::copies_left() = 1;
+  EXPECT_THROW(
+      s21_vec.insert(s21_vec.begin() + 1, source.begin(), source.end()),
+      std::runtime_error);
+  throwing_value::copies_left() = 1;
+  EXPECT_THROW(s21_vec.insert_many(s21_vec.begin() + 1, source[0], source[1]),
+               std::runtime_error);
+  throwing_value::copies_left() = -1;
+  ASSERT_EQ(s21_vec.size(), 4U);
+  for (int i = 0; i < 4; ++i) EXPECT_EQ(s21_vec[i].value(), i);
+}
+
+// Arguments that point into the vector stay valid while it spills.
+TEST(small_vector_modifiers, insert_many_own_elements) {
+  s21::small_vector<std::string, 2> s21_vec{std::string(40, 'a'), "b"};
+  s21_vec.insert_many(s21_vec.begin() + 1, s21_vec[0], s21_vec[1]);
+  s21_vec.insert_many_back(s21_vec[0]);
+  std::vector<std::string> expected{std::string(40, 'a'), std::string(40, 'a'),
+                                    "b", "b", std::string(40, 'a')};
+  ASSERT_EQ(s21_vec.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(s21_vec[i], expected[i]);
+  }
+}
+
+// Clearing keeps the heap block, so refilling past N does not allocate.
+TEST(small_vector_allocator, clear_keeps_storage) {
+  allocation_stats stats;
+  {
+    using alloc = tracking_allocator<int>;
+    s21::small_vector<int, 4, alloc> s21_vec{alloc(&stats)};
+    for (int round = 0; round < 10; ++round) {
+      s21_vec.clear();
+      for (int i = 0; i < 32; ++i) s21_vec.push_back(i);
+    }
+    EXPECT_EQ(s21_vec.size(), 32U);
+    EXPECT_LE(stats.allocations, 4U);
+  }
+  EXPECT_EQ(stats.live(), 0U);
+}
+
+TEST(small_vector_modifiers, swap) {
+  s21::small_vector<std::string, 2> s21_vec_small{"x"};
+  s21::small_vector<std::string, 2> s21_vec_big{"a", "b", "c"};
+
+  s21_vec_small.swap(s21_vec_big);
+
+  EXPECT_EQ(s21_vec_small.size(), 3U);
+  EXPECT_EQ(s21_vec_small[2], "c");
+  EXPECT_FALSE(s21_vec_small.is_inline());
+  EXPECT_EQ(s21_vec_big.size(), 1U);
+  EXPECT_EQ(s21_vec_big.front(), "x");
+  EXPECT_TRUE(s21_vec_big.is_inline());
+}
+
+TEST(small_vector_modifiers, assign) {
+  s21::small_vector<int, 4> s21_vec{9, 9, 9, 9, 9, 9};
+  s21_vec.assign({1, 2});
+  EXPECT_EQ(s21_vec.size(), 2U);
+  EXPECT_EQ(s21_vec[1], 2);
+}
+
+TEST(small_vector_allocator, spill) {
+  allocation_stats stats;
+  {
+    using alloc = tracking_allocator<int>;
+    s21::small_vector<int, 4, alloc> s21_vec{alloc(&stats)};
+    s21_vec.insert_many_back(1, 2, 3, 4);
+    EXPECT_EQ(stats.allocations, 0U);
+    s21_vec.push_back(5);
+    EXPECT_EQ(stats.allocations, 1U);
+
+    s21::small_vector<int, 4, alloc> s21_moved(std::move(s21_vec));
+    EXPECT_EQ(stats.allocations, 1U);
+    EXPECT_EQ(s21_moved.get_allocator().stats(), &stats);
+    EXPECT_EQ(s21_moved[4], 5);
+  }
+  EXPECT_EQ(stats.live(), 0U);
+}
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <stack>
 
 #include "../s21_containers.h"
+#include "tracking_allocator.h"
 
 TEST(stack, case1) {
   s21::stack<int> s21_stack_int;
@@ -334,3 +336,42 @@ TEST(stack_insert_many_back, case2) {
   EXPECT_EQ(s21_stack_double.top(), 255.5);
   EXPECT_EQ(s21_stack_string.top(), "def");
 }
+
+TEST(stack_emplace, case1) {
+  s21::stack<std::unique_ptr<int>> s21_stack;
+  s21_stack.push(std::make_unique<int>(1));
+  s21_stack.emplace(new int(2));
+
+  EXPECT_EQ(s21_stack.size(), 2U);
+  EXPECT_EQ(*s21_stack.top(), 2);
+  s21_stack.pop();
+  EXPECT_EQ(*s21_stack.top(), 1);
+
+  s21::stack<std::pair<int, std::string>> pair_stack;
+  auto &ref = pair_stack.emplace(1, "one");
+  EXPECT_EQ(ref.second, "one");
+  EXPECT_EQ(pair_stack.top().first, 1);
+}
+
+TEST(stack_allocator, case1) {
+  allocation_stats left_stats;
+  allocation_stats right_stats;
+  using alloc = tracking_allocator<int, false>;
+  {
+    s21::stack<int, alloc> left({1, 2}, alloc(&left_stats));
+    s21::stack<int, alloc> right({3, 4, 5}, alloc(&right_stats));
+    EXPECT_EQ(right_stats.live(), 3U);
+
+    left = std::move(right);
+    EXPECT_EQ(left.size(), 3U);
+    EXPECT_EQ(left.top(), 5);
+    EXPECT_EQ(left_stats.live(), 3U);
+    EXPECT_EQ(right_stats.live(), 0U);
+
+    s21::stack<int, alloc> copy(left);
+    EXPECT_EQ(copy.get_allocator().stats(), &left_stats);
+    copy.pop();
+    EXPECT_EQ(copy.top(), 4);
+  }
+  EXPECT_EQ(left_stats.live(), 0U);
+}
@@ -0,0 +1,54 @@
+#ifndef S21_TESTS_THROWING_VALUE_H
+#define S21_TESTS_THROWING_VALUE_H
+
+#include <stdexcept>
+
+// Value type for exception-safety tests. Each instance owns a heap cell, so
+// a slot that is destroyed twice or never built shows up under ASan. The
+// int constructor throws for negative values, and copies throw once the
+// shared budget in copies_left() runs out (a negative budget never does).
+class throwing_value {
+ public:
+  static int &copies_left() {
+    static int left = -1;
+    return left;
+  }
+
+  explicit throwing_value(int value) : cell_(make(value)) {}
+  throwing_value(const throwing_value &other) : cell_(copy(other)) {}
+  throwing_value(throwing_value &&other) noexcept : cell_(other.cell_) {
+    other.cell_ = nullptr;
+  }
+  throwing_value &operator=(const throwing_value &other) {
+    if (this != &other) {
+      int *fresh = copy(other);
+      delete cell_;
+      cell_ = fresh;
+    }
+    return *this;
+  }
+  throwing_value &operator=(throwing_value &&other) noexcept {
+    int *old = cell_;
+    cell_ = other.cell_;
+    other.cell_ = old;
+    return *this;
+  }
+  ~throwing_value() { delete cell_; }
+
+  int value() const { return cell_ == nullptr ? -1 : *cell_; }
+
+ private:
+  static int *make(int value) {
+    if (value < 0) throw std::runtime_error("throwing_value");
+    return new int(value);
+  }
+  static int *copy(const throwing_value &other) {
+    if (copies_left() == 0) throw std::runtime_error("throwing_value");
+    if (copies_left() > 0) --copies_left();
+    return other.cell_ == nullptr ? nullptr : new int(*other.cell_);
+  }
+
+  int *cell_;
+};
+
+#endif
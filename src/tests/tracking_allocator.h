@@ -0,0 +1,73 @@
+#ifndef S21_TESTS_TRACKING_ALLOCATOR_H
+#define S21_TESTS_TRACKING_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+// Stateful test allocator: every instance reports to an allocation_stats
+// block, and two instances compare equal only when they share one. The
+// Propagate flag drives all three propagate_on_container_* traits.
+struct allocation_stats {
+  size_t allocations = 0;
+  size_t deallocations = 0;
+
+  size_t live() const { return allocations - deallocations; }
+};
+
+template <typename T, bool Propagate = true>
+class tracking_allocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment =
+      std::integral_constant<bool, Propagate>;
+  using propagate_on_container_move_assignment =
+      std::integral_constant<bool, Propagate>;
+  using propagate_on_container_swap = std::integral_constant<bool, Propagate>;
+  using is_always_equal = std::false_type;
+
+  template <typename U>
+  struct rebind {
+    using other = tracking_allocator<U, Propagate>;
+  };
+
+  // Default-constructed instances share one stats block per value type.
+  tracking_allocator() noexcept : stats_(&default_stats()) {}
+  explicit tracking_allocator(allocation_stats *stats) noexcept
+      : stats_(stats) {}
+  template <typename U>
+  tracking_allocator(const tracking_allocator<U, Propagate> &other) noexcept
+      : stats_(other.stats()) {}
+
+  T *allocate(size_t n) {
+    ++stats_->allocations;
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+  }
+
+  void deallocate(T *ptr, size_t) noexcept {
+    ++stats_->deallocations;
+    ::operator delete(ptr, std::align_val_t(alignof(T)));
+  }
+
+  allocation_stats *stats() const noexcept { return stats_; }
+
+  template <typename U>
+  bool operator==(const tracking_allocator<U, Propagate> &other) const {
+    return stats_ == other.stats();
+  }
+  template <typename U>
+  bool operator!=(const tracking_allocator<U, Propagate> &other) const {
+    return stats_ != other.stats();
+  }
+
+ private:
+  static allocation_stats &default_stats() {
+    static allocation_stats stats;
+    return stats;
+  }
+
+  allocation_stats *stats_;
+};
+
+#endif
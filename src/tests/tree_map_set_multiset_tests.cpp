@@ -1,9 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
 #include <map>
 #include <set>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "../s21_containers.h"
+#include "throwing_value.h"
+#include "tracking_allocator.h"
 
 // #include "../containers/Map/s21_map.h"
 // #include "../containers/Multiset/s21_multiset.h"
@@ -217,6 +224,121 @@ TEST(MapTest, SimpleInsertion) {
   EXPECT_EQ(test_map[3], "three");
 }
 
+namespace {
+// Считает, сколько раз значение было построено
+struct Constructed {
+  static int count;
+  std::string text;
+  Constructed(size_t n, char c) : text(n, c) { ++count; }
+  Constructed(const Constructed& other) : text(other.text) { ++count; }
+  Constructed(Constructed&& other) noexcept : text(std::move(other.text)) {
+    ++count;
+  }
+};
+int Constructed::count = 0;
+}  // namespace
+
+TEST(MapTest, TryEmplaceBuildsOnlyOnInsert) {
+  s21::map<int, Constructed> test_map;
+  Constructed::count = 0;
+  EXPECT_TRUE(test_map.try_emplace(1, 3, 'a').second);
+  EXPECT_EQ(Constructed::count, 1);
+
+  size_t nodes = test_map.poolHits() + test_map.poolMisses();
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_FALSE(test_map.try_emplace(1, 5, 'b').second);
+  }
+  EXPECT_EQ(Constructed::count, 1);
+  EXPECT_EQ(test_map.poolHits() + test_map.poolMisses(), nodes);
+  EXPECT_EQ(test_map.at(1).text, "aaa");
+}
+
+TEST(MapTest, EmplaceAndInsertIterators) {
+  s21::map<std::string, int> test_map;
+  std::string key = "key";
+  EXPECT_TRUE(test_map.try_emplace(std::move(key), 7).second);
+  EXPECT_TRUE(test_map.emplace("other", 8).second);
+  EXPECT_FALSE(test_map.emplace("key", 9).second);
+  EXPECT_EQ(test_map.at("key"), 7);
+
+  auto [it, inserted] = test_map.insert("third", 3);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(it->first, "third");
+  EXPECT_EQ((*test_map.insert("third", 4).first).second, 3);
+  EXPECT_EQ(test_map.insert_or_assign("third", 5).first->second, 5);
+}
+
+TEST(MapTest, IteratorReferencesNode) {
+  s21::map<int, std::string> test_map = {{1, "a"}, {2, "b"}, {3, "c"}};
+  for (auto& [key, value] : test_map) value += std::to_string(key);
+  EXPECT_EQ(test_map.at(2), "b2");
+
+  auto it = test_map.find(3);
+  EXPECT_EQ(&it->second, &test_map.at(3));
+  EXPECT_EQ(&*it, &*test_map.find(3));
+  --it;
+  EXPECT_EQ(it->first, 2);
+  EXPECT_EQ(std::distance(test_map.begin(), test_map.end()), 3);
+
+  const auto& const_map = test_map;
+  std::vector<std::string> values;
+  for (const auto& item : const_map) values.push_back(item.second);
+  EXPECT_EQ(values, std::vector<std::string>({"a1", "b2", "c3"}));
+  s21::map<int, std::string>::const_iterator const_it = test_map.begin();
+  EXPECT_TRUE(const_it == const_map.begin());
+  EXPECT_TRUE(const_map.find(7) == const_map.end());
+  EXPECT_THROW(*test_map.end(), std::out_of_range);
+}
+
+TEST(SetTest, EmplaceSkipsAllocationOnDuplicate) {
+  s21::set<std::string> test_set;
+  EXPECT_TRUE(test_set.emplace(3, 'x').second);
+  size_t nodes = test_set.poolHits() + test_set.poolMisses();
+  auto [it, inserted] = test_set.emplace("xxx");
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(*it, "xxx");
+  EXPECT_EQ(test_set.poolHits() + test_set.poolMisses(), nodes);
+
+  std::string value = "yyy";
+  EXPECT_TRUE(test_set.insert(std::move(value)).second);
+  EXPECT_TRUE(test_set.contains("yyy"));
+
+  s21::multiset<std::string> test_multiset;
+  test_multiset.emplace(2, 'z');
+  EXPECT_EQ(*test_multiset.emplace("zz"), "zz");
+  EXPECT_EQ(test_multiset.count("zz"), 2U);
+}
+
+namespace {
+// Ключ, считающий живые экземпляры
+struct LiveKey {
+  static int live;
+  int value;
+  LiveKey(int v) : value(v) { ++live; }
+  LiveKey(const LiveKey& other) : value(other.value) { ++live; }
+  ~LiveKey() { --live; }
+  bool operator<(const LiveKey& other) const { return value < other.value; }
+};
+int LiveKey::live = 0;
+}  // namespace
+
+TEST(SetTest, NodesStoreKeyOnce) {
+  {
+    s21::set<LiveKey> test_set;
+    s21::multiset<LiveKey> test_multiset;
+    for (int i = 0; i < 10; ++i) {
+      test_set.insert(LiveKey(i));
+      test_multiset.insert(LiveKey(i % 3));
+    }
+    EXPECT_EQ(LiveKey::live, 20);
+    s21::set<LiveKey> copy(test_set);
+    EXPECT_EQ(LiveKey::live, 30);
+    EXPECT_EQ((*copy.find(LiveKey(4))).value, 4);
+    EXPECT_EQ(test_multiset.count(LiveKey(1)), 3U);
+  }
+  EXPECT_EQ(LiveKey::live, 0);
+}
+
 // __________MULTISET__________ //
 
 TEST(MultisetTest, InsertAndSize) {
@@ -280,6 +402,28 @@ TEST(MultisetTest, EraseSingleElement) {
   EXPECT_EQ(std_it, std_multiset.end());
 }
 
+// Среди равных ключей удаляется именно элемент под итератором, и
+// итераторы на остальные остаются действительными
+TEST(MultisetTest, EraseRemovesExactlyPos) {
+  s21::multiset<int> my_multiset = {1, 5, 5, 5, 5, 5, 5, 5, 9};
+  std::vector<s21::multiset<int>::iterator> fives;
+  for (auto it = my_multiset.find(5); it != my_multiset.end() && *it == 5;
+       ++it) {
+    fives.push_back(it);
+  }
+  ASSERT_EQ(fives.size(), 7U);
+  my_multiset.erase(fives[3]);
+  EXPECT_EQ(my_multiset.size(), 8U);
+  EXPECT_EQ(my_multiset.count(5), 6U);
+  size_t visited = 0;
+  for (auto it = fives[0]; it != my_multiset.end(); ++it) ++visited;
+  EXPECT_EQ(visited, 7U);
+  EXPECT_EQ(std::next(fives[2]), fives[4]);
+  EXPECT_EQ(std::prev(fives[4]), fives[2]);
+  my_multiset.erase(my_multiset.end());
+  EXPECT_EQ(my_multiset.size(), 8U);
+}
+
 TEST(MultisetTest, InsertMany) {
   s21::multiset<int> my_multiset;
   std::multiset<int> std_multiset;
@@ -334,6 +478,28 @@ TEST(MultisetTest, EqualRangeTest) {
   EXPECT_EQ(count, std_count);
 }
 
+TEST(MultisetTest, CountMatchesStd) {
+  s21::multiset<int> ms;
+  std::multiset<int> std_ms;
+  for (int i = 0; i < 2000; ++i) {
+    ms.insert((i * 37) % 101);
+    std_ms.insert((i * 37) % 101);
+  }
+  for (int i = 0; i < 500; ++i) {
+    ms.erase(ms.find(i % 101));
+    std_ms.erase(std_ms.find(i % 101));
+  }
+  const s21::multiset<int>& const_ms = ms;
+  for (int key = -1; key <= 101; ++key) {
+    EXPECT_EQ(const_ms.count(key), std_ms.count(key));
+  }
+  auto [first, last] = const_ms.equal_range(50);
+  EXPECT_EQ(*first, 50);
+  EXPECT_EQ(last, const_ms.upper_bound(50));
+  EXPECT_EQ(*const_ms.lower_bound(100), 100);
+  EXPECT_EQ(const_ms.upper_bound(100), const_ms.end());
+}
+
 TEST(MultisetTest, LowerBoundTest) {
   s21::multiset<int> ms = {1, 2, 4, 5, 7};
   auto it = ms.lower_bound(4);
@@ -352,4 +518,694 @@ TEST(MultisetTest, UpperBoundTest) {
   EXPECT_EQ(it, ms.end());
   std::multiset<int> std_ms = {1, 2, 4, 5, 7};
   EXPECT_EQ(it == ms.end(), std_ms.upper_bound(7) == std_ms.end());
-}
\ No newline at end of file
+}
+
+
+TEST(TreeAllocatorTest, Nodes) {
+  allocation_stats stats;
+  {
+    using alloc = tracking_allocator<std::pair<const int, int>>;
+    // Узлы выделяются чанками пула: первый чанк вмещает все три узла
+    s21::map<int, int, std::less<int>, alloc> m({{1, 10}, {2, 20}, {3, 30}},
+                                                alloc(&stats));
+    EXPECT_EQ(stats.live(), 1U);
+    m.insert(2, 25);
+    m.erase(m.find(1));
+    EXPECT_EQ(stats.live(), 1U);
+
+    s21::map<int, int, std::less<int>, alloc> copy(m);
+    EXPECT_EQ(copy.get_allocator().stats(), &stats);
+    EXPECT_EQ(copy.at(3), 30);
+    EXPECT_EQ(stats.live(), 2U);
+    copy.clear();
+    EXPECT_EQ(stats.live(), 1U);
+  }
+  EXPECT_EQ(stats.live(), 0U);
+}
+
+TEST(TreeAllocatorTest, Propagation) {
+  allocation_stats left_stats;
+  allocation_stats right_stats;
+  using alloc = tracking_allocator<int, false>;
+  s21::set<int, std::less<int>, alloc> left({1, 2}, alloc(&left_stats));
+  s21::set<int, std::less<int>, alloc> right({3, 4, 5}, alloc(&right_stats));
+  left = std::move(right);
+  EXPECT_EQ(left.size(), 3U);
+  EXPECT_TRUE(left.contains(4));
+  EXPECT_EQ(left_stats.live(), 1U);
+  EXPECT_EQ(right_stats.live(), 0U);
+
+  using prop_alloc = tracking_allocator<int, true>;
+  s21::multiset<int, std::less<int>, prop_alloc> first({1, 1},
+                                                       prop_alloc(&left_stats));
+  s21::multiset<int, std::less<int>, prop_alloc> second(
+      {2}, prop_alloc(&right_stats));
+  first.swap(second);
+  EXPECT_EQ(first.get_allocator().stats(), &right_stats);
+  EXPECT_EQ(second.count(1), 2U);
+}
+
+TEST(TreeNodePoolTest, RecyclesErasedNodes) {
+  s21::map<int, int> m;
+  for (int i = 0; i < 100; ++i) m.insert(i, i);
+  EXPECT_EQ(m.poolHits(), 0U);
+  EXPECT_EQ(m.poolMisses(), 100U);
+
+  for (int i = 0; i < 50; ++i) m.erase(m.find(i));
+  for (int i = 100; i < 150; ++i) m.insert(i, i);
+  EXPECT_EQ(m.poolHits(), 50U);
+  EXPECT_EQ(m.poolMisses(), 100U);
+  EXPECT_EQ(m.size(), 100U);
+  EXPECT_EQ(m.at(149), 149);
+}
+
+TEST(TreeNodePoolTest, ClearReleasesChunks) {
+  allocation_stats stats;
+  using alloc = tracking_allocator<int>;
+  s21::multiset<int, std::less<int>, alloc> ms{alloc(&stats)};
+  for (int i = 0; i < 1000; ++i) ms.insert(i % 7);
+  size_t chunks = stats.allocations;
+  EXPECT_LT(chunks, 20U);
+  EXPECT_EQ(stats.live(), chunks);
+
+  ms.clear();
+  EXPECT_EQ(stats.live(), 0U);
+  ms.insert(1);
+  EXPECT_EQ(stats.live(), 1U);
+  EXPECT_EQ(ms.count(1), 1U);
+}
+
+TEST(TreeOrderStatisticTest, SetRankSelect) {
+  s21::set<int> s;
+  std::set<int> std_s;
+  for (int i = 0; i < 500; ++i) {
+    s.insert((i * 53) % 997);
+    std_s.insert((i * 53) % 997);
+  }
+  for (int i = 0; i < 200; ++i) {
+    s.erase(s.find((i * 53) % 997));
+    std_s.erase((i * 53) % 997);
+  }
+  size_t index = 0;
+  for (int key : std_s) {
+    EXPECT_EQ(*s.select(index), key);
+    EXPECT_EQ(s.rank(key), index);
+    ++index;
+  }
+  EXPECT_EQ(s.select(s.size()), s.end());
+  EXPECT_EQ(s.rank(-1), 0U);
+  EXPECT_EQ(s.rank(1000), s.size());
+  EXPECT_EQ(s.count_range(100, 300),
+            static_cast<size_t>(std::distance(std_s.lower_bound(100),
+                                              std_s.lower_bound(300))));
+  EXPECT_EQ(s.count_range(300, 100), 0U);
+}
+
+TEST(TreeOrderStatisticTest, MultisetAndMap) {
+  s21::multiset<int> ms = {1, 2, 2, 2, 3, 5, 5, 8};
+  EXPECT_EQ(ms.rank(2), 1U);
+  EXPECT_EQ(ms.rank(5), 5U);
+  EXPECT_EQ(*ms.select(3), 2);
+  EXPECT_EQ(*ms.select(6), 5);
+  EXPECT_EQ(ms.count_range(2, 5), 4U);
+  EXPECT_EQ(ms.count(2), 3U);
+
+  s21::map<int, std::string> m = {{30, "c"}, {10, "a"}, {20, "b"}};
+  EXPECT_EQ(m.select(1)->second, "b");
+  EXPECT_EQ(m.select(3), m.end());
+  EXPECT_EQ(m.rank(25), 2U);
+  EXPECT_EQ(m.count_range(10, 30), 2U);
+
+  s21::map<int, std::string> copy(m);
+  EXPECT_EQ(copy.select(2)->second, "c");
+}
+
+TEST(TreeBulkLoadTest, MapFromSorted) {
+  std::vector<std::pair<int, std::string>> items;
+  for (int i = 0; i < 1000; ++i) items.emplace_back(i * 2, std::to_string(i));
+  auto m = s21::map<int, std::string>::from_sorted(items.begin(), items.end(),
+                                                   true);
+  EXPECT_EQ(m.size(), 1000U);
+  EXPECT_EQ(m.at(1998), "999");
+  EXPECT_EQ(m.select(500)->first, 1000);
+  EXPECT_EQ(m.rank(11), 6U);
+
+  // После загрузки дерево остается корректным для обычных операций
+  m.insert(1, "odd");
+  m.erase(m.find(0));
+  EXPECT_EQ(m.select(0)->second, "odd");
+  EXPECT_EQ(m.size(), 1000U);
+
+  std::vector<std::pair<int, std::string>> small = {{5, "five"}};
+  m.bulk_load(small.begin(), small.end());
+  EXPECT_EQ(m.size(), 1U);
+  EXPECT_EQ(m.at(5), "five");
+}
+
+TEST(TreeBulkLoadTest, SetAndMultiset) {
+  std::vector<int> keys = {1, 2, 2, 3, 5, 8, 8, 8};
+  auto ms = s21::multiset<int>::from_sorted(keys.begin(), keys.end(), true);
+  EXPECT_EQ(ms.size(), 8U);
+  EXPECT_EQ(ms.count(8), 3U);
+  EXPECT_EQ(*ms.select(4), 5);
+
+  EXPECT_THROW(s21::set<int>::from_sorted(keys.begin(), keys.end(), true),
+               std::invalid_argument);
+  std::vector<int> unsorted = {3, 1, 2};
+  EXPECT_THROW(ms.bulk_load(unsorted.begin(), unsorted.end(), true),
+               std::invalid_argument);
+  EXPECT_EQ(ms.size(), 8U);
+
+  s21::set<int> s = {42};
+  s.bulk_load(keys.begin(), keys.begin() + 2);
+  EXPECT_EQ(s.size(), 2U);
+  EXPECT_FALSE(s.contains(42));
+  EXPECT_EQ(*s.begin(), 1);
+
+  s.bulk_load(keys.begin(), keys.begin());
+  EXPECT_TRUE(s.empty());
+}
+
+namespace {
+// Ключ, считающий сравнения
+struct CountingKey {
+  static size_t comparisons;
+  int value;
+  bool operator<(const CountingKey& other) const {
+    ++comparisons;
+    return value < other.value;
+  }
+  bool operator>(const CountingKey& other) const { return other < *this; }
+  bool operator<=(const CountingKey& other) const { return !(other < *this); }
+};
+size_t CountingKey::comparisons = 0;
+}  // namespace
+
+TEST(TreeBoundsTest, BeginAndEndTrackExtremes) {
+  s21::set<int> s;
+  EXPECT_TRUE(s.begin() == s.end());
+  auto end = s.end();
+  for (int i = 0; i < 100; ++i) s.insert((i * 37) % 100);
+  // end(), взятый до вставок, видит текущий максимум
+  EXPECT_EQ(*--end, 99);
+  EXPECT_EQ(*s.begin(), 0);
+
+  s.erase(s.begin());
+  s.erase(s.find(99));
+  EXPECT_EQ(*s.begin(), 1);
+  EXPECT_EQ(*--s.end(), 98);
+
+  s21::map<int, int> m = {{5, 50}, {1, 10}, {9, 90}};
+  EXPECT_EQ(m.begin()->second, 10);
+  EXPECT_EQ((--m.end())->second, 90);
+  m.clear();
+  EXPECT_TRUE(m.begin() == m.end());
+
+  s21::multiset<int> ms = {3, 3, 1};
+  s21::multiset<int> moved(std::move(ms));
+  EXPECT_EQ(*moved.begin(), 1);
+  EXPECT_EQ(*--moved.end(), 3);
+  EXPECT_TRUE(ms.begin() == ms.end());
+}
+
+TEST(TreeHintTest, AppendAtEndIsConstant) {
+  s21::set<CountingKey> s;
+  CountingKey::comparisons = 0;
+  for (int i = 0; i < 10000; ++i) s.insert(s.end(), CountingKey{i});
+  EXPECT_EQ(s.size(), 10000U);
+  EXPECT_LE(CountingKey::comparisons, 2U * 10000);
+  EXPECT_EQ((*s.select(1234)).value, 1234);
+
+  s21::map<int, int> m;
+  auto last = m.end();
+  for (int i = 0; i < 100; ++i) last = m.emplace_hint(last, i, i * i);
+  EXPECT_EQ(last->second, 99 * 99);
+  EXPECT_EQ(m.size(), 100U);
+  EXPECT_EQ(m.at(7), 49);
+}
+
+TEST(TreeHintTest, WrongHintFallsBack) {
+  s21::set<int> s = {10, 20, 30};
+  auto it = s.insert(s.begin(), 25);
+  EXPECT_EQ(*it, 25);
+  it = s.insert(s.find(30), 20);
+  EXPECT_EQ(*it, 20);
+  EXPECT_EQ(s.size(), 4U);
+  it = s.emplace_hint(s.find(20), 15);
+  EXPECT_EQ(*it, 15);
+  std::vector<int> values;
+  for (int value : s) values.push_back(value);
+  EXPECT_EQ(values, std::vector<int>({10, 15, 20, 25, 30}));
+
+  s21::map<int, std::string> m = {{1, "a"}, {3, "c"}};
+  auto mit = m.insert(m.find(3), {2, "b"});
+  EXPECT_EQ(mit->second, "b");
+  EXPECT_EQ(m.insert(m.begin(), {3, "x"})->second, "c");
+  EXPECT_EQ(m.select(1)->first, 2);
+}
+
+TEST(TreeHintTest, MultisetInsertsBeforeHint) {
+  s21::multiset<int> ms = {1, 5, 5, 9};
+  auto first_five = ms.lower_bound(5);
+  auto it = ms.insert(first_five, 5);
+  EXPECT_EQ(ms.rank(5), 1U);
+  EXPECT_EQ(ms.select(1), it);
+  EXPECT_EQ(ms.count(5), 3U);
+
+  it = ms.emplace_hint(ms.end(), 2);
+  EXPECT_EQ(*it, 2);
+  std::vector<int> values;
+  for (int value : ms) values.push_back(value);
+  EXPECT_EQ(values, std::vector<int>({1, 2, 5, 5, 5, 9}));
+}
+
+TEST(TreeCompareTest, TransparentLookup) {
+  s21::map<std::string, int, std::less<>> m = {{"apple", 1}, {"pear", 2}};
+  std::string_view pear = "pear";
+  EXPECT_TRUE(m.contains(pear));
+  EXPECT_FALSE(m.contains(std::string_view("plum")));
+  EXPECT_EQ(m.find(pear)->second, 2);
+  EXPECT_TRUE(m.find("plum") == m.end());
+
+  s21::set<std::string, std::less<>> s = {"b", "d", "f"};
+  EXPECT_EQ(*s.find(std::string_view("d")), "d");
+  EXPECT_EQ(*s.lower_bound(std::string_view("c")), "d");
+  EXPECT_EQ(s.count(std::string_view("f")), 1U);
+
+  s21::multiset<std::string, s21::three_way_compare> ms = {"x", "y", "y"};
+  EXPECT_EQ(ms.count(std::string_view("y")), 2U);
+  auto range = ms.equal_range(std::string_view("y"));
+  EXPECT_EQ(range.first, ms.find("y"));
+  EXPECT_EQ(range.second, ms.end());
+}
+
+namespace {
+// Трехсторонний компаратор, считающий вызовы
+struct CountingThreeWay {
+  using is_three_way = void;
+  static size_t calls;
+  int operator()(int a, int b) const {
+    ++calls;
+    return a < b ? -1 : (a > b ? 1 : 0);
+  }
+};
+size_t CountingThreeWay::calls = 0;
+}  // namespace
+
+TEST(TreeCompareTest, CustomComparators) {
+  s21::set<int, std::greater<int>> desc = {3, 1, 2};
+  std::vector<int> values;
+  for (int value : desc) values.push_back(value);
+  EXPECT_EQ(values, std::vector<int>({3, 2, 1}));
+  EXPECT_EQ(desc.rank(2), 1U);
+  EXPECT_TRUE(desc.key_comp()(2, 1));
+
+  s21::map<int, int, CountingThreeWay> m;
+  for (int i = 0; i < 1024; ++i) m.insert(i, i);
+  // Один вызов на уровень: высота красно-черного дерева не больше
+  // 2 * log2(n + 1)
+  CountingThreeWay::calls = 0;
+  EXPECT_EQ(m.find(777)->second, 777);
+  EXPECT_LE(CountingThreeWay::calls, 21U);
+  CountingThreeWay::calls = 0;
+  EXPECT_FALSE(m.insert(500, 0).second);
+  EXPECT_LE(CountingThreeWay::calls, 21U);
+  EXPECT_EQ(m.count(1023), 1U);
+  EXPECT_EQ(m.count_range(10, 20), 10U);
+}
+
+// Слияние деревьев одного размера идет одним проходом: сравнений не больше
+// двух на элемент, без поиска каждого ключа от корня
+TEST(TreeMergeTest, LinearMergeKeepsSemantics) {
+  s21::map<int, int, CountingThreeWay> target;
+  s21::map<int, int, CountingThreeWay> source;
+  for (int i = 0; i < 1000; ++i) {
+    target.insert(2 * i, 0);
+    source.insert(3 * i, 1);
+  }
+  CountingThreeWay::calls = 0;
+  target.merge(source);
+  EXPECT_LE(CountingThreeWay::calls, 4000U);
+  // Общие ключи (кратные 6) получают значение из source и остаются в нем
+  EXPECT_EQ(target.size(), 1666U);
+  EXPECT_EQ(source.size(), 334U);
+  EXPECT_EQ(target.at(6), 1);
+  EXPECT_EQ(target.at(3), 1);
+  EXPECT_EQ(target.at(4), 0);
+  EXPECT_EQ(source.at(6), 1);
+  EXPECT_FALSE(source.contains(3));
+  // Оба дерева остаются рабочими красно-черными деревьями
+  target.insert(-1, 5);
+  target.erase(target.find(0));
+  EXPECT_EQ(target.begin()->first, -1);
+  EXPECT_EQ(target.select(1)->first, 2);
+  EXPECT_EQ(target.rank(2997), 1665U);
+  source.insert(1, 1);
+  EXPECT_EQ(source.begin()->first, 0);
+
+  s21::multiset<std::string> words = {"b", "a", "b"};
+  s21::multiset<std::string> more = {"b", "c", "a"};
+  words.merge(more);
+  EXPECT_TRUE(more.empty());
+  EXPECT_EQ(std::vector<std::string>(words.begin(), words.end()),
+            std::vector<std::string>({"a", "a", "b", "b", "b", "c"}));
+  EXPECT_EQ(words.count("b"), 3U);
+
+  s21::set<std::string> names = {"x", "y"};
+  s21::set<std::string> others = {"y", "z"};
+  names.merge(others);
+  EXPECT_EQ(names.size(), 3U);
+  EXPECT_TRUE(others.empty());
+  names.merge(names);
+  EXPECT_EQ(names.size(), 3U);
+}
+
+// Несколько ключей в большое дерево ищутся спуском, а не проходом по
+// всему дереву; при равных аллокаторах узлы переходят без выделения
+TEST(TreeMergeTest, SmallMergeMovesNodes) {
+  allocation_stats stats;
+  {
+    using alloc = tracking_allocator<std::pair<const int, int>>;
+    using counted_map = s21::map<int, int, CountingThreeWay, alloc>;
+    counted_map target{alloc(&stats)};
+    counted_map source{alloc(&stats)};
+    for (int i = 0; i < 4096; ++i) target.insert(2 * i, 0);
+    for (int key : {-5, 1, 3, 4, 100, 9000, 9001}) source.insert(key, 1);
+    const int* moved = &source.at(3);
+    const int* shared = &source.at(100);
+    size_t allocations = stats.allocations;
+    CountingThreeWay::calls = 0;
+    target.merge(source);
+    EXPECT_LE(CountingThreeWay::calls, 7U * 26U);
+    EXPECT_EQ(stats.allocations, allocations + 1);
+    EXPECT_EQ(&target.at(3), moved);
+    EXPECT_EQ(target.size(), 4101U);
+    EXPECT_EQ(target.at(4), 1);
+    EXPECT_EQ(target.at(100), 1);
+    EXPECT_EQ(target.begin()->first, -5);
+    EXPECT_EQ((--target.end())->first, 9001);
+    EXPECT_EQ(target.select(3)->first, 2);
+    EXPECT_EQ(target.rank(9000), 4099U);
+    // Общие ключи остаются в source и переезжают в его новый пул
+    EXPECT_EQ(source.size(), 2U);
+    EXPECT_NE(&source.at(100), shared);
+    EXPECT_EQ(source.at(4), 1);
+    source.insert(7, 7);
+    target.erase(target.find(3));
+    EXPECT_EQ(target.size(), 4100U);
+    for (int i = 0; i < 4096; ++i) EXPECT_TRUE(target.contains(2 * i));
+  }
+  EXPECT_EQ(stats.live(), 0U);
+
+  s21::multiset<int> many = {5, 5, 1, 9};
+  for (int i = 10; i < 200; ++i) many.insert(i);
+  s21::multiset<int> few = {5, 0, 9, 300};
+  many.merge(few);
+  EXPECT_TRUE(few.empty());
+  EXPECT_EQ(many.count(5), 3U);
+  EXPECT_EQ(many.count(9), 2U);
+  EXPECT_EQ(*many.begin(), 0);
+  EXPECT_EQ(many.size(), 198U);
+  EXPECT_TRUE(std::is_sorted(many.begin(), many.end()));
+
+  // Ключи-строки копируются: копии строятся до того, как деревья меняются
+  s21::map<std::string, int> names;
+  for (int i = 0; i < 500; ++i) names.insert(std::to_string(1000 + i), i);
+  s21::map<std::string, int> extra = {{"1010", -1}, {"0", 1}, {"2000", 2}};
+  names.merge(extra);
+  EXPECT_EQ(names.size(), 502U);
+  EXPECT_EQ(names.at("1010"), -1);
+  EXPECT_EQ(names.begin()->first, "0");
+  EXPECT_EQ(extra.size(), 1U);
+  EXPECT_EQ(extra.at("1010"), -1);
+}
+
+// С разными аллокаторами содержимое переносится в узлы своего дерева, и
+// каждый аллокатор освобождает только свою память
+TEST(TreeMergeTest, MergeAcrossAllocators) {
+  allocation_stats mine_stats;
+  allocation_stats theirs_stats;
+  {
+    using alloc = tracking_allocator<std::pair<const int, std::string>>;
+    using text_map = s21::map<int, std::string, std::less<int>, alloc>;
+    text_map target{alloc(&mine_stats)};
+    text_map source{alloc(&theirs_stats)};
+    for (int i = 0; i < 300; ++i) target.insert(i, "mine");
+    for (int i = 290; i < 310; ++i) source.insert(i, "theirs");
+    source.insert(source.extract(305));
+    target.merge(source);
+    EXPECT_EQ(target.size(), 310U);
+    EXPECT_EQ(target.at(295), "theirs");
+    EXPECT_EQ(target.at(305), "theirs");
+    EXPECT_EQ(source.size(), 10U);
+    EXPECT_EQ(source.at(299), "theirs");
+    text_map rest{alloc(&theirs_stats)};
+    for (int i = 0; i < 1000; i += 3) rest.insert(i, "rest");
+    target.merge(rest);
+    EXPECT_EQ(target.size(), 310U + 230U);
+    EXPECT_EQ(target.at(999), "rest");
+    EXPECT_EQ(rest.size(), 104U);
+  }
+  EXPECT_EQ(mine_stats.live(), 0U);
+  EXPECT_EQ(theirs_stats.live(), 0U);
+}
+
+// Исключение при слиянии оставляет оба словаря целыми и рабочими
+TEST(TreeMergeTest, ThrowingMergeKeepsBothTrees) {
+  for (bool small : {true, false}) {
+    s21::map<int, throwing_value> target;
+    s21::map<int, throwing_value> source;
+    for (int i = 0; i < 200; ++i) target.insert(2 * i, throwing_value(i));
+    // Малое слияние идет спуском, большое - проходом по обоим деревьям
+    for (int i = small ? 1 : -100; i < 10; i += small ? 3 : 1) {
+      source.insert(i, throwing_value(100));
+    }
+    const size_t source_size = source.size();
+    throwing_value::copies_left() = 0;
+    EXPECT_THROW(target.merge(source), std::runtime_error);
+    throwing_value::copies_left() = -1;
+    EXPECT_EQ(target.size(), 200U);
+    EXPECT_EQ(source.size(), source_size);
+    EXPECT_EQ(source.at(1).value(), 100);
+    EXPECT_FALSE(target.contains(1));
+    target.merge(source);
+    EXPECT_EQ(target.at(1).value(), 100);
+    EXPECT_EQ(target.at(4).value(), 100);
+    EXPECT_EQ(target.at(398).value(), 199);
+    EXPECT_TRUE(source.contains(4));
+    EXPECT_FALSE(source.contains(1));
+  }
+}
+
+TEST(TreeMergeTest, SetAlgebraMatchesStd) {
+  s21::multiset<int> a = {1, 1, 1, 2, 4, 5, 5, 9};
+  s21::multiset<int> b = {1, 2, 2, 3, 5, 9, 9};
+  std::multiset<int> std_a(a.begin(), a.end());
+  std::multiset<int> std_b(b.begin(), b.end());
+  std::vector<int> expected;
+  std::set_union(std_a.begin(), std_a.end(), std_b.begin(), std_b.end(),
+                 std::back_inserter(expected));
+  s21::multiset<int> united = s21::set_union(a, b);
+  EXPECT_EQ(std::vector<int>(united.begin(), united.end()), expected);
+  expected.clear();
+  std::set_intersection(std_a.begin(), std_a.end(), std_b.begin(),
+                        std_b.end(), std::back_inserter(expected));
+  s21::multiset<int> common = s21::set_intersection(a, b);
+  EXPECT_EQ(std::vector<int>(common.begin(), common.end()), expected);
+  expected.clear();
+  std::set_difference(std_a.begin(), std_a.end(), std_b.begin(), std_b.end(),
+                      std::back_inserter(expected));
+  s21::multiset<int> rest = s21::set_difference(a, b);
+  EXPECT_EQ(std::vector<int>(rest.begin(), rest.end()), expected);
+  EXPECT_EQ(*rest.select(rest.size() - 1), 5);
+
+  s21::set<int> evens;
+  s21::set<int> threes;
+  for (int i = 0; i < 300; i += 2) evens.insert(i);
+  for (int i = 0; i < 300; i += 3) threes.insert(i);
+  EXPECT_EQ(s21::set_union(evens, threes).size(), 200U);
+  EXPECT_EQ(s21::set_intersection(evens, threes).size(), 50U);
+  s21::set<int> only_evens = s21::set_difference(evens, threes);
+  EXPECT_EQ(only_evens.size(), 100U);
+  EXPECT_FALSE(only_evens.contains(6));
+  EXPECT_TRUE(only_evens.contains(298));
+  EXPECT_TRUE(s21::set_intersection(evens, s21::set<int>()).empty());
+
+  // Для общих ключей значение берется из первого словаря
+  s21::map<int, std::string> left = {{1, "l1"}, {2, "l2"}};
+  s21::map<int, std::string> right = {{2, "r2"}, {3, "r3"}};
+  s21::map<int, std::string> both = s21::set_union(left, right);
+  EXPECT_EQ(both.size(), 3U);
+  EXPECT_EQ(both.at(2), "l2");
+  EXPECT_EQ(both.at(3), "r3");
+  EXPECT_EQ(s21::set_intersection(right, left).at(2), "r2");
+  EXPECT_EQ(s21::set_difference(left, right).size(), 1U);
+}
+
+// Срез по отметке времени: все, что раньше, уезжает в архив, остальное
+// остается рабочим деревом
+TEST(TreeSplitJoinTest, MapExtractRangeAtWatermark) {
+  s21::map<long, std::string> live;
+  for (long stamp = 0; stamp < 10000; ++stamp) {
+    live.insert(stamp, std::to_string(stamp));
+  }
+  s21::map<long, std::string> archive = live.extract_range(0, 8640);
+  EXPECT_EQ(archive.size(), 8640U);
+  EXPECT_EQ(live.size(), 1360U);
+  EXPECT_EQ(archive.begin()->first, 0);
+  EXPECT_EQ(archive.at(8639), "8639");
+  EXPECT_FALSE(archive.contains(8640));
+  EXPECT_EQ(live.begin()->first, 8640);
+  EXPECT_FALSE(live.contains(100));
+  EXPECT_EQ(live.select(1000)->first, 9640);
+  EXPECT_EQ(live.rank(9999), 1359U);
+  live.insert(5, "late");
+  EXPECT_EQ(live.begin()->second, "late");
+  EXPECT_TRUE(live.extract_range(20000, 30000).empty());
+  EXPECT_TRUE(live.extract_range(9000, 9000).empty());
+  EXPECT_EQ(live.size(), 1361U);
+}
+
+// Узлы, уже побывавшие в node_type, не принадлежат пулу и переходят в
+// результат extract_range без переноса содержимого
+TEST(TreeSplitJoinTest, ExtractRangeAdoptsLooseNodes) {
+  allocation_stats stats;
+  {
+    using alloc = tracking_allocator<std::pair<const int, std::string>>;
+    using session_map = s21::map<int, std::string, std::less<int>, alloc>;
+    session_map active{alloc(&stats)};
+    session_map idle{alloc(&stats)};
+    for (int id = 0; id < 100; ++id) active.insert(id, std::to_string(id));
+    for (int id = 0; id < 100; ++id) idle.insert(active.extract(id));
+    idle.insert(1000, "pooled");
+    const std::string* value = &idle.at(30);
+    size_t allocations = stats.allocations;
+    session_map expired = idle.extract_range(20, 60);
+    EXPECT_LE(stats.allocations, allocations + 1);
+    EXPECT_EQ(&expired.at(30), value);
+    EXPECT_EQ(expired.size(), 40U);
+    EXPECT_EQ(idle.size(), 61U);
+    EXPECT_EQ(expired.rank(59), 39U);
+    session_map tail = idle.extract_range(90, 2000);
+    EXPECT_EQ(tail.at(1000), "pooled");
+    EXPECT_EQ(idle.size(), 50U);
+  }
+  EXPECT_EQ(stats.live(), 0U);
+}
+
+// После многих разрезов дерево остается сбалансированным: поиск делает
+// не больше одного сравнения на уровень высоты 2 * log2(n + 1)
+TEST(TreeSplitJoinTest, SetExtractRangeKeepsBalance) {
+  s21::set<int, CountingThreeWay> my_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 4096; ++i) {
+    my_set.insert(i * 3);
+    std_set.insert(i * 3);
+  }
+  for (int lo = 0; lo < 12000; lo += 700) {
+    s21::set<int, CountingThreeWay> cut = my_set.extract_range(lo, lo + 250);
+    auto first = std_set.lower_bound(lo);
+    auto last = std_set.lower_bound(lo + 250);
+    EXPECT_EQ(std::vector<int>(cut.begin(), cut.end()),
+              std::vector<int>(first, last));
+    std_set.erase(first, last);
+  }
+  ASSERT_EQ(my_set.size(), std_set.size());
+  EXPECT_EQ(std::vector<int>(my_set.begin(), my_set.end()),
+            std::vector<int>(std_set.begin(), std_set.end()));
+  for (int key : {1, 3001, 9999, 12285}) {
+    CountingThreeWay::calls = 0;
+    EXPECT_EQ(my_set.contains(key), std_set.count(key) == 1);
+    EXPECT_LE(CountingThreeWay::calls, 24U);
+  }
+  s21::set<int, CountingThreeWay> rest = my_set.extract_range(-1, 20000);
+  EXPECT_TRUE(my_set.empty());
+  EXPECT_EQ(my_set.begin(), my_set.end());
+  EXPECT_EQ(rest.size(), std_set.size());
+  my_set.insert(7);
+  EXPECT_EQ(*my_set.begin(), 7);
+}
+
+// Сессии ходят между двумя словарями через node_type: после первого
+// extract (узел один раз покидает пул) переезды не трогают аллокатор, а
+// значение остается по тому же адресу
+TEST(TreeNodeHandleTest, MapMovesWithoutAllocation) {
+  allocation_stats stats;
+  {
+    using alloc = tracking_allocator<std::pair<const int, std::string>>;
+    using session_map = s21::map<int, std::string, std::less<int>, alloc>;
+    session_map active{alloc(&stats)};
+    session_map idle{alloc(&stats)};
+    for (int id = 0; id < 100; ++id) active.insert(id, std::to_string(id));
+    for (int id = 0; id < 100; ++id) idle.insert(active.extract(id));
+    EXPECT_TRUE(active.empty());
+    ASSERT_EQ(idle.size(), 100U);
+
+    size_t allocations = stats.allocations;
+    const std::string* value = &idle.at(42);
+    for (int round = 0; round < 11; ++round) {
+      for (int id = 0; id < 100; ++id) {
+        session_map& from = round % 2 ? active : idle;
+        session_map& to = round % 2 ? idle : active;
+        auto result = to.insert(from.extract(from.find(id)));
+        EXPECT_TRUE(result.inserted);
+        EXPECT_TRUE(result.node.empty());
+        EXPECT_EQ(result.position->first, id);
+      }
+    }
+    EXPECT_EQ(stats.allocations, allocations);
+    EXPECT_EQ(&active.at(42), value);
+    EXPECT_EQ(active.at(42), "42");
+    EXPECT_EQ(active.rank(42), 42U);
+    EXPECT_EQ(std::prev(active.end())->first, 99);
+
+    session_map::node_type node = active.extract(7);
+    ASSERT_FALSE(node.empty());
+    node.key() = 1000;
+    node.mapped() = "renamed";
+    idle.insert(std::move(node));
+    EXPECT_EQ(idle.at(1000), "renamed");
+    EXPECT_TRUE(node.empty());
+
+    idle.insert(8, "taken");
+    auto result = idle.insert(active.extract(8));
+    EXPECT_FALSE(result.inserted);
+    EXPECT_EQ(result.position->second, "taken");
+    ASSERT_TRUE(result.node);
+    EXPECT_EQ(result.node.mapped(), "8");
+    EXPECT_TRUE(active.extract(500).empty());
+    EXPECT_TRUE(active.insert(session_map::node_type()).position ==
+                active.end());
+    EXPECT_EQ(active.size(), 98U);
+  }
+  EXPECT_EQ(stats.live(), 0U);
+}
+
+TEST(TreeNodeHandleTest, SetAndMultiset) {
+  s21::set<std::string> names = {"alpha", "beta", "gamma"};
+  s21::set<std::string>::node_type node = names.extract(names.begin());
+  EXPECT_EQ(node.value(), "alpha");
+  node.value() = "delta";
+  auto result = names.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ(*result.position, "delta");
+  EXPECT_EQ(std::vector<std::string>(names.begin(), names.end()),
+            (std::vector<std::string>{"beta", "delta", "gamma"}));
+
+  s21::multiset<int> left = {1, 2, 2, 3};
+  s21::multiset<int> right = {2, 2};
+  auto it = right.insert(left.extract(2));
+  EXPECT_EQ(right.count(2), 3U);
+  EXPECT_EQ(right.rank(2), 0U);
+  EXPECT_EQ(std::next(it), right.end());
+  EXPECT_EQ(left.count(2), 1U);
+  while (!right.empty()) left.insert(right.extract(right.begin()));
+  EXPECT_EQ(std::vector<int>(left.begin(), left.end()),
+            (std::vector<int>{1, 2, 2, 2, 2, 3}));
+  EXPECT_EQ(left.insert(s21::multiset<int>::node_type()), left.end());
+  {
+    s21::multiset<int>::node_type dropped = left.extract(3);
+    EXPECT_EQ(dropped.value(), 3);
+  }
+  EXPECT_EQ(left.size(), 5U);
+}
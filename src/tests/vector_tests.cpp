@@ -1,8 +1,61 @@
 #include <gtest/gtest.h>
 
+#include <iterator>
+#include <memory>
+#include <sstream>
 #include <vector>
 
 #include "../s21_containers.h"
+#include "throwing_value.h"
+#include "tracking_allocator.h"
+
+namespace {
+// No default constructor on purpose: the vector must never need one for
+// its spare capacity.
+struct Tracked {
+  static int constructed;
+  static int destroyed;
+  int value;
+
+  explicit Tracked(int v) : value(v) { ++constructed; }
+  Tracked(const Tracked &other) : value(other.value) { ++constructed; }
+  Tracked &operator=(const Tracked &other) = default;
+  ~Tracked() { ++destroyed; }
+
+  static void reset() { constructed = destroyed = 0; }
+};
+int Tracked::constructed = 0;
+int Tracked::destroyed = 0;
+
+struct ThrowsOnThird {
+  static int made;
+
+  ThrowsOnThird() {
+    if (++made == 3) throw std::runtime_error("third");
+  }
+};
+int ThrowsOnThird::made = 0;
+
+template <bool NoexceptMove>
+struct Relocated {
+  static int copies;
+  static int moves;
+  std::string payload;
+
+  explicit Relocated(const char *str) : payload(str) {}
+  Relocated(const Relocated &other) : payload(other.payload) { ++copies; }
+  Relocated(Relocated &&other) noexcept(NoexceptMove)
+      : payload(std::move(other.payload)) {
+    ++moves;
+  }
+
+  static void reset() { copies = moves = 0; }
+};
+template <bool NoexceptMove>
+int Relocated<NoexceptMove>::copies = 0;
+template <bool NoexceptMove>
+int Relocated<NoexceptMove>::moves = 0;
+}  // namespace
 
 TEST(vector_constructor, case1) {
   s21::vector<int> s21_vec_int;
@@ -606,15 +659,15 @@ TEST(vector_insert_many, case1) {
                                  "many", "www");
 
   EXPECT_EQ(s21_vec_ref_int.size(), 7U);
-  EXPECT_EQ(s21_vec_ref_int.capacity(), 7U);
+  EXPECT_EQ(s21_vec_ref_int.capacity(), 8U);
   EXPECT_EQ(s21_vec_ref_int[2], 5);
 
   EXPECT_EQ(s21_vec_ref_double.size(), 7U);
-  EXPECT_EQ(s21_vec_ref_double.capacity(), 7U);
+  EXPECT_EQ(s21_vec_ref_double.capacity(), 8U);
   EXPECT_EQ(s21_vec_ref_double[2], 1.2);
 
   EXPECT_EQ(s21_vec_ref_string.size(), 7U);
-  EXPECT_EQ(s21_vec_ref_string.capacity(), 7U);
+  EXPECT_EQ(s21_vec_ref_string.capacity(), 8U);
   EXPECT_EQ(s21_vec_ref_string[2], "many");
 }
 
@@ -628,14 +681,411 @@ TEST(vector_insert_many_back, case1) {
   s21_vec_ref_string.insert_many_back("insert", "many", "www");
 
   EXPECT_EQ(s21_vec_ref_int.size(), 7U);
-  EXPECT_EQ(s21_vec_ref_int.capacity(), 7U);
+  EXPECT_EQ(s21_vec_ref_int.capacity(), 8U);
   EXPECT_EQ(s21_vec_ref_int[5], 6);
 
   EXPECT_EQ(s21_vec_ref_double.size(), 7U);
-  EXPECT_EQ(s21_vec_ref_double.capacity(), 7U);
+  EXPECT_EQ(s21_vec_ref_double.capacity(), 8U);
   EXPECT_EQ(s21_vec_ref_double[5], 1.0);
 
   EXPECT_EQ(s21_vec_ref_string.size(), 7U);
-  EXPECT_EQ(s21_vec_ref_string.capacity(), 7U);
+  EXPECT_EQ(s21_vec_ref_string.capacity(), 8U);
   EXPECT_EQ(s21_vec_ref_string[5], "many");
 }
+
+TEST(vector_growth, case1) {
+  s21::vector<int> s21_vec_int;
+  s21::vector<int>::size_type reallocations = 0;
+  s21::vector<int>::size_type last_capacity = 0;
+
+  for (int i = 0; i < 1000; ++i) {
+    s21_vec_int.push_back(i);
+    if (s21_vec_int.capacity() != last_capacity) {
+      last_capacity = s21_vec_int.capacity();
+      ++reallocations;
+    }
+  }
+
+  EXPECT_EQ(s21_vec_int.size(), 1000U);
+  EXPECT_EQ(s21_vec_int.capacity(), 1024U);
+  EXPECT_EQ(reallocations, 11U);
+  EXPECT_EQ(s21_vec_int[999], 999);
+}
+
+TEST(vector_growth, case2) {
+  using vector_x1_5 = s21::vector<int, std::allocator<int>, s21::growth_x1_5>;
+  vector_x1_5 s21_vec_int{1, 4, 8, 9};
+
+  s21_vec_int.push_back(10);
+  EXPECT_EQ(s21_vec_int.capacity(), 6U);
+  s21_vec_int.push_back(11);
+  s21_vec_int.insert(s21_vec_int.begin(), 0);
+  EXPECT_EQ(s21_vec_int.capacity(), 9U);
+  EXPECT_EQ(s21_vec_int.size(), 7U);
+  EXPECT_EQ(s21_vec_int[0], 0);
+  EXPECT_EQ(s21_vec_int[6], 11);
+}
+
+TEST(vector_growth, case3) {
+  EXPECT_EQ(s21::growth_x2::next_capacity(0, 1), 1U);
+  EXPECT_EQ(s21::growth_x2::next_capacity(1, 2), 2U);
+  EXPECT_EQ(s21::growth_x2::next_capacity(4, 5), 8U);
+  EXPECT_EQ(s21::growth_x2::next_capacity(4, 20), 20U);
+  EXPECT_EQ(s21::growth_x1_5::next_capacity(1, 2), 2U);
+  EXPECT_EQ(s21::growth_x1_5::next_capacity(3, 4), 4U);
+  EXPECT_EQ(s21::growth_x1_5::next_capacity(10, 11), 15U);
+}
+
+// insert_many_back grows like push_back, and its arguments may be elements
+// of the vector that the growth moves.
+TEST(vector_growth, case4) {
+  s21::vector<std::string> s21_vec{std::string(40, 'a')};
+  s21::vector<std::string>::size_type reallocations = 0;
+  s21::vector<std::string>::size_type last_capacity = s21_vec.capacity();
+
+  for (int i = 0; i < 500; ++i) {
+    s21_vec.insert_many_back(s21_vec[0], s21_vec.back());
+    if (s21_vec.capacity() != last_capacity) {
+      last_capacity = s21_vec.capacity();
+      ++reallocations;
+    }
+  }
+
+  EXPECT_EQ(s21_vec.size(), 1001U);
+  EXPECT_LE(reallocations, 11U);
+  for (const std::string &item : s21_vec) {
+    EXPECT_EQ(item, std::string(40, 'a'));
+  }
+}
+
+TEST(vector_raw_storage, case1) {
+  Tracked::reset();
+  {
+    s21::vector<Tracked> s21_vec;
+    s21_vec.reserve(1000);
+    EXPECT_EQ(s21_vec.capacity(), 1000U);
+    EXPECT_EQ(Tracked::constructed, 0);
+
+    s21_vec.push_back(Tracked(1));
+    s21_vec.push_back(Tracked(2));
+    s21_vec.push_back(Tracked(3));
+    EXPECT_EQ(Tracked::constructed - Tracked::destroyed, 3);
+
+    s21_vec.pop_back();
+    EXPECT_EQ(Tracked::constructed - Tracked::destroyed, 2);
+    EXPECT_EQ(s21_vec.back().value, 2);
+
+    s21_vec.erase(s21_vec.begin());
+    EXPECT_EQ(Tracked::constructed - Tracked::destroyed, 1);
+    EXPECT_EQ(s21_vec.front().value, 2);
+  }
+  EXPECT_EQ(Tracked::constructed, Tracked::destroyed);
+}
+
+TEST(vector_raw_storage, case2) {
+  Tracked::reset();
+  {
+    s21::vector<Tracked> s21_vec;
+    for (int i = 0; i < 100; ++i) {
+      s21_vec.push_back(Tracked(i));
+    }
+    s21_vec.insert(s21_vec.begin() + 50, Tracked(-1));
+    s21_vec.insert_many(s21_vec.begin(), Tracked(-2), Tracked(-3));
+    s21_vec.shrink_to_fit();
+    EXPECT_EQ(s21_vec.size(), 103U);
+    EXPECT_EQ(s21_vec.capacity(), 103U);
+    EXPECT_EQ(s21_vec[0].value, -2);
+    EXPECT_EQ(s21_vec[52].value, -1);
+    EXPECT_EQ(s21_vec[102].value, 99);
+    EXPECT_EQ(Tracked::constructed - Tracked::destroyed, 103);
+
+    s21_vec.clear();
+    EXPECT_EQ(Tracked::constructed, Tracked::destroyed);
+  }
+  EXPECT_EQ(Tracked::constructed, Tracked::destroyed);
+}
+
+// The vector is fully built once the delegated constructor returns, so a
+// throwing element constructor still frees the block and the elements
+// built so far.
+TEST(vector_raw_storage, throwing_default_constructor) {
+  allocation_stats stats;
+  using alloc = tracking_allocator<ThrowsOnThird>;
+  using throwing_vector = s21::vector<ThrowsOnThird, alloc>;
+  ThrowsOnThird::made = 0;
+  EXPECT_THROW(throwing_vector(5, alloc(&stats)), std::runtime_error);
+  EXPECT_EQ(stats.allocations, 1U);
+  EXPECT_EQ(stats.live(), 0U);
+}
+
+TEST(vector_raw_storage, case3) {
+  s21::vector<std::string> s21_vec_string{"Hello", ",", "world", "!"};
+  s21_vec_string.push_back(s21_vec_string[0]);
+  s21_vec_string.insert(s21_vec_string.begin(), s21_vec_string[3]);
+
+  EXPECT_EQ(s21_vec_string.size(), 6U);
+  EXPECT_EQ(s21_vec_string[0], "!");
+  EXPECT_EQ(s21_vec_string[5], "Hello");
+}
+
+TEST(vector_relocation, case1) {
+  using Movable = Relocated<true>;
+  s21::vector<Movable> s21_vec;
+  s21_vec.push_back(Movable("first"));
+  s21_vec.push_back(Movable("second"));
+  Movable::reset();
+
+  s21_vec.reserve(100);
+
+  EXPECT_EQ(Movable::copies, 0);
+  EXPECT_EQ(Movable::moves, 2);
+  EXPECT_EQ(s21_vec[0].payload, "first");
+  EXPECT_EQ(s21_vec[1].payload, "second");
+}
+
+TEST(vector_relocation, case2) {
+  using Throwing = Relocated<false>;
+  s21::vector<Throwing> s21_vec;
+  s21_vec.push_back(Throwing("first"));
+  s21_vec.push_back(Throwing("second"));
+  Throwing::reset();
+
+  s21_vec.reserve(100);
+
+  EXPECT_EQ(Throwing::copies, 2);
+  EXPECT_EQ(Throwing::moves, 0);
+  EXPECT_EQ(s21_vec[1].payload, "second");
+}
+
+TEST(vector_relocation, case3) {
+  struct Point {
+    int x;
+    double y;
+  };
+  static_assert(s21::is_trivially_relocatable<Point>::value);
+  static_assert(!s21::is_trivially_relocatable<std::string>::value);
+
+  s21::vector<Point> s21_vec;
+  for (int i = 0; i < 100; ++i) {
+    s21_vec.push_back({i, i * 0.5});
+  }
+  s21_vec.shrink_to_fit();
+
+  EXPECT_EQ(s21_vec.capacity(), 100U);
+  EXPECT_EQ(s21_vec[99].x, 99);
+  EXPECT_EQ(s21_vec[99].y, 49.5);
+}
+
+TEST(vector_emplace, case1) {
+  s21::vector<std::unique_ptr<int>> s21_vec;
+  s21_vec.push_back(std::make_unique<int>(1));
+  s21_vec.emplace_back(new int(3));
+  s21_vec.emplace(s21_vec.begin() + 1, new int(2));
+  s21_vec.insert(s21_vec.begin(), std::make_unique<int>(0));
+
+  EXPECT_EQ(s21_vec.size(), 4U);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(*s21_vec[i], i);
+  }
+}
+
+TEST(vector_emplace, case2) {
+  s21::vector<std::pair<int, std::string>> s21_vec;
+  auto &ref = s21_vec.emplace_back(1, "one");
+  EXPECT_EQ(ref.second, "one");
+  s21_vec.emplace(s21_vec.begin(), 0, "zero");
+
+  std::string payload(100, 'x');
+  const char *buffer = payload.data();
+  s21::vector<std::string> s21_vec_string;
+  s21_vec_string.push_back(std::move(payload));
+
+  EXPECT_EQ(s21_vec[0].first, 0);
+  EXPECT_EQ(s21_vec[1].second, "one");
+  EXPECT_EQ(s21_vec_string[0].data(), buffer);
+}
+
+TEST(vector_range, insert) {
+  s21::vector<int> s21_vec{1, 2, 7, 8};
+  std::vector<int> source{3, 4, 5, 6};
+  auto it = s21_vec.insert(s21_vec.begin() + 2, source.begin(), source.end());
+
+  EXPECT_EQ(*it, 3);
+  EXPECT_EQ(s21_vec.size(), 8U);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(s21_vec[i], i + 1);
+  }
+
+  s21_vec.reserve(20);
+  int *data = s21_vec.data();
+  s21_vec.insert(s21_vec.begin(), source.begin(), source.begin() + 2);
+  EXPECT_EQ(s21_vec.data(), data);
+  EXPECT_EQ(s21_vec[0], 3);
+  EXPECT_EQ(s21_vec[2], 1);
+  EXPECT_EQ(s21_vec.size(), 10U);
+}
+
+TEST(vector_range, insert_strings) {
+  s21::vector<std::string> s21_vec{"a", "e"};
+  std::vector<std::string> source{"b", "c", "d"};
+  s21_vec.insert(s21_vec.begin() + 1, source.begin(), source.end());
+  s21_vec.reserve(10);
+  s21_vec.insert(s21_vec.end(), source.begin(), source.begin() + 1);
+
+  std::vector<std::string> expected{"a", "b", "c", "d", "e", "b"};
+  ASSERT_EQ(s21_vec.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(s21_vec[i], expected[i]);
+  }
+}
+
+TEST(vector_range, insert_input_iterator) {
+  std::istringstream input("4 5 6");
+  s21::vector<int> s21_vec{1, 2, 3};
+  s21_vec.insert(s21_vec.end(), std::istream_iterator<int>(input),
+                 std::istream_iterator<int>());
+
+  EXPECT_EQ(s21_vec.size(), 6U);
+  EXPECT_EQ(s21_vec[5], 6);
+}
+
+// A copy that throws halfway leaves the vector as it was; ASan catches
+// slots that are destroyed twice.
+TEST(vector_range, insert_throwing_copy) {
+  s21::vector<throwing_value> s21_vec;
+  s21_vec.reserve(16);
+  for (int i = 0; i < 4; ++i) s21_vec.emplace_back(i);
+  std::vector<throwing_value> source;
+  for (int i = 10; i < 13; ++i) source.emplace_back(i);
+
+  throwing_value::copies_left() = 1;
+  EXPECT_THROW(
+      s21_vec.insert(s21_vec.begin() + 1, source.begin(), source.end()),
+      std::runtime_error);
+  throwing_value::copies_left() = 1;
+  EXPECT_THROW(s21_vec.insert_many(s21_vec.begin() + 1, source[0], source[1]),
+               std::runtime_error);
+  throwing_value::copies_left() = -1;
+  ASSERT_EQ(s21_vec.size(), 4U);
+  for (int i = 0; i < 4; ++i) EXPECT_EQ(s21_vec[i].value(), i);
+
+  // The source range may be the vector itself.
+  s21_vec.insert(s21_vec.begin() + 1, s21_vec.begin(), s21_vec.end());
+  int expected[] = {0, 0, 1, 2, 3, 1, 2, 3};
+  ASSERT_EQ(s21_vec.size(), 8U);
+  for (int i = 0; i < 8; ++i) EXPECT_EQ(s21_vec[i].value(), expected[i]);
+}
+
+TEST(vector_range, assign) {
+  std::vector<std::string> source{"one", "two", "three", "four", "five"};
+  s21::vector<std::string> s21_vec{"x", "y"};
+
+  s21_vec.assign(source.begin(), source.end());
+  EXPECT_EQ(s21_vec.size(), 5U);
+  EXPECT_EQ(s21_vec.capacity(), 5U);
+  EXPECT_EQ(s21_vec[4], "five");
+
+  s21_vec.assign(source.begin(), source.begin() + 2);
+  EXPECT_EQ(s21_vec.size(), 2U);
+  EXPECT_EQ(s21_vec.capacity(), 5U);
+  EXPECT_EQ(s21_vec[1], "two");
+
+  s21_vec.assign({"a", "b", "c", "d"});
+  EXPECT_EQ(s21_vec.size(), 4U);
+  EXPECT_EQ(s21_vec.capacity(), 5U);
+  EXPECT_EQ(s21_vec[3], "d");
+}
+
+TEST(vector_range, erase) {
+  s21::vector<int> s21_vec{0, 1, 2, 3, 4, 5, 6, 7};
+  auto it = s21_vec.erase(s21_vec.begin() + 2, s21_vec.begin() + 5);
+
+  EXPECT_EQ(*it, 5);
+  EXPECT_EQ(s21_vec.size(), 5U);
+  EXPECT_EQ(s21_vec[1], 1);
+  EXPECT_EQ(s21_vec[2], 5);
+  EXPECT_EQ(s21_vec[4], 7);
+
+  it = s21_vec.erase(s21_vec.begin() + 3, s21_vec.end());
+  EXPECT_EQ(it, s21_vec.end());
+  EXPECT_EQ(s21_vec.size(), 3U);
+  EXPECT_THROW(s21_vec.erase(s21_vec.end(), s21_vec.begin()),
+               std::out_of_range);
+}
+
+TEST(vector_range, erase_tracked) {
+  Tracked::reset();
+  {
+    s21::vector<Tracked> s21_vec;
+    for (int i = 0; i < 10; ++i) {
+      s21_vec.push_back(Tracked(i));
+    }
+    s21_vec.erase(s21_vec.begin(), s21_vec.begin() + 4);
+    EXPECT_EQ(Tracked::constructed - Tracked::destroyed, 6);
+    EXPECT_EQ(s21_vec.front().value, 4);
+    EXPECT_EQ(s21_vec.back().value, 9);
+  }
+  EXPECT_EQ(Tracked::constructed, Tracked::destroyed);
+}
+
+TEST(vector_range, append_range) {
+  s21::vector<int> s21_vec{1, 2};
+  std::vector<int> source{3, 4, 5};
+  int raw[] = {6, 7};
+
+  s21_vec.append_range(source);
+  s21_vec.append_range(raw);
+  s21_vec.append_range(s21::vector<int>{8});
+
+  EXPECT_EQ(s21_vec.size(), 8U);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(s21_vec[i], i + 1);
+  }
+}
+
+TEST(vector_allocator, counts) {
+  allocation_stats stats;
+  {
+    using alloc = tracking_allocator<std::string>;
+    s21::vector<std::string, alloc> s21_vec{alloc(&stats)};
+    for (int i = 0; i < 100; ++i) {
+      s21_vec.push_back(std::to_string(i));
+    }
+    EXPECT_GT(stats.allocations, 1U);
+    EXPECT_EQ(stats.live(), 1U);
+    EXPECT_EQ(s21_vec.get_allocator().stats(), &stats);
+
+    s21::vector<std::string, alloc> s21_copy(s21_vec);
+    EXPECT_EQ(s21_copy.get_allocator().stats(), &stats);
+    EXPECT_EQ(stats.live(), 2U);
+  }
+  EXPECT_EQ(stats.live(), 0U);
+}
+
+TEST(vector_allocator, propagation) {
+  allocation_stats left_stats;
+  allocation_stats right_stats;
+  using alloc = tracking_allocator<int, false>;
+  s21::vector<int, alloc> left{{1, 2, 3}, alloc(&left_stats)};
+  s21::vector<int, alloc> right{{4, 5}, alloc(&right_stats)};
+
+  // Unequal allocators that do not propagate: elements move, blocks stay.
+  int *right_data = right.data();
+  left = std::move(right);
+  EXPECT_NE(left.data(), right_data);
+  EXPECT_EQ(left.get_allocator().stats(), &left_stats);
+  EXPECT_EQ(left.size(), 2U);
+  EXPECT_EQ(left[1], 5);
+  EXPECT_TRUE(right.empty());
+  EXPECT_EQ(right_stats.live(), 0U);
+
+  using prop_alloc = tracking_allocator<int, true>;
+  s21::vector<int, prop_alloc> first{{1}, prop_alloc(&left_stats)};
+  s21::vector<int, prop_alloc> second{{2, 3}, prop_alloc(&right_stats)};
+  first.swap(second);
+  EXPECT_EQ(first.get_allocator().stats(), &right_stats);
+  EXPECT_EQ(first.size(), 2U);
+  first = second;
+  EXPECT_EQ(first.get_allocator().stats(), &left_stats);
+  EXPECT_EQ(first[0], 1);
+}